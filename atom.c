@@ -0,0 +1,175 @@
+/*
+ * Atoms: unique copies of strings, such as element names.
+ *
+ * atom(s) returns a string equal to s that is the same pointer for
+ * all equal strings, so atoms can be compared with "==" instead of
+ * strcmp(). Each atom is stored once, however often it occurs in a
+ * document. Atoms are not allocated in an arena and remain valid after
+ * a document's tree has been deleted, until atom_release() frees those
+ * that were made after a given atom_mark(). Batch mode (batch.c) does
+ * that after each document, so the table doesn't grow with the number
+ * of different names in all documents together.
+ *
+ * atom_down(s) returns the atom of the lowercase version of s, which
+ * allows case-insensitive comparisons of atoms with "==" as well.
+ *
+ * Part of HTML-XML-utils, see:
+ * http://www.w3.org/Tools/HTML-XML-utils/
+ *
+ * Copyright © 2026 World Wide Web Consortium
+ * See http://www.w3.org/Consortium/Legal/copyright-software
+ *
+ * Author: agent <agent@local>
+ * Created: 17 Oct 2026
+ **/
+#include "config.h"
+#include <stdlib.h>
+#include <stddef.h>
+#include <ctype.h>
+#ifdef HAVE_STRING_H
+#  include <string.h>
+#elif HAVE_STRINGS_H
+#  include <strings.h>
+#endif
+#include "export.h"
+#include "types.e"
+#include "heap.e"
+
+typedef struct _Atom {
+  struct _Atom *next;				/* Next in same bucket */
+  struct _Atom *older;				/* Atom made before this one */
+  struct _Atom *down;				/* Lowercase atom, or NULL */
+  unsigned long seq;				/* Order in which it was made */
+  unsigned int hash;
+  char s[1];					/* The string itself */
+} Atom;
+
+static Atom **table = NULL;			/* Buckets */
+static unsigned int size = 0;			/* # of buckets, a power of 2 */
+static unsigned int count = 0;			/* # of atoms */
+static Atom *newest = NULL;			/* Last atom made */
+static unsigned long made = 0;			/* # of atoms ever made */
+
+
+/* hash -- compute a hash of the first n bytes of s (FNV-1a) */
+static unsigned int hash(const char *s, size_t n)
+{
+  unsigned int h = 2166136261U;
+
+  while (n--) h = (h ^ (unsigned char)*(s++)) * 16777619U;
+  return h;
+}
+
+
+/* grow -- double the number of buckets */
+static void grow(void)
+{
+  Atom **old = table, *a, *next;
+  unsigned int i, oldsize = size;
+
+  size = size ? 2 * size : 256;
+  newarray(table, size);
+  for (i = 0; i < size; i++) table[i] = NULL;
+  for (i = 0; i < oldsize; i++)
+    for (a = old[i]; a; a = next) {
+      next = a->next;
+      a->next = table[a->hash & (size - 1)];
+      table[a->hash & (size - 1)] = a;
+    }
+  dispose(old);
+}
+
+
+/* lookup -- find or add the atom for the first n bytes of s */
+static Atom *lookup(const char *s, size_t n)
+{
+  unsigned int h = hash(s, n);
+  Arena prev;
+  Atom *a;
+
+  if (size)
+    for (a = table[h & (size - 1)]; a; a = a->next)
+      if (a->hash == h && strncmp(a->s, s, n) == 0 && a->s[n] == '\0')
+	return a;
+
+  /* Not found. Atoms must outlive any arena */
+  prev = arena_use(NULL);
+  if (count >= size) grow();
+  a = heap_alloc(offsetof(Atom, s) + n + 1, __FILE__, __LINE__);
+  memcpy(a->s, s, n);
+  a->s[n] = '\0';
+  a->hash = h;
+  a->down = NULL;
+  a->seq = made++;
+  a->older = newest;
+  newest = a;
+  a->next = table[h & (size - 1)];
+  table[h & (size - 1)] = a;
+  count++;
+  (void) arena_use(prev);
+  return a;
+}
+
+
+/* atom_n -- return the atom for the first n bytes of s */
+EXPORT conststring atom_n(const char *s, size_t n)
+{
+  return lookup(s, n)->s;
+}
+
+
+/* atom -- return the atom for s */
+EXPORT conststring atom(const conststring s)
+{
+  return lookup(s, strlen(s))->s;
+}
+
+
+/* atom_down -- return the atom for the lowercase version of s */
+EXPORT conststring atom_down(const conststring s)
+{
+  Atom *a = lookup(s, strlen(s)), *d;
+  char buf[64], *low;
+  size_t i, n;
+
+  if (a->down) return a->down->s;		/* Computed before */
+  for (i = 0; a->s[i] && !isupper((unsigned char)a->s[i]); i++) ;
+  if (!a->s[i]) {				/* Already lowercase */
+    a->down = a;
+    return a->s;
+  }
+  n = strlen(a->s);
+  low = n < sizeof(buf) ? buf : heap_alloc(n + 1, __FILE__, __LINE__);
+  for (i = 0; i <= n; i++) low[i] = tolower((unsigned char)a->s[i]);
+  d = lookup(low, n);
+  d->down = d;
+  if (low != buf) heap_free(low);
+
+  /* Only remember an atom that atom_release() cannot free before a */
+  if (d->seq < a->seq) a->down = d;
+  return d->s;
+}
+
+
+/* atom_mark -- return a mark, to free the atoms made after it */
+EXPORT unsigned long atom_mark(void)
+{
+  return made;
+}
+
+
+/* atom_release -- free the atoms made since atom_mark() returned mark */
+EXPORT void atom_release(unsigned long mark)
+{
+  Atom **p, *a;
+
+  while (newest && newest->seq >= mark) {
+    a = newest;
+    for (p = &table[a->hash & (size - 1)]; *p != a; p = &(*p)->next) ;
+    *p = a->next;
+    newest = a->older;
+    count--;
+    heap_free(a);
+  }
+  made = mark;
+}
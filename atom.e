@@ -0,0 +1,5 @@
+extern conststring atom_n(const char *s, size_t n);
+extern conststring atom(const conststring s);
+extern conststring atom_down(const conststring s);
+extern unsigned long atom_mark(void);
+extern void atom_release(unsigned long mark);
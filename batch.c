@@ -0,0 +1,250 @@
+/*
+ * Run a tool over many documents in one process.
+ *
+ * The input and output files come in pairs, either on the command
+ * line or, if there are none there, on stdin as a list of file names
+ * each terminated by a NUL character (as made by "find -print0").
+ * Each document is parsed into an arena, which is reset after the
+ * document has been written.
+ *
+ * With more than one job, the list of files is read first and then
+ * handed out one document at a time, through a pipe, to a pool of
+ * worker processes. A worker asks for the next document as soon as it
+ * is done with the previous one, so a single very large document only
+ * occupies one worker while the others go on with the rest. Each
+ * worker keeps its parser and arena for all documents it treats.
+ *
+ * An error that would make the tool exit (i.e., a call to errexit(),
+ * such as for a mismatched end tag) only ends the current document.
+ * Its exit status is recorded and the batch goes on with the next one.
+ *
+ * Part of HTML-XML-utils, see:
+ * http://www.w3.org/Tools/HTML-XML-utils/
+ *
+ * Copyright © 2026 World Wide Web Consortium
+ * See http://www.w3.org/Consortium/Legal/copyright-software
+ *
+ * Author: agent <agent@local>
+ * Created: 17 Oct 2026
+ **/
+#include "config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <setjmp.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#ifdef HAVE_STRING_H
+#  include <string.h>
+#elif HAVE_STRINGS_H
+#  include <strings.h>
+#endif
+#include "export.h"
+#include "types.e"
+#include "heap.e"
+#include "html.e"
+#include "scan.e"
+#include "dict.e"
+#include "openurl.e"
+#include "errexit.e"
+#include "outbuf.e"
+#include "atom.e"
+
+
+/* A routine that parses yyin, writes the result to stdout and returns
+   an exit status. It must not keep pointers to the document afterwards. */
+EXPORT typedef int (*batch_document_fn)(void);
+
+static jmp_buf failed;			/* Where errexit() returns to */
+
+
+/* read_name -- read a NUL-terminated file name from stdin, false at EOF */
+static bool read_name(string *name, size_t *size)
+{
+  ssize_t n;
+
+  if ((n = getdelim(name, size, '\0', stdin)) <= 0) return false;
+  if ((*name)[n-1] == '\n') (*name)[n-1] = '\0'; /* Last one may be a \n */
+  return true;
+}
+
+
+/* next_pair -- get the next input and output file, false if no more */
+static bool next_pair(int argc, char *argv[], int *i, string *in,
+		      size_t *insize, string *out, size_t *outsize)
+{
+  if (*i == argc) {				/* Names come from stdin */
+    if (!read_name(in, insize)) return false;
+    if (!read_name(out, outsize)) errexit("No output file for %s\n", *in);
+    return true;
+  }
+  if (*i == argc - 1) errexit("No output file for %s\n", argv[*i]);
+  if (*i > argc) return false;			/* All args done */
+  free(*in);
+  free(*out);
+  *in = strdup(argv[(*i)++]);
+  *out = strdup(argv[(*i)++]);
+  if (*i == argc) *i = argc + 1;		/* Don't switch to stdin */
+  return true;
+}
+
+
+/* fail -- called by errexit() while a document is treated */
+static void fail(void)
+{
+  longjmp(failed, 1);
+}
+
+
+/* redirect_stdout -- make stdout write to file out, false on error */
+static bool redirect_stdout(const conststring out)
+{
+  int fd;
+
+  /* Unlike freopen(), this leaves stdout open if out cannot be opened */
+  if ((fd = open(out, O_WRONLY | O_CREAT | O_TRUNC, 0666)) == -1) return false;
+  (void) fflush(stdout);			/* Any error was already reported */
+  clearerr(stdout);
+  if (fd == STDOUT_FILENO) return true;
+  if (dup2(fd, STDOUT_FILENO) == -1) {close(fd); return false;}
+  close(fd);
+  return true;
+}
+
+
+/* run_one -- parse in with process, write to out, return exit status */
+static int run_one(const conststring in, const conststring out, Arena arena,
+		   batch_document_fn process)
+{
+  errexit_handler handler;
+  int status, result;
+  unsigned long mark;
+  Arena prev;
+  FILE *f;
+
+  if (!(f = fopenurl(in, "r", &status))) {
+    perror(in); return 2;
+  }
+  if (status != 200) {
+    fprintf(stderr, "%s : %s\n", in, http_strerror(status));
+    fclose(f); return 2;
+  }
+  if (!redirect_stdout(out)) {
+    perror(out); fclose(f); return 2;
+  }
+
+  /* Start from a fresh parser, scanner, line number and arena, and
+     forget the names of this document's elements afterwards */
+  html_parser_reset(NULL);
+  set_yyin(f, in);
+  mark = atom_mark();
+  prev = arena_use(arena);
+  handler = set_errexit_handler(fail);
+  if (setjmp(failed) == 0) {
+    result = process();
+  } else {					/* errexit() was called */
+    (void) outbuf_flush(outbuf_stdout());	/* As exit() would have done */
+    result = 1;
+  }
+  (void) set_errexit_handler(handler);
+  (void) arena_use(prev);
+  arena_reset(arena);
+  atom_release(mark);
+  fclose(f);
+  if (fflush(stdout) != 0) {perror(out); result = 2;}
+  return result;
+}
+
+
+/* worker -- treat documents whose numbers are read from fd, return status */
+static int worker(int fd, string *in, string *out, batch_document_fn process)
+{
+  Arena arena = arena_new();
+  int k, r, result = 0;
+  ssize_t n;
+
+  /* Reads of at most PIPE_BUF bytes are atomic, so each number read
+     from the pipe goes to exactly one worker */
+  for (;;) {
+    if ((n = read(fd, &k, sizeof(k))) == -1 && errno == EINTR) continue;
+    if (n != sizeof(k)) break;			/* EOF: no more documents */
+    if ((r = run_one(in[k], out[k], arena, process)) > result) result = r;
+  }
+  arena_delete(arena);
+  return result;
+}
+
+
+/* pool -- run process with a pool of jobs workers, return exit status */
+static int pool(int n, string *in, string *out, int jobs,
+		batch_document_fn process)
+{
+  int fd[2], k, status, result = 0;
+  pid_t pid;
+
+  if (jobs > n) jobs = n;
+  if (pipe(fd) == -1) {perror("pipe"); return 2;}
+  (void) fflush(stdout);			/* Don't copy buffered output */
+
+  for (k = 0; k < jobs; k++) {
+    if ((pid = fork()) == -1) {perror("fork"); result = 2; break;}
+    if (pid == 0) {				/* Child */
+      close(fd[1]);
+      exit(worker(fd[0], in, out, process));
+    }
+  }
+  close(fd[0]);
+  if (k == 0) {close(fd[1]); return 2;}	/* No workers at all */
+
+  /* Hand out the documents in order; blocks while the pipe is full */
+  for (k = 0; k < n; k++)
+    if (write(fd[1], &k, sizeof(k)) != sizeof(k)) {perror("pipe"); break;}
+  close(fd[1]);				/* Workers see EOF when done */
+
+  for (;;) {
+    if ((pid = wait(&status)) == -1 && errno == EINTR) continue;
+    if (pid == -1) break;			/* No more children */
+    if (!WIFEXITED(status)) result = 2;
+    else if (WEXITSTATUS(status) > result) result = WEXITSTATUS(status);
+  }
+  return result;
+}
+
+
+/* batch -- run process for each pair of input and output files */
+EXPORT int batch(int argc, char *argv[], int i, int jobs,
+		 batch_document_fn process)
+{
+  Arena arena;
+  string in = NULL, out = NULL, *ins = NULL, *outs = NULL;
+  size_t insize = 0, outsize = 0;
+  int result = 0, r, n = 0;
+
+  if (jobs > 1) {				/* Collect the list first */
+    while (next_pair(argc, argv, &i, &in, &insize, &out, &outsize)) {
+      renewarray(ins, n + 1);
+      renewarray(outs, n + 1);
+      ins[n] = newstring(in);
+      outs[n] = newstring(out);
+      n++;
+    }
+    free(in);
+    free(out);
+    result = n == 0 ? 0 : pool(n, ins, outs, jobs, process);
+    while (n--) {dispose(ins[n]); dispose(outs[n]);}
+    dispose(ins);
+    dispose(outs);
+    return result;
+  }
+
+  arena = arena_new();
+  while (next_pair(argc, argv, &i, &in, &insize, &out, &outsize))
+    if ((r = run_one(in, out, arena, process)) > result) result = r;
+  free(in);
+  free(out);
+  arena_delete(arena);
+  return result;
+}
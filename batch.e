@@ -0,0 +1,3 @@
+typedef int (*batch_document_fn)(void);
+extern int batch(int argc, char *argv[], int i, int jobs,
+   batch_document_fn process);
@@ -0,0 +1,980 @@
+/* Element types. Generated by mkdtd from dtd.hash, don't edit */
+
+#define NTYPES 98		/* Number of types, including 0 */
+#define NHASH 256		/* Size of type_hash[] */
+#define DATA_TYPE 1		/* Type of "%data" */
+
+typedef struct {
+  const char *name;		/* Name, in lowercase */
+  unsigned int flags;		/* ELT_* */
+  uint32_t parents[4];	/* Bits for types that can be a parent */
+  unsigned char order[70];	/* Those types, preferred first */
+  int nparents;			/* Length of order[] */
+} EltType;
+
+static const EltType types[NTYPES] = {
+  {"", ELT_MIXED | ELT_STAG | ELT_ETAG, {0}, {0}, 0},
+  {"%data", ELT_KNOWN | ELT_MIXED | ELT_STAG,
+   {0x00000000U, 0x00000000U, 0x00000008U, 0x00000000U},
+   {67}, 1},
+  {"a", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG,
+   {0xdf3875b8U, 0xa5d92fdeU, 0xa1256ae8U, 0x00000000U},
+   {67, 5, 19, 30, 38, 39, 40, 41, 42, 43, 55, 69, 3, 4, 10, 12,
+    13, 14, 20, 21, 27, 31, 48, 52, 70, 0, 71, 75, 77, 78, 80, 82,
+    0, 93, 0, 95, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 54}, 56},
+  {"abbr", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG,
+   {0xdf3c75bcU, 0xe5d92fdeU, 0xa1256ae8U, 0x00000000U},
+   {67, 5, 19, 30, 38, 39, 40, 41, 42, 43, 55, 69, 3, 4, 10, 12,
+    13, 14, 20, 21, 27, 31, 48, 52, 70, 0, 71, 75, 77, 78, 80, 82,
+    0, 93, 0, 95, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 2, 18, 62, 54}, 59},
+  {"acronym", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG,
+   {0xdf3c75bcU, 0xe5d92fdeU, 0xa1256ae8U, 0x00000000U},
+   {67, 5, 19, 30, 38, 39, 40, 41, 42, 43, 55, 69, 3, 4, 10, 12,
+    13, 14, 20, 21, 27, 31, 48, 52, 70, 0, 71, 75, 77, 78, 80, 82,
+    0, 93, 0, 95, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 2, 18, 62, 54}, 59},
+  {"address", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x17058180U, 0xed08203eU, 0x01200200U, 0x00000000U},
+   {16, 15, 59, 58, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 18, 62, 37}, 26},
+  {"area", ELT_KNOWN | ELT_EMPTY | ELT_STAG,
+   {0x00000000U, 0x08000000U, 0x00000000U, 0x00000000U},
+   {59}, 1},
+  {"article", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x17058180U, 0xed08203eU, 0x01200200U, 0x00000000U},
+   {16, 15, 59, 58, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 18, 62, 37}, 26},
+  {"aside", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x17058180U, 0xed08203eU, 0x01200200U, 0x00000000U},
+   {16, 15, 59, 58, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 18, 62, 37}, 26},
+  {"audio", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG,
+   {0xdf3c75bcU, 0xe5d92fdeU, 0xa1256ae8U, 0x00000000U},
+   {67, 5, 19, 30, 38, 39, 40, 41, 42, 43, 55, 69, 3, 4, 10, 12,
+    13, 14, 20, 21, 27, 31, 48, 52, 70, 0, 71, 75, 77, 78, 80, 82,
+    0, 93, 0, 95, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 2, 18, 62, 54}, 59},
+  {"b", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG,
+   {0xdf3c75bcU, 0xe5d92fdeU, 0xa1256ae8U, 0x00000000U},
+   {67, 5, 19, 30, 38, 39, 40, 41, 42, 43, 55, 69, 3, 4, 10, 12,
+    13, 14, 20, 21, 27, 31, 48, 52, 70, 0, 71, 75, 77, 78, 80, 82,
+    0, 93, 0, 95, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 2, 18, 62, 54}, 59},
+  {"base", ELT_KNOWN | ELT_EMPTY | ELT_STAG | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x00000000U, 0x00001000U, 0x00000000U, 0x00000000U},
+   {44}, 1},
+  {"bdi", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG,
+   {0xdf3c75bcU, 0xe5d92fdeU, 0xa1256ae8U, 0x00000000U},
+   {67, 5, 19, 30, 38, 39, 40, 41, 42, 43, 55, 69, 3, 4, 10, 12,
+    13, 14, 20, 21, 27, 31, 48, 52, 70, 0, 71, 75, 77, 78, 80, 82,
+    0, 93, 0, 95, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 2, 18, 62, 54}, 59},
+  {"bdo", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG,
+   {0xdf3c75bcU, 0xe5d92fdeU, 0xa1256ae8U, 0x00000000U},
+   {67, 5, 19, 30, 38, 39, 40, 41, 42, 43, 55, 69, 3, 4, 10, 12,
+    13, 14, 20, 21, 27, 31, 48, 52, 70, 0, 71, 75, 77, 78, 80, 82,
+    0, 93, 0, 95, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 2, 18, 62, 54}, 59},
+  {"big", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG,
+   {0xdf3c75bcU, 0xe5d92fdeU, 0xa1256ae8U, 0x00000000U},
+   {67, 5, 19, 30, 38, 39, 40, 41, 42, 43, 55, 69, 3, 4, 10, 12,
+    13, 14, 20, 21, 27, 31, 48, 52, 70, 0, 71, 75, 77, 78, 80, 82,
+    0, 93, 0, 95, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 2, 18, 62, 54}, 59},
+  {"blockquote", ELT_KNOWN | ELT_STAG | ELT_ETAG | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x17058180U, 0xed08203eU, 0x01200200U, 0x00000000U},
+   {16, 15, 59, 58, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 18, 62, 37}, 26},
+  {"body", ELT_KNOWN | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x00000000U, 0x00008000U, 0x00000000U, 0x00000000U},
+   {47}, 1},
+  {"br", ELT_KNOWN | ELT_EMPTY | ELT_STAG | ELT_BREAK_AFTER,
+   {0xdf3c75bcU, 0xe5d92fdeU, 0xa1256ae8U, 0x00000000U},
+   {67, 5, 19, 30, 38, 39, 40, 41, 42, 43, 55, 69, 3, 4, 10, 12,
+    13, 14, 20, 21, 27, 31, 48, 52, 70, 0, 71, 75, 77, 78, 80, 82,
+    0, 93, 0, 95, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 2, 18, 62, 54}, 59},
+  {"button", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG,
+   {0xdf3875bcU, 0xa5d92fdeU, 0xa1256ae8U, 0x00000000U},
+   {67, 5, 19, 30, 38, 39, 40, 41, 42, 43, 55, 69, 3, 4, 10, 12,
+    13, 14, 20, 21, 27, 31, 48, 52, 70, 0, 71, 75, 77, 78, 80, 82,
+    0, 93, 0, 95, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 2, 54}, 57},
+  {"caption", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x00000000U, 0x00000000U, 0x00080000U, 0x00000000U},
+   {83}, 1},
+  {"cite", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG,
+   {0xdf3c75bcU, 0xe5d92fdeU, 0xa1256ae8U, 0x00000000U},
+   {67, 5, 19, 30, 38, 39, 40, 41, 42, 43, 55, 69, 3, 4, 10, 12,
+    13, 14, 20, 21, 27, 31, 48, 52, 70, 0, 71, 75, 77, 78, 80, 82,
+    0, 93, 0, 95, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 2, 18, 62, 54}, 59},
+  {"code", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG,
+   {0xdf3c75bcU, 0xe5d92fdeU, 0xa1256ae8U, 0x00000000U},
+   {67, 5, 19, 30, 38, 39, 40, 41, 42, 43, 55, 69, 3, 4, 10, 12,
+    13, 14, 20, 21, 27, 31, 48, 52, 70, 0, 71, 75, 77, 78, 80, 82,
+    0, 93, 0, 95, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 2, 18, 62, 54}, 59},
+  {"col", ELT_KNOWN | ELT_EMPTY | ELT_STAG,
+   {0x00800000U, 0x00000000U, 0x00080000U, 0x00000000U},
+   {23, 83}, 2},
+  {"colgroup", ELT_KNOWN | ELT_STAG | ELT_ETAG | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x00000000U, 0x00000000U, 0x00080000U, 0x00000000U},
+   {83}, 1},
+  {"dd", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x20000000U, 0x00000000U, 0x00000000U, 0x00000000U},
+   {29}, 1},
+  {"del", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG,
+   {0xdf3df5bcU, 0xedd92ffeU, 0xa1656aecU, 0x00000000U},
+   {67, 5, 19, 30, 38, 39, 40, 41, 42, 43, 55, 69, 3, 4, 10, 12,
+    13, 14, 20, 21, 27, 31, 48, 52, 70, 0, 71, 75, 77, 78, 80, 82,
+    0, 93, 0, 95, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 16, 15, 59, 58, 2, 18, 62, 37, 54,
+    66, 86}, 66},
+  {"details", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0xdf3c75bcU, 0xe5d92fdeU, 0xa1256ae8U, 0x00000000U},
+   {67, 5, 19, 30, 38, 39, 40, 41, 42, 43, 55, 69, 3, 4, 10, 12,
+    13, 14, 20, 21, 27, 31, 48, 52, 70, 0, 71, 75, 77, 78, 80, 82,
+    0, 93, 0, 95, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 2, 18, 62, 54}, 59},
+  {"dfn", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG,
+   {0xdf3c75bcU, 0xe5d92fdeU, 0xa1256ae8U, 0x00000000U},
+   {67, 5, 19, 30, 38, 39, 40, 41, 42, 43, 55, 69, 3, 4, 10, 12,
+    13, 14, 20, 21, 27, 31, 48, 52, 70, 0, 71, 75, 77, 78, 80, 82,
+    0, 93, 0, 95, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 2, 18, 62, 54}, 59},
+  {"div", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x17058180U, 0xed08203eU, 0x01200200U, 0x00000000U},
+   {16, 15, 59, 58, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 18, 62, 37}, 26},
+  {"dl", ELT_KNOWN | ELT_STAG | ELT_ETAG | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x17058180U, 0xed08203eU, 0x01200200U, 0x00000000U},
+   {16, 15, 59, 58, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 18, 62, 37}, 26},
+  {"dt", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x20000000U, 0x00000000U, 0x00000000U, 0x00000000U},
+   {29}, 1},
+  {"em", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG,
+   {0xdf3c75bcU, 0xe5d92fdeU, 0xa1256ae8U, 0x00000000U},
+   {67, 5, 19, 30, 38, 39, 40, 41, 42, 43, 55, 69, 3, 4, 10, 12,
+    13, 14, 20, 21, 27, 31, 48, 52, 70, 0, 71, 75, 77, 78, 80, 82,
+    0, 93, 0, 95, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 2, 18, 62, 54}, 59},
+  {"embed", ELT_KNOWN | ELT_EMPTY | ELT_STAG,
+   {0xdf3c75bcU, 0xe5d92fdeU, 0xa1256ae8U, 0x00000000U},
+   {67, 5, 19, 30, 38, 39, 40, 41, 42, 43, 55, 69, 3, 4, 10, 12,
+    13, 14, 20, 21, 27, 31, 48, 52, 70, 0, 71, 75, 77, 78, 80, 82,
+    0, 93, 0, 95, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 2, 18, 62, 54}, 59},
+  {"fieldset", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x17018180U, 0xad08203eU, 0x01200200U, 0x00000000U},
+   {16, 15, 59, 58, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 37}, 24},
+  {"figcaption", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x00000000U, 0x00000008U, 0x00000000U, 0x00000000U},
+   {35}, 1},
+  {"figure", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x17058180U, 0xed08203eU, 0x01200200U, 0x00000000U},
+   {16, 15, 59, 58, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 18, 62, 37}, 26},
+  {"footer", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x17058180U, 0xed08203eU, 0x01200200U, 0x00000000U},
+   {16, 15, 59, 58, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 18, 62, 37}, 26},
+  {"form", ELT_KNOWN | ELT_STAG | ELT_ETAG | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x17018180U, 0xad08201eU, 0x01200200U, 0x00000000U},
+   {16, 15, 59, 58, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88}, 23},
+  {"h1", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x17058180U, 0xed08203eU, 0x01200200U, 0x00000000U},
+   {16, 15, 59, 58, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 18, 62, 37}, 26},
+  {"h2", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x17058180U, 0xed08203eU, 0x01200200U, 0x00000000U},
+   {16, 15, 59, 58, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 18, 62, 37}, 26},
+  {"h3", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x17058180U, 0xed08203eU, 0x01200200U, 0x00000000U},
+   {16, 15, 59, 58, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 18, 62, 37}, 26},
+  {"h4", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x17058180U, 0xed08203eU, 0x01200200U, 0x00000000U},
+   {16, 15, 59, 58, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 18, 62, 37}, 26},
+  {"h5", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x17058180U, 0xed08203eU, 0x01200200U, 0x00000000U},
+   {16, 15, 59, 58, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 18, 62, 37}, 26},
+  {"h6", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x17058180U, 0xed08203eU, 0x01200200U, 0x00000000U},
+   {16, 15, 59, 58, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 18, 62, 37}, 26},
+  {"head", ELT_KNOWN | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x00000000U, 0x00008000U, 0x00000000U, 0x00000000U},
+   {47}, 1},
+  {"header", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x17058180U, 0xed08203eU, 0x01200200U, 0x00000000U},
+   {16, 15, 59, 58, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 18, 62, 37}, 26},
+  {"hr", ELT_KNOWN | ELT_EMPTY | ELT_STAG | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x17058180U, 0xed08203eU, 0x01200200U, 0x00000000U},
+   {16, 15, 59, 58, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 18, 62, 37}, 26},
+  {"html", ELT_KNOWN | ELT_BREAK_BEFORE | ELT_BREAK_AFTER | ELT_ROOT,
+   {0x00000000U, 0x00000000U, 0x00000000U, 0x00000000U},
+   {0}, 0},
+  {"i", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG,
+   {0xdf3c75bcU, 0xe5d92fdeU, 0xa1256ae8U, 0x00000000U},
+   {67, 5, 19, 30, 38, 39, 40, 41, 42, 43, 55, 69, 3, 4, 10, 12,
+    13, 14, 20, 21, 27, 31, 48, 52, 70, 0, 71, 75, 77, 78, 80, 82,
+    0, 93, 0, 95, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 2, 18, 62, 54}, 59},
+  {"img", ELT_KNOWN | ELT_EMPTY | ELT_STAG,
+   {0xdf3c75bcU, 0xe5d92fdeU, 0xa1256ae8U, 0x00000000U},
+   {67, 5, 19, 30, 38, 39, 40, 41, 42, 43, 55, 69, 3, 4, 10, 12,
+    13, 14, 20, 21, 27, 31, 48, 52, 70, 0, 71, 75, 77, 78, 80, 82,
+    0, 93, 0, 95, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 2, 18, 62, 54}, 59},
+  {"input", ELT_KNOWN | ELT_EMPTY | ELT_STAG,
+   {0xdf3875bcU, 0xa5d92fdeU, 0xa1256ae8U, 0x00000000U},
+   {67, 5, 19, 30, 38, 39, 40, 41, 42, 43, 55, 69, 3, 4, 10, 12,
+    13, 14, 20, 21, 27, 31, 48, 52, 70, 0, 71, 75, 77, 78, 80, 82,
+    0, 93, 0, 95, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 2, 54}, 57},
+  {"ins", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG,
+   {0xdf3df5bcU, 0xedd92ffeU, 0xa1656aecU, 0x00000000U},
+   {67, 5, 19, 30, 38, 39, 40, 41, 42, 43, 55, 69, 3, 4, 10, 12,
+    13, 14, 20, 21, 27, 31, 48, 52, 70, 0, 71, 75, 77, 78, 80, 82,
+    0, 93, 0, 95, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 16, 15, 59, 58, 2, 18, 62, 37, 54,
+    66, 86}, 66},
+  {"kbd", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG,
+   {0xdf3c75bcU, 0xe5d92fdeU, 0xa1256ae8U, 0x00000000U},
+   {67, 5, 19, 30, 38, 39, 40, 41, 42, 43, 55, 69, 3, 4, 10, 12,
+    13, 14, 20, 21, 27, 31, 48, 52, 70, 0, 71, 75, 77, 78, 80, 82,
+    0, 93, 0, 95, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 2, 18, 62, 54}, 59},
+  {"keygen", ELT_KNOWN | ELT_EMPTY | ELT_STAG,
+   {0xdf3c75bcU, 0xe5d92fdeU, 0xa1256ae8U, 0x00000000U},
+   {67, 5, 19, 30, 38, 39, 40, 41, 42, 43, 55, 69, 3, 4, 10, 12,
+    13, 14, 20, 21, 27, 31, 48, 52, 70, 0, 71, 75, 77, 78, 80, 82,
+    0, 93, 0, 95, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 2, 18, 62, 54}, 59},
+  {"label", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG,
+   {0xdf3875bcU, 0xa5992fdeU, 0xa1256ae8U, 0x00000000U},
+   {67, 5, 19, 30, 38, 39, 40, 41, 42, 43, 55, 69, 3, 4, 10, 12,
+    13, 14, 20, 21, 27, 31, 48, 52, 70, 0, 71, 75, 77, 78, 80, 82,
+    0, 93, 0, 95, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 2}, 56},
+  {"legend", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x00000000U, 0x00000002U, 0x00000000U, 0x00000000U},
+   {33}, 1},
+  {"li", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x00000000U, 0x00000000U, 0x40000001U, 0x00000000U},
+   {94, 64}, 2},
+  {"link", ELT_KNOWN | ELT_EMPTY | ELT_STAG | ELT_BREAK_BEFORE,
+   {0x00000000U, 0x00001000U, 0x00000000U, 0x00000000U},
+   {44}, 1},
+  {"main", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x10010000U, 0x40000000U, 0x00000000U, 0x00000000U},
+   {16, 28, 62}, 3},
+  {"map", ELT_KNOWN | ELT_STAG | ELT_ETAG,
+   {0xdf3c75bcU, 0xe5d92fdeU, 0xa1256ae8U, 0x00000000U},
+   {67, 5, 19, 30, 38, 39, 40, 41, 42, 43, 55, 69, 3, 4, 10, 12,
+    13, 14, 20, 21, 27, 31, 48, 52, 70, 0, 71, 75, 77, 78, 80, 82,
+    0, 93, 0, 95, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 2, 18, 62, 54}, 59},
+  {"meta", ELT_KNOWN | ELT_EMPTY | ELT_STAG | ELT_BREAK_BEFORE,
+   {0xdf3c75bcU, 0xe5d93fdeU, 0xa1256ae8U, 0x00000000U},
+   {67, 5, 19, 30, 38, 39, 40, 41, 42, 43, 55, 69, 3, 4, 10, 12,
+    13, 14, 20, 21, 27, 31, 48, 52, 70, 0, 71, 75, 77, 78, 80, 82,
+    0, 93, 0, 95, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 44, 2, 18, 62, 54}, 60},
+  {"nav", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x17058180U, 0xed08203eU, 0x01200200U, 0x00000000U},
+   {16, 15, 59, 58, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 18, 62, 37}, 26},
+  {"noscript", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG,
+   {0xdf3df5bcU, 0xedd92ffeU, 0xa1656aecU, 0x00000000U},
+   {67, 5, 19, 30, 38, 39, 40, 41, 42, 43, 55, 69, 3, 4, 10, 12,
+    13, 14, 20, 21, 27, 31, 48, 52, 70, 0, 71, 75, 77, 78, 80, 82,
+    0, 93, 0, 95, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 16, 15, 59, 58, 2, 18, 62, 37, 54,
+    66, 86}, 66},
+  {"object", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG,
+   {0xdf3c75bcU, 0xe5d93fdeU, 0xa1256ae8U, 0x00000000U},
+   {67, 5, 19, 30, 38, 39, 40, 41, 42, 43, 55, 69, 3, 4, 10, 12,
+    13, 14, 20, 21, 27, 31, 48, 52, 70, 0, 71, 75, 77, 78, 80, 82,
+    0, 93, 0, 95, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 2, 18, 62, 25, 45, 8, 73, 58, 7,
+    61, 33, 44, 51, 54, 63}, 70},
+  {"ol", ELT_KNOWN | ELT_STAG | ELT_ETAG | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x17058180U, 0xed08203eU, 0x01200200U, 0x00000000U},
+   {16, 15, 59, 58, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 18, 62, 37}, 26},
+  {"optgroup", ELT_KNOWN | ELT_STAG | ELT_ETAG | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x00000000U, 0x00000000U, 0x00000400U, 0x00000000U},
+   {74}, 1},
+  {"option", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x00000000U, 0x00000000U, 0x00000402U, 0x00000000U},
+   {74, 65}, 2},
+  {"p", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x17058180U, 0xed08203eU, 0x01200200U, 0x00000000U},
+   {16, 15, 59, 58, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 18, 62, 37}, 26},
+  {"param", ELT_KNOWN | ELT_EMPTY | ELT_STAG | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x00000000U, 0x80000000U, 0x00000000U, 0x00000000U},
+   {63}, 1},
+  {"pre", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG | ELT_PRE | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x17058180U, 0xed08203eU, 0x01200200U, 0x00000000U},
+   {16, 15, 59, 58, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 18, 62, 37}, 26},
+  {"q", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG,
+   {0xdf3c75bcU, 0xe5d92fdeU, 0xa1256ae8U, 0x00000000U},
+   {67, 5, 19, 30, 38, 39, 40, 41, 42, 43, 55, 69, 3, 4, 10, 12,
+    13, 14, 20, 21, 27, 31, 48, 52, 70, 0, 71, 75, 77, 78, 80, 82,
+    0, 93, 0, 95, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 2, 18, 62, 54}, 59},
+  {"samp", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG,
+   {0xdf3c75bcU, 0xe5d92fdeU, 0xa1256ae8U, 0x00000000U},
+   {67, 5, 19, 30, 38, 39, 40, 41, 42, 43, 55, 69, 3, 4, 10, 12,
+    13, 14, 20, 21, 27, 31, 48, 52, 70, 0, 71, 75, 77, 78, 80, 82,
+    0, 93, 0, 95, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 2, 18, 62, 54}, 59},
+  {"script", ELT_KNOWN | ELT_MIXED | ELT_CDATA | ELT_STAG | ELT_ETAG | ELT_PRE | ELT_BREAK_BEFORE,
+   {0xdf3df5bcU, 0xedd93ffeU, 0xa1256ae8U, 0x00000000U},
+   {16, 67, 5, 19, 30, 38, 39, 40, 41, 42, 43, 55, 69, 3, 4, 10,
+    12, 13, 14, 20, 21, 27, 31, 48, 52, 70, 0, 71, 75, 77, 78, 80,
+    82, 0, 93, 0, 95, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45,
+    51, 56, 61, 73, 58, 63, 85, 88, 15, 44, 59, 2, 18, 62, 37, 54}, 64},
+  {"section", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x17058180U, 0xed08203eU, 0x01200200U, 0x00000000U},
+   {16, 15, 59, 58, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 18, 62, 37}, 26},
+  {"select", ELT_KNOWN | ELT_STAG | ELT_ETAG,
+   {0xdf3875bcU, 0xa5d92fdeU, 0xa1256ae8U, 0x00000000U},
+   {67, 5, 19, 30, 38, 39, 40, 41, 42, 43, 55, 69, 3, 4, 10, 12,
+    13, 14, 20, 21, 27, 31, 48, 52, 70, 0, 71, 75, 77, 78, 80, 82,
+    0, 93, 0, 95, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 2, 54}, 57},
+  {"small", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG,
+   {0xdf3c75bcU, 0xe5d92fdeU, 0xa1256ae8U, 0x00000000U},
+   {67, 5, 19, 30, 38, 39, 40, 41, 42, 43, 55, 69, 3, 4, 10, 12,
+    13, 14, 20, 21, 27, 31, 48, 52, 70, 0, 71, 75, 77, 78, 80, 82,
+    0, 93, 0, 95, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 2, 18, 62, 54}, 59},
+  {"source", ELT_KNOWN | ELT_EMPTY | ELT_STAG | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x00000200U, 0x00000000U, 0x00000000U, 0x00000001U},
+   {9, 96, 0}, 3},
+  {"span", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG,
+   {0xdf3c75bcU, 0xe5d92fdeU, 0xa1256ae8U, 0x00000000U},
+   {67, 5, 19, 30, 38, 39, 40, 41, 42, 43, 55, 69, 3, 4, 10, 12,
+    13, 14, 20, 21, 27, 31, 48, 52, 70, 0, 71, 75, 77, 78, 80, 82,
+    0, 93, 0, 95, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 2, 18, 62, 54}, 59},
+  {"strong", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG,
+   {0xdf3c75bcU, 0xe5d92fdeU, 0xa1256ae8U, 0x00000000U},
+   {67, 5, 19, 30, 38, 39, 40, 41, 42, 43, 55, 69, 3, 4, 10, 12,
+    13, 14, 20, 21, 27, 31, 48, 52, 70, 0, 71, 75, 77, 78, 80, 82,
+    0, 93, 0, 95, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 2, 18, 62, 54}, 59},
+  {"style", ELT_KNOWN | ELT_MIXED | ELT_CDATA | ELT_STAG | ELT_ETAG | ELT_PRE | ELT_BREAK_BEFORE,
+   {0x00000000U, 0x00001000U, 0x00000000U, 0x00000000U},
+   {44}, 1},
+  {"sub", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG,
+   {0xdf3c75bcU, 0xe5d92fdeU, 0xa1256ae8U, 0x00000000U},
+   {67, 5, 19, 30, 38, 39, 40, 41, 42, 43, 55, 69, 3, 4, 10, 12,
+    13, 14, 20, 21, 27, 31, 48, 52, 70, 0, 71, 75, 77, 78, 80, 82,
+    0, 93, 0, 95, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 2, 18, 62, 54}, 59},
+  {"summary", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG,
+   {0x04000000U, 0x00000000U, 0x00000000U, 0x00000000U},
+   {26}, 1},
+  {"sup", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG,
+   {0xdf3c75bcU, 0xe5d92fdeU, 0xa1256ae8U, 0x00000000U},
+   {67, 5, 19, 30, 38, 39, 40, 41, 42, 43, 55, 69, 3, 4, 10, 12,
+    13, 14, 20, 21, 27, 31, 48, 52, 70, 0, 71, 75, 77, 78, 80, 82,
+    0, 93, 0, 95, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 2, 18, 62, 54}, 59},
+  {"table", ELT_KNOWN | ELT_STAG | ELT_ETAG | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x17058180U, 0xed08203eU, 0x01200200U, 0x00000000U},
+   {16, 15, 59, 58, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 18, 62, 37}, 26},
+  {"tbody", ELT_KNOWN | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x00000000U, 0x00000000U, 0x00080000U, 0x00000000U},
+   {83}, 1},
+  {"td", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x00000000U, 0x00000000U, 0x08000000U, 0x00000000U},
+   {91}, 1},
+  {"textarea", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG | ELT_PRE,
+   {0xdf3875bcU, 0xa5d92fdeU, 0xa1256ae8U, 0x00000000U},
+   {67, 5, 19, 30, 38, 39, 40, 41, 42, 43, 55, 69, 3, 4, 10, 12,
+    13, 14, 20, 21, 27, 31, 48, 52, 70, 0, 71, 75, 77, 78, 80, 82,
+    0, 93, 0, 95, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 2, 54}, 57},
+  {"tfoot", ELT_KNOWN | ELT_STAG | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x00000000U, 0x00000000U, 0x00080000U, 0x00000000U},
+   {83}, 1},
+  {"th", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x00000000U, 0x00000000U, 0x08000000U, 0x00000000U},
+   {91}, 1},
+  {"thead", ELT_KNOWN | ELT_STAG | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x00000000U, 0x00000000U, 0x00080000U, 0x00000000U},
+   {83}, 1},
+  {"title", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x00000000U, 0x00001000U, 0x00000000U, 0x00000000U},
+   {44}, 1},
+  {"tr", ELT_KNOWN | ELT_STAG | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x00000000U, 0x00000000U, 0x02900000U, 0x00000000U},
+   {84, 87, 89}, 3},
+  {"track", ELT_KNOWN | ELT_EMPTY | ELT_STAG | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x00000200U, 0x00000000U, 0x00000000U, 0x00000001U},
+   {9, 96, 0}, 3},
+  {"tt", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG,
+   {0xdf3c75bcU, 0xe5d92fdeU, 0xa1256ae8U, 0x00000000U},
+   {67, 5, 19, 30, 38, 39, 40, 41, 42, 43, 55, 69, 3, 4, 10, 12,
+    13, 14, 20, 21, 27, 31, 48, 52, 70, 0, 71, 75, 77, 78, 80, 82,
+    0, 93, 0, 95, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 2, 18, 62, 54}, 59},
+  {"ul", ELT_KNOWN | ELT_STAG | ELT_ETAG | ELT_BREAK_BEFORE | ELT_BREAK_AFTER,
+   {0x17058180U, 0xed08203eU, 0x01200200U, 0x00000000U},
+   {16, 15, 59, 58, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 18, 62, 37}, 26},
+  {"var", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG,
+   {0xdf3c75bcU, 0xe5d92fdeU, 0xa1256ae8U, 0x00000000U},
+   {67, 5, 19, 30, 38, 39, 40, 41, 42, 43, 55, 69, 3, 4, 10, 12,
+    13, 14, 20, 21, 27, 31, 48, 52, 70, 0, 71, 75, 77, 78, 80, 82,
+    0, 93, 0, 95, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 2, 18, 62, 54}, 59},
+  {"video", ELT_KNOWN | ELT_MIXED | ELT_STAG | ELT_ETAG,
+   {0xdf3c75bcU, 0xe5d92fdeU, 0xa1256ae8U, 0x00000000U},
+   {67, 5, 19, 30, 38, 39, 40, 41, 42, 43, 55, 69, 3, 4, 10, 12,
+    13, 14, 20, 21, 27, 31, 48, 52, 70, 0, 71, 75, 77, 78, 80, 82,
+    0, 93, 0, 95, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 2, 18, 62, 54}, 59},
+  {"wbr", ELT_KNOWN | ELT_EMPTY | ELT_STAG | ELT_BREAK_AFTER,
+   {0xdf3c75bcU, 0xe5d92fdeU, 0xa1256ae8U, 0x00000000U},
+   {67, 5, 19, 30, 38, 39, 40, 41, 42, 43, 55, 69, 3, 4, 10, 12,
+    13, 14, 20, 21, 27, 31, 48, 52, 70, 0, 71, 75, 77, 78, 80, 82,
+    0, 93, 0, 95, 7, 8, 24, 25, 26, 28, 33, 34, 35, 36, 45, 51,
+    56, 61, 73, 58, 63, 85, 88, 2, 18, 62, 54}, 59},
+};
+
+/* Types by hash of their name, see elt_type(); 0 = empty slot */
+static const unsigned char type_hash[NHASH] = {
+  0, 0, 0, 91, 49, 30, 0, 0, 23, 35, 58, 90, 0, 0, 12, 0,
+  0, 0, 0, 81, 0, 80, 0, 51, 0, 0, 0, 87, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 4, 0, 2, 74, 0, 0,
+  0, 0, 68, 0, 13, 24, 52, 53, 94, 0, 0, 0, 92, 0, 0, 46,
+  0, 0, 0, 0, 6, 85, 42, 37, 28, 56, 25, 0, 0, 0, 32, 0,
+  0, 0, 0, 5, 0, 0, 0, 0, 60, 7, 0, 0, 70, 0, 20, 0,
+  45, 0, 0, 0, 55, 19, 0, 0, 0, 57, 0, 84, 40, 96, 0, 0,
+  0, 18, 22, 0, 0, 16, 93, 0, 0, 0, 78, 50, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 75, 0, 0, 0,
+  0, 62, 38, 88, 66, 34, 0, 0, 0, 9, 89, 0, 0, 0, 15, 0,
+  0, 0, 0, 0, 0, 26, 0, 0, 1, 0, 72, 0, 0, 0, 0, 0,
+  0, 59, 36, 27, 43, 17, 0, 0, 0, 14, 63, 0, 0, 0, 3, 82,
+  95, 77, 0, 44, 48, 71, 0, 8, 0, 0, 97, 0, 73, 29, 0, 0,
+  47, 0, 0, 0, 0, 0, 79, 0, 11, 41, 76, 0, 0, 0, 0, 83,
+  0, 0, 0, 0, 0, 10, 69, 0, 0, 0, 0, 0, 0, 65, 0, 67,
+  0, 0, 61, 0, 21, 0, 64, 31, 0, 0, 0, 86, 0, 33, 54, 39};
+
+/* How an element of type c can be added to one of type p, see
+   build_path(). The parent is never an unknown element. */
+#define PATH_NONE 1		/* Not even by adding omitted start tags */
+#define PATH_DIRECT 2		/* As a child */
+#define PATH_VIA 3		/* PATH_VIA + q: as child of an implied q */
+static const unsigned char paths[NTYPES][NTYPES] = {
+  {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,2,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,1,2,2,2,1,2,2,1,2,1,2,2,2,1,1,1,1,2,2,2,1,1,
+   2,2,2,2,2,1,2,2,1,2,2,2,2,1,2,2,2,2,2,2,1,2,1,1,
+   2,1,1,2,2,1,2,2,2,1,2,1,1,2,1,2,1,1,1,2,1,2,2,2,
+   1,2,1,2,1,2,2,1,2,1,2,1,1,2,1,1,2,1,1,1,1,2,1,2,
+   1,1},
+  {1,1,2,2,2,2,1,2,2,1,2,1,2,2,2,1,1,1,2,2,2,2,1,1,
+   2,2,2,2,2,1,2,2,1,2,2,2,2,1,2,2,2,2,2,2,1,2,1,1,
+   2,1,1,2,2,1,2,2,2,1,2,1,1,2,2,2,1,1,1,2,1,2,2,2,
+   1,2,1,2,1,2,2,1,2,1,2,1,1,2,1,1,2,1,1,1,1,2,1,2,
+   1,1},
+  {1,1,2,2,2,2,1,2,2,1,2,1,2,2,2,1,1,1,2,2,2,2,1,1,
+   2,2,2,2,2,1,2,2,1,2,2,2,2,1,2,2,2,2,2,2,1,2,1,1,
+   2,1,1,2,2,1,2,2,2,1,2,1,1,2,2,2,1,1,1,2,1,2,2,2,
+   1,2,1,2,1,2,2,1,2,1,2,1,1,2,1,1,2,1,1,1,1,2,1,2,
+   1,1},
+  {1,1,1,1,1,1,1,2,2,1,1,1,1,1,1,2,2,1,2,1,1,1,1,1,
+   2,2,2,1,2,1,1,1,1,2,2,2,2,2,1,1,1,1,1,1,1,2,1,19,
+   1,1,1,2,1,1,1,1,2,1,2,2,1,2,2,2,1,1,1,1,1,1,1,1,
+   1,2,1,1,1,1,1,1,1,1,1,1,1,2,1,1,2,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,2,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,1,1,1,1,1,2,2,1,1,1,1,1,1,2,2,1,2,1,1,1,1,1,
+   2,2,2,1,2,1,1,1,1,2,2,2,2,2,1,1,1,1,1,1,1,2,1,19,
+   1,1,1,2,1,1,1,1,2,1,2,2,1,2,2,2,1,1,1,1,1,1,1,1,
+   1,2,1,1,1,1,1,1,1,1,1,1,1,2,1,1,2,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,1,1,1,1,1,2,2,1,1,1,1,1,1,2,2,1,2,1,1,1,1,1,
+   2,2,2,1,2,1,1,1,1,2,2,2,2,2,1,1,1,1,1,1,1,2,1,19,
+   1,1,1,2,1,1,1,1,2,1,2,2,1,2,2,2,1,1,1,1,1,1,1,1,
+   1,2,1,1,1,1,1,1,1,1,1,1,1,2,1,1,2,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,2,2,2,2,1,2,2,1,2,1,2,2,2,1,1,1,2,2,2,2,1,1,
+   2,2,2,2,2,1,2,2,1,2,2,2,2,1,2,2,2,2,2,2,1,2,1,1,
+   2,1,1,2,2,1,2,2,2,1,2,1,1,2,2,2,1,1,1,2,1,2,2,2,
+   1,2,1,2,1,2,2,1,2,1,2,1,1,2,1,1,2,1,1,1,1,2,1,2,
+   1,1},
+  {1,1,2,2,2,2,1,2,2,1,2,1,2,2,2,1,1,1,2,2,2,2,1,1,
+   2,2,2,2,2,1,2,2,1,2,2,2,2,1,2,2,2,2,2,2,1,2,1,1,
+   2,1,1,2,2,1,2,2,2,1,2,1,1,2,2,2,1,1,1,2,1,2,2,2,
+   1,2,1,2,1,2,2,1,2,1,2,1,1,2,1,1,2,1,1,1,1,2,1,2,
+   1,1},
+  {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,2,1,1,47,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,2,2,2,2,1,2,2,1,2,1,2,2,2,1,1,1,2,2,2,2,1,1,
+   2,2,2,2,2,1,2,2,1,2,2,2,2,1,2,2,2,2,2,2,1,2,1,1,
+   2,1,1,2,2,1,2,2,2,1,2,1,1,2,2,2,1,1,1,2,1,2,2,2,
+   1,2,1,2,1,2,2,1,2,1,2,1,1,2,1,1,2,1,1,1,1,2,1,2,
+   1,1},
+  {1,1,2,2,2,2,1,2,2,1,2,1,2,2,2,1,1,1,2,2,2,2,1,1,
+   2,2,2,2,2,1,2,2,1,2,2,2,2,1,2,2,2,2,2,2,1,2,1,1,
+   2,1,1,2,2,1,2,2,2,1,2,1,1,2,2,2,1,1,1,2,1,2,2,2,
+   1,2,1,2,1,2,2,1,2,1,2,1,1,2,1,1,2,1,1,1,1,2,1,2,
+   1,1},
+  {1,1,2,2,2,2,1,2,2,1,2,1,2,2,2,1,1,1,2,2,2,2,1,1,
+   2,2,2,2,2,1,2,2,1,2,2,2,2,1,2,2,2,2,2,2,1,2,1,1,
+   2,1,1,2,2,1,2,2,2,1,2,1,1,2,2,2,1,1,1,2,1,2,2,2,
+   1,2,1,2,1,2,2,1,2,1,2,1,1,2,1,1,2,1,1,1,1,2,1,2,
+   1,1},
+  {1,1,1,1,1,1,1,2,2,1,1,1,1,1,1,2,2,1,2,1,1,1,1,1,
+   2,2,2,1,2,1,1,1,1,2,2,2,2,2,1,1,1,1,1,1,1,2,1,19,
+   1,1,1,2,1,1,1,1,2,1,2,2,1,2,2,2,1,1,1,1,1,1,1,1,
+   1,2,1,1,1,1,1,1,1,1,1,1,1,2,1,1,2,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,2,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,2,2,2,2,1,2,2,1,2,1,2,2,2,1,1,1,2,2,2,2,1,1,
+   2,2,2,2,2,1,2,2,1,2,2,2,2,1,2,2,2,2,2,2,1,2,1,1,
+   2,1,1,2,2,1,2,2,2,1,2,1,1,2,2,2,1,1,1,2,1,2,2,2,
+   1,2,1,2,1,2,2,1,2,1,2,1,1,2,1,1,2,1,1,1,1,2,1,2,
+   1,1},
+  {1,1,2,2,2,2,1,2,2,1,2,1,2,2,2,1,1,1,1,2,2,2,1,1,
+   2,2,2,2,2,1,2,2,1,2,2,2,2,1,2,2,2,2,2,2,1,2,1,1,
+   2,1,1,2,2,1,2,2,2,1,2,1,1,2,1,2,1,1,1,2,1,2,2,2,
+   1,2,1,2,1,2,2,1,2,1,2,1,1,2,1,1,2,1,1,1,1,2,1,2,
+   1,1},
+  {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,2,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,2,2,2,2,1,2,2,1,2,1,2,2,2,1,1,1,2,2,2,2,1,1,
+   2,2,2,2,2,1,2,2,1,2,2,2,2,1,2,2,2,2,2,2,1,2,1,1,
+   2,1,1,2,2,1,2,2,2,1,2,1,1,2,2,2,1,1,1,2,1,2,2,2,
+   1,2,1,2,1,2,2,1,2,1,2,1,1,2,1,1,2,1,1,1,1,2,1,2,
+   1,1},
+  {1,1,2,2,2,2,1,2,2,1,2,1,2,2,2,1,1,1,2,2,2,2,1,1,
+   2,2,2,2,2,1,2,2,1,2,2,2,2,1,2,2,2,2,2,2,1,2,1,1,
+   2,1,1,2,2,1,2,2,2,1,2,1,1,2,2,2,1,1,1,2,1,2,2,2,
+   1,2,1,2,1,2,2,1,2,1,2,1,1,2,1,1,2,1,1,1,1,2,1,2,
+   1,1},
+  {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,2,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,2,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,2,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,2,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,2,2,2,2,1,2,2,1,2,1,2,2,2,2,2,1,2,2,2,2,1,1,
+   2,2,2,2,2,1,2,2,1,2,2,2,2,2,2,2,2,2,2,2,1,2,1,19,
+   2,1,1,2,2,1,2,2,2,1,2,2,1,2,2,2,1,1,2,2,1,2,2,2,
+   1,2,1,2,1,2,2,1,2,1,2,1,1,2,2,1,2,1,1,1,1,2,1,2,
+   1,1},
+  {1,1,2,2,2,2,1,2,2,1,2,1,2,2,2,1,1,1,2,2,2,2,1,1,
+   2,2,2,2,2,1,2,2,1,2,2,2,2,1,2,2,2,2,2,2,1,2,1,1,
+   2,1,1,2,2,1,2,2,2,1,2,1,1,2,2,2,1,1,1,2,1,2,2,2,
+   1,2,1,2,1,2,2,1,2,1,2,1,1,2,1,1,2,1,1,1,1,2,1,2,
+   1,1},
+  {1,1,2,2,2,2,1,2,2,1,2,1,2,2,2,1,1,1,2,2,2,2,1,1,
+   2,2,2,2,2,1,2,2,1,2,2,2,2,1,2,2,2,2,2,2,1,2,1,1,
+   2,1,1,2,2,1,2,2,2,1,2,1,1,2,2,2,1,1,1,2,1,2,2,2,
+   1,2,1,2,1,2,2,1,2,1,2,1,1,2,1,1,2,1,1,1,1,2,1,2,
+   1,1},
+  {1,1,1,1,1,1,1,2,2,1,1,1,1,1,1,2,2,1,2,1,1,1,1,1,
+   2,2,2,1,2,1,1,1,1,2,2,2,2,2,1,1,1,1,1,1,1,2,1,19,
+   1,1,1,2,1,1,1,1,2,1,2,2,1,2,2,2,1,1,1,1,1,1,1,1,
+   1,2,1,1,1,1,1,1,1,1,1,1,1,2,1,1,2,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,1,1,1,1,1,2,2,1,1,1,1,1,1,2,2,1,2,1,1,1,1,1,
+   2,2,2,1,2,1,1,1,1,2,2,2,2,2,1,1,1,1,1,1,1,2,1,19,
+   1,1,1,2,1,1,1,1,2,1,2,2,1,2,2,2,1,1,1,1,1,1,1,1,
+   1,2,1,1,1,1,1,1,1,1,1,1,1,2,1,1,2,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,2,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,2,2,2,2,1,2,2,1,2,1,2,2,2,1,1,1,2,2,2,2,1,1,
+   2,2,2,2,2,1,2,2,1,2,2,2,2,1,2,2,2,2,2,2,1,2,1,1,
+   2,1,1,2,2,1,2,2,2,1,2,1,1,2,2,2,1,1,1,2,1,2,2,2,
+   1,2,1,2,1,2,2,1,2,1,2,1,1,2,1,1,2,1,1,1,1,2,1,2,
+   1,1},
+  {1,1,2,2,2,2,1,2,2,1,2,1,2,2,2,1,1,1,2,2,2,2,1,1,
+   2,2,2,2,2,1,2,2,1,2,2,2,2,1,2,2,2,2,2,2,1,2,1,1,
+   2,1,1,2,2,1,2,2,2,1,2,1,1,2,2,2,1,1,1,2,1,2,2,2,
+   1,2,1,2,1,2,2,1,2,1,2,1,1,2,1,1,2,1,1,1,1,2,1,2,
+   1,1},
+  {1,1,1,1,1,1,1,2,2,1,1,1,1,1,1,2,2,1,1,1,1,1,1,1,
+   2,2,2,1,2,1,1,1,1,2,2,2,2,2,1,1,1,1,1,1,1,2,1,19,
+   1,1,1,2,1,1,1,1,2,1,2,2,1,2,1,2,1,1,1,1,1,1,1,1,
+   1,2,1,1,1,1,1,1,1,1,1,1,1,2,1,1,2,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,2,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,1,1,1,1,1,2,2,1,1,1,1,1,1,2,2,1,2,1,1,1,1,1,
+   2,2,2,1,2,1,1,1,1,2,2,2,2,2,1,1,1,1,1,1,1,2,1,19,
+   1,1,1,2,1,1,1,1,2,1,2,2,1,2,2,2,1,1,1,1,1,1,1,1,
+   1,2,1,1,1,1,1,1,1,1,1,1,1,2,1,1,2,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,1,1,1,1,1,2,2,1,1,1,1,1,1,2,2,1,2,1,1,1,1,1,
+   2,2,2,1,2,1,1,1,1,2,2,2,2,2,1,1,1,1,1,1,1,2,1,19,
+   1,1,1,2,1,1,1,1,2,1,2,2,1,2,2,2,1,1,1,1,1,1,1,1,
+   1,2,1,1,1,1,1,1,1,1,1,1,1,2,1,1,2,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,1,1,1,1,1,2,2,1,1,1,1,1,1,2,2,1,1,1,1,1,1,1,
+   2,2,2,1,2,1,1,1,1,2,2,2,2,1,1,1,1,1,1,1,1,2,1,19,
+   1,1,1,2,1,1,1,1,2,1,2,2,1,2,1,2,1,1,1,1,1,1,1,1,
+   1,2,1,1,1,1,1,1,1,1,1,1,1,2,1,1,2,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,1,1,1,1,1,2,2,1,1,1,1,1,1,2,2,1,2,1,1,1,1,1,
+   2,2,2,1,2,1,1,1,1,2,2,2,2,2,1,1,1,1,1,1,1,2,1,19,
+   1,1,1,2,1,1,1,1,2,1,2,2,1,2,2,2,1,1,1,1,1,1,1,1,
+   1,2,1,1,1,1,1,1,1,1,1,1,1,2,1,1,2,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,1,1,1,1,1,2,2,1,1,1,1,1,1,2,2,1,2,1,1,1,1,1,
+   2,2,2,1,2,1,1,1,1,2,2,2,2,2,1,1,1,1,1,1,1,2,1,19,
+   1,1,1,2,1,1,1,1,2,1,2,2,1,2,2,2,1,1,1,1,1,1,1,1,
+   1,2,1,1,1,1,1,1,1,1,1,1,1,2,1,1,2,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,1,1,1,1,1,2,2,1,1,1,1,1,1,2,2,1,2,1,1,1,1,1,
+   2,2,2,1,2,1,1,1,1,2,2,2,2,2,1,1,1,1,1,1,1,2,1,19,
+   1,1,1,2,1,1,1,1,2,1,2,2,1,2,2,2,1,1,1,1,1,1,1,1,
+   1,2,1,1,1,1,1,1,1,1,1,1,1,2,1,1,2,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,1,1,1,1,1,2,2,1,1,1,1,1,1,2,2,1,2,1,1,1,1,1,
+   2,2,2,1,2,1,1,1,1,2,2,2,2,2,1,1,1,1,1,1,1,2,1,19,
+   1,1,1,2,1,1,1,1,2,1,2,2,1,2,2,2,1,1,1,1,1,1,1,1,
+   1,2,1,1,1,1,1,1,1,1,1,1,1,2,1,1,2,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,1,1,1,1,1,2,2,1,1,1,1,1,1,2,2,1,2,1,1,1,1,1,
+   2,2,2,1,2,1,1,1,1,2,2,2,2,2,1,1,1,1,1,1,1,2,1,19,
+   1,1,1,2,1,1,1,1,2,1,2,2,1,2,2,2,1,1,1,1,1,1,1,1,
+   1,2,1,1,1,1,1,1,1,1,1,1,1,2,1,1,2,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,1,1,1,1,1,2,2,1,1,1,1,1,1,2,2,1,2,1,1,1,1,1,
+   2,2,2,1,2,1,1,1,1,2,2,2,2,2,1,1,1,1,1,1,1,2,1,19,
+   1,1,1,2,1,1,1,1,2,1,2,2,1,2,2,2,1,1,1,1,1,1,1,1,
+   1,2,1,1,1,1,1,1,1,1,1,1,1,2,1,1,2,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,2,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,1,1,1,1,1,2,2,1,1,1,1,1,1,2,2,1,2,1,1,1,1,1,
+   2,2,2,1,2,1,1,1,1,2,2,2,2,2,1,1,1,1,1,1,1,2,1,19,
+   1,1,1,2,1,1,1,1,2,1,2,2,1,2,2,2,1,1,1,1,1,1,1,1,
+   1,2,1,1,1,1,1,1,1,1,1,1,1,2,1,1,2,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,1,1,1,1,1,2,2,1,1,1,1,1,1,2,2,1,2,1,1,1,1,1,
+   2,2,2,1,2,1,1,1,1,2,2,2,2,2,1,1,1,1,1,1,1,2,1,19,
+   1,1,1,2,1,1,1,1,2,1,2,2,1,2,2,2,1,1,1,1,1,1,1,1,
+   1,2,1,1,1,1,1,1,1,1,1,1,1,2,1,1,2,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,2,2,2,2,1,2,2,1,2,1,2,2,2,1,1,1,2,2,2,2,1,1,
+   2,2,2,2,2,1,2,2,1,2,2,2,2,1,2,2,2,2,2,2,1,2,1,1,
+   2,1,1,2,2,1,2,2,2,1,2,1,1,2,2,2,1,1,1,2,1,2,2,2,
+   1,2,1,2,1,2,2,1,2,1,2,1,1,2,1,1,2,1,1,1,1,2,1,2,
+   1,1},
+  {1,1,2,2,2,2,1,2,2,1,2,1,2,2,2,1,1,1,2,2,2,2,1,1,
+   2,2,2,2,2,1,2,2,1,2,2,2,2,1,2,2,2,2,2,2,1,2,1,1,
+   2,1,1,2,2,1,2,2,2,1,2,1,1,2,2,2,1,1,1,2,1,2,2,2,
+   1,2,1,2,1,2,2,1,2,1,2,1,1,2,1,1,2,1,1,1,1,2,1,2,
+   1,1},
+  {1,1,2,2,2,2,1,2,2,1,2,1,2,2,2,1,1,1,1,2,2,2,1,1,
+   2,2,2,2,2,1,2,2,1,2,2,2,2,1,2,2,2,2,2,2,1,2,1,1,
+   2,1,1,2,2,1,2,2,2,1,2,1,1,2,1,2,1,1,1,2,1,2,2,2,
+   1,2,1,2,1,2,2,1,2,1,2,1,1,2,1,1,2,1,1,1,1,2,1,2,
+   1,1},
+  {1,1,2,2,2,2,1,2,2,1,2,1,2,2,2,2,2,1,2,2,2,2,1,1,
+   2,2,2,2,2,1,2,2,1,2,2,2,2,2,2,2,2,2,2,2,1,2,1,19,
+   2,1,1,2,2,1,2,2,2,1,2,2,1,2,2,2,1,1,2,2,1,2,2,2,
+   1,2,1,2,1,2,2,1,2,1,2,1,1,2,2,1,2,1,1,1,1,2,1,2,
+   1,1},
+  {1,1,2,2,2,2,1,2,2,1,2,1,2,2,2,1,1,1,2,2,2,2,1,1,
+   2,2,2,2,2,1,2,2,1,2,2,2,2,1,2,2,2,2,2,2,1,2,1,1,
+   2,1,1,2,2,1,2,2,2,1,2,1,1,2,2,2,1,1,1,2,1,2,2,2,
+   1,2,1,2,1,2,2,1,2,1,2,1,1,2,1,1,2,1,1,1,1,2,1,2,
+   1,1},
+  {1,1,2,2,2,2,1,2,2,1,2,1,2,2,2,1,1,1,2,2,2,2,1,1,
+   2,2,2,2,2,1,2,2,1,2,2,2,2,1,2,2,2,2,2,2,1,2,1,1,
+   2,1,1,2,2,1,2,2,2,1,2,1,1,2,2,2,1,1,1,2,1,2,2,2,
+   1,2,1,2,1,2,2,1,2,1,2,1,1,2,1,1,2,1,1,1,1,2,1,2,
+   1,1},
+  {1,1,2,2,2,2,1,2,2,1,2,1,2,2,2,1,1,1,1,2,2,2,1,1,
+   2,2,2,2,2,1,2,2,1,2,2,2,2,1,2,2,2,2,2,2,1,2,1,1,
+   2,1,1,2,2,1,1,2,2,1,2,1,1,2,1,2,1,1,1,2,1,2,2,2,
+   1,2,1,2,1,2,2,1,2,1,2,1,1,2,1,1,2,1,1,1,1,2,1,2,
+   1,1},
+  {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,2,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,2,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,2,1,
+   1,1},
+  {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,2,1,1,47,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,2,1,1,1,1,1,1,1,
+   1,1,1,1,2,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,19,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,2,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,2,2,2,2,1,2,2,1,2,1,2,2,2,1,1,1,2,2,2,2,1,1,
+   2,2,2,2,2,1,2,2,1,2,2,2,2,1,2,2,2,2,2,2,1,2,1,1,
+   2,1,1,2,2,1,2,2,2,1,2,1,1,2,2,2,1,1,1,2,1,2,2,2,
+   1,2,1,2,1,2,2,1,2,1,2,1,1,2,1,1,2,1,1,1,1,2,1,2,
+   1,1},
+  {1,1,2,2,2,2,1,2,2,1,2,1,2,2,2,1,1,1,2,2,2,2,1,1,
+   2,2,2,2,2,1,2,2,1,2,2,2,2,1,2,2,2,2,2,2,2,2,1,47,
+   2,1,1,2,2,1,2,2,2,1,2,1,1,2,2,2,1,1,1,2,1,2,2,2,
+   1,2,1,2,1,2,2,1,2,1,2,1,1,2,1,1,2,1,1,1,1,2,1,2,
+   1,1},
+  {1,1,1,1,1,1,1,2,2,1,1,1,1,1,1,2,2,1,2,1,1,1,1,1,
+   2,2,2,1,2,1,1,1,1,2,2,2,2,2,1,1,1,1,1,1,1,2,1,19,
+   1,1,1,2,1,1,1,1,2,1,2,2,1,2,2,2,1,1,1,1,1,1,1,1,
+   1,2,1,1,1,1,1,1,1,1,1,1,1,2,1,1,2,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,2,2,2,2,1,2,2,1,2,1,2,2,2,2,2,1,2,2,2,2,1,1,
+   2,2,2,2,2,1,2,2,1,2,2,2,2,2,2,2,2,2,2,2,1,2,1,19,
+   2,1,1,2,2,1,2,2,2,1,2,2,1,2,2,2,1,1,2,2,1,2,2,2,
+   1,2,1,2,1,2,2,1,2,1,2,1,1,2,2,1,2,1,1,1,1,2,1,2,
+   1,1},
+  {1,1,2,2,2,2,1,2,2,1,2,1,2,2,2,1,1,1,2,2,2,2,1,1,
+   2,2,2,2,2,1,2,2,1,2,2,2,2,1,2,2,2,2,2,2,2,2,1,47,
+   2,1,1,2,2,1,2,2,2,1,2,1,1,2,2,2,1,1,1,2,1,2,2,2,
+   1,2,1,2,1,2,2,1,2,1,2,1,1,2,1,1,2,1,1,1,1,2,1,2,
+   1,1},
+  {1,1,1,1,1,1,1,2,2,1,1,1,1,1,1,2,2,1,2,1,1,1,1,1,
+   2,2,2,1,2,1,1,1,1,2,2,2,2,2,1,1,1,1,1,1,1,2,1,19,
+   1,1,1,2,1,1,1,1,2,1,2,2,1,2,2,2,1,1,1,1,1,1,1,1,
+   1,2,1,1,1,1,1,1,1,1,1,1,1,2,1,1,2,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,2,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,2,1,1,1,1,1,1,
+   1,1,2,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,1,1,1,1,1,2,2,1,1,1,1,1,1,2,2,1,2,1,1,1,1,1,
+   2,2,2,1,2,1,1,1,1,2,2,2,2,2,1,1,1,1,1,1,1,2,1,19,
+   1,1,1,2,1,1,1,1,2,1,2,2,1,2,2,2,1,1,1,1,1,1,1,1,
+   1,2,1,1,1,1,1,1,1,1,1,1,1,2,1,1,2,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,2,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,1,1,1,1,1,2,2,1,1,1,1,1,1,2,2,1,2,1,1,1,1,1,
+   2,2,2,1,2,1,1,1,1,2,2,2,2,2,1,1,1,1,1,1,1,2,1,19,
+   1,1,1,2,1,1,1,1,2,1,2,2,1,2,2,2,1,1,1,1,1,1,1,1,
+   1,2,1,1,1,1,1,1,1,1,1,1,1,2,1,1,2,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,2,2,2,2,1,2,2,1,2,1,2,2,2,1,1,1,2,2,2,2,1,1,
+   2,2,2,2,2,1,2,2,1,2,2,2,2,1,2,2,2,2,2,2,1,2,1,1,
+   2,1,1,2,2,1,2,2,2,1,2,1,1,2,2,2,1,1,1,2,1,2,2,2,
+   1,2,1,2,1,2,2,1,2,1,2,1,1,2,1,1,2,1,1,1,1,2,1,2,
+   1,1},
+  {1,1,2,2,2,2,1,2,2,1,2,1,2,2,2,1,1,1,2,2,2,2,1,1,
+   2,2,2,2,2,1,2,2,1,2,2,2,2,1,2,2,2,2,2,2,1,2,1,1,
+   2,1,1,2,2,1,2,2,2,1,2,1,1,2,2,2,1,1,1,2,1,2,2,2,
+   1,2,1,2,1,2,2,1,2,1,2,1,1,2,1,1,2,1,1,1,1,2,1,2,
+   1,1},
+  {1,1,2,2,2,2,1,2,2,1,2,1,2,2,2,2,2,1,2,2,2,2,1,1,
+   2,2,2,2,2,1,2,2,1,2,2,2,2,2,2,2,2,2,2,2,2,2,1,19,
+   2,1,1,2,2,1,2,2,2,1,2,2,1,2,2,2,1,1,1,2,1,2,2,2,
+   1,2,1,2,1,2,2,1,2,1,2,1,1,2,1,1,2,1,1,1,1,2,1,2,
+   1,1},
+  {1,1,1,1,1,1,1,2,2,1,1,1,1,1,1,2,2,1,2,1,1,1,1,1,
+   2,2,2,1,2,1,1,1,1,2,2,2,2,2,1,1,1,1,1,1,1,2,1,19,
+   1,1,1,2,1,1,1,1,2,1,2,2,1,2,2,2,1,1,1,1,1,1,1,1,
+   1,2,1,1,1,1,1,1,1,1,1,1,1,2,1,1,2,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,2,2,2,2,1,2,2,1,2,1,2,2,2,1,1,1,1,2,2,2,1,1,
+   2,2,2,2,2,1,2,2,1,2,2,2,2,1,2,2,2,2,2,2,1,2,1,1,
+   2,1,1,2,2,1,2,2,2,1,2,1,1,2,1,2,1,1,1,2,1,2,2,2,
+   1,2,1,2,1,2,2,1,2,1,2,1,1,2,1,1,2,1,1,1,1,2,1,2,
+   1,1},
+  {1,1,2,2,2,2,1,2,2,1,2,1,2,2,2,1,1,1,2,2,2,2,1,1,
+   2,2,2,2,2,1,2,2,1,2,2,2,2,1,2,2,2,2,2,2,1,2,1,1,
+   2,1,1,2,2,1,2,2,2,1,2,1,1,2,2,2,1,1,1,2,1,2,2,2,
+   1,2,1,2,1,2,2,1,2,1,2,1,1,2,1,1,2,1,1,1,1,2,1,2,
+   1,1},
+  {1,1,1,1,1,1,1,1,1,2,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   2,1},
+  {1,1,2,2,2,2,1,2,2,1,2,1,2,2,2,1,1,1,2,2,2,2,1,1,
+   2,2,2,2,2,1,2,2,1,2,2,2,2,1,2,2,2,2,2,2,1,2,1,1,
+   2,1,1,2,2,1,2,2,2,1,2,1,1,2,2,2,1,1,1,2,1,2,2,2,
+   1,2,1,2,1,2,2,1,2,1,2,1,1,2,1,1,2,1,1,1,1,2,1,2,
+   1,1},
+  {1,1,2,2,2,2,1,2,2,1,2,1,2,2,2,1,1,1,2,2,2,2,1,1,
+   2,2,2,2,2,1,2,2,1,2,2,2,2,1,2,2,2,2,2,2,1,2,1,1,
+   2,1,1,2,2,1,2,2,2,1,2,1,1,2,2,2,1,1,1,2,1,2,2,2,
+   1,2,1,2,1,2,2,1,2,1,2,1,1,2,1,1,2,1,1,1,1,2,1,2,
+   1,1},
+  {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,2,1,1,47,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,2,2,2,2,1,2,2,1,2,1,2,2,2,1,1,1,2,2,2,2,1,1,
+   2,2,2,2,2,1,2,2,1,2,2,2,2,1,2,2,2,2,2,2,1,2,1,1,
+   2,1,1,2,2,1,2,2,2,1,2,1,1,2,2,2,1,1,1,2,1,2,2,2,
+   1,2,1,2,1,2,2,1,2,1,2,1,1,2,1,1,2,1,1,1,1,2,1,2,
+   1,1},
+  {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,2,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,2,2,2,2,1,2,2,1,2,1,2,2,2,1,1,1,2,2,2,2,1,1,
+   2,2,2,2,2,1,2,2,1,2,2,2,2,1,2,2,2,2,2,2,1,2,1,1,
+   2,1,1,2,2,1,2,2,2,1,2,1,1,2,2,2,1,1,1,2,1,2,2,2,
+   1,2,1,2,1,2,2,1,2,1,2,1,1,2,1,1,2,1,1,1,1,2,1,2,
+   1,1},
+  {1,1,1,1,1,1,1,2,2,1,1,1,1,1,1,2,2,1,2,1,1,1,1,1,
+   2,2,2,1,2,1,1,1,1,2,2,2,2,2,1,1,1,1,1,1,1,2,1,19,
+   1,1,1,2,1,1,1,1,2,1,2,2,1,2,2,2,1,1,1,1,1,1,1,1,
+   1,2,1,1,1,1,1,1,1,1,1,1,1,2,1,1,2,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,2,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,2,1,1,1,1,
+   1,1},
+  {1,1,2,2,2,2,1,2,2,1,2,1,2,2,2,1,1,1,1,2,2,2,1,1,
+   2,2,2,2,2,1,2,2,1,2,2,2,2,1,2,2,2,2,2,2,1,2,1,1,
+   2,1,1,2,2,1,2,2,2,1,2,1,1,2,1,2,1,1,1,2,1,2,2,2,
+   1,2,1,2,1,2,2,1,2,1,2,1,1,2,1,1,2,1,1,1,1,2,1,2,
+   1,1},
+  {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,2,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,2,1,1,1,1,
+   1,1},
+  {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,2,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,2,1,1,47,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,87,2,1,1,2,1,2,1,1,1,1,1,1,
+   1,1},
+  {1,1,1,1,1,1,1,1,1,2,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+   2,1},
+  {1,1,2,2,2,2,1,2,2,1,2,1,2,2,2,1,1,1,2,2,2,2,1,1,
+   2,2,2,2,2,1,2,2,1,2,2,2,2,1,2,2,2,2,2,2,1,2,1,1,
+   2,1,1,2,2,1,2,2,2,1,2,1,1,2,2,2,1,1,1,2,1,2,2,2,
+   1,2,1,2,1,2,2,1,2,1,2,1,1,2,1,1,2,1,1,1,1,2,1,2,
+   1,1},
+  {1,1,1,1,1,1,1,2,2,1,1,1,1,1,1,2,2,1,2,1,1,1,1,1,
+   2,2,2,1,2,1,1,1,1,2,2,2,2,2,1,1,1,1,1,1,1,2,1,19,
+   1,1,1,2,1,1,1,1,2,1,2,2,1,2,2,2,1,1,1,1,1,1,1,1,
+   1,2,1,1,1,1,1,1,1,1,1,1,1,2,1,1,2,1,1,1,1,1,1,1,
+   1,1},
+  {1,1,2,2,2,2,1,2,2,1,2,1,2,2,2,1,1,1,2,2,2,2,1,1,
+   2,2,2,2,2,1,2,2,1,2,2,2,2,1,2,2,2,2,2,2,1,2,1,1,
+   2,1,1,2,2,1,2,2,2,1,2,1,1,2,2,2,1,1,1,2,1,2,2,2,
+   1,2,1,2,1,2,2,1,2,1,2,1,1,2,1,1,2,1,1,1,1,2,1,2,
+   1,1},
+  {1,1,2,2,2,2,1,2,2,1,2,1,2,2,2,1,1,1,2,2,2,2,1,1,
+   2,2,2,2,2,1,2,2,1,2,2,2,2,1,2,2,2,2,2,2,1,2,1,1,
+   2,1,1,2,2,1,2,2,2,1,2,1,1,2,2,2,1,1,1,2,1,2,2,2,
+   1,2,1,2,1,2,2,1,2,1,2,1,1,2,1,1,2,1,1,1,1,2,1,2,
+   1,1},
+  {1,1,2,2,2,2,1,2,2,1,2,1,2,2,2,1,1,1,2,2,2,2,1,1,
+   2,2,2,2,2,1,2,2,1,2,2,2,2,1,2,2,2,2,2,2,1,2,1,1,
+   2,1,1,2,2,1,2,2,2,1,2,1,1,2,2,2,1,1,1,2,1,2,2,2,
+   1,2,1,2,1,2,2,1,2,1,2,1,1,2,1,1,2,1,1,1,1,2,1,2,
+   1,1}
+};
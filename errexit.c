@@ -20,6 +20,21 @@
 #endif
 #include "export.h"
 
+/* A routine that errexit() calls instead of exiting. It must not return. */
+EXPORT typedef void (*errexit_handler)(void);
+
+static errexit_handler handler = NULL;
+
+
+/* set_errexit_handler -- let errexit() call h (NULL = exit), return old one */
+EXPORT errexit_handler set_errexit_handler(errexit_handler h)
+{
+  errexit_handler old = handler;
+
+  handler = h;
+  return old;
+}
+
 /* errexit -- print message and exit */
 EXPORT int errexit(char *format,...)
 {
@@ -28,6 +43,7 @@ EXPORT int errexit(char *format,...)
   va_start(ap, format);
   vfprintf(stderr, format, ap);
   va_end(ap);
+  if (handler) handler();
   exit(1);
 }
 
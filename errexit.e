@@ -1 +1,3 @@
+typedef void (*errexit_handler)(void);
+extern errexit_handler set_errexit_handler(errexit_handler h);
 extern int errexit(char *format,...);
@@ -20,12 +20,6 @@
 #endif
 #include <ctype.h>
 
-#ifdef HAVE_SEARCH_H
-#  include <search.h>
-#else
-#  include "search-freebsd.h"
-#endif
-
 #if STDC_HEADERS
 # include <string.h>
 #else
@@ -45,17 +39,89 @@
 
 
 #define MAXIDLEN 45				/* Max len of a generated ID */
+#define MAXSEQNO 10000				/* Max numeric suffix + 1 */
+
+typedef struct {
+  string id;					/* NULL if slot is free */
+  int next;					/* Next suffix to try after id */
+} IDEntry;
 
-typedef int(*compar_fn_t)(const void *, const void *);
+static IDEntry *table = NULL;			/* Hash table of IDs */
+static size_t size = 0;				/* A power of 2 */
+static size_t count = 0;			/* Number of IDs in table */
 
-static void *idtree = NULL;			/* Sorted tree of IDs */
+
+/* hash -- compute a case-insensitive hash of s */
+static size_t hash(const conststring s)
+{
+  const unsigned char *p;
+  size_t h = 2166136261U;
+
+  for (p = (const unsigned char *)s; *p; p++) h = (h ^ tolower(*p)) * 16777619U;
+  return h;
+}
+
+
+/* find -- return the slot of id, or the free slot where it would go */
+static IDEntry *find(const conststring id)
+{
+  size_t i;
+
+  /* Case-insensitive: necessary for HTML, only a little wasteful for XML */
+  for (i = hash(id) & (size - 1); table[i].id; i = (i + 1) & (size - 1))
+    if (strcasecmp(table[i].id, id) == 0) break;
+  return &table[i];
+}
+
+
+/* grow -- make the table twice as large */
+static void grow(void)
+{
+  IDEntry *old = table, *e;
+  size_t i, oldsize = size;
+
+  size = size ? 2 * size : 1024;
+  newarray(table, size);
+  for (i = 0; i < size; i++) table[i].id = NULL;
+  for (i = 0; i < oldsize; i++)
+    if (old[i].id) {e = find(old[i].id); *e = old[i];}
+  dispose(old);
+}
+
+
+/* add -- store id, unless already there; return its entry */
+static IDEntry *add(const conststring id)
+{
+  Arena prev = arena_use(NULL);			/* Table outlives arenas */
+  IDEntry *e;
+
+  if (2 * (count + 1) > size) grow();
+  if (!(e = find(id))->id) {
+    e->id = newstring(id);
+    e->next = 0;
+    count++;
+  }
+  (void) arena_use(prev);
+  return e;
+}
 
 
 /* storeID -- remember the existence of an ID (allocates a copy of the ID) */
 EXPORT void storeID(conststring id)
 {
-  /* Case-insensitive: necessary for HTML, only a little wasteful for XML */
-  (void) tsearch(newstring(id), &idtree, (compar_fn_t)strcasecmp);
+  (void) add(id);
+}
+
+
+/* reset_ids -- forget all stored and generated IDs */
+EXPORT void reset_ids(void)
+{
+  Arena prev = arena_use(NULL);
+  size_t i;
+
+  for (i = 0; i < size; i++) dispose(table[i].id);
+  count = 0;
+  (void) arena_use(prev);
 }
 
 
@@ -99,6 +165,7 @@ static void gen_id_r(Tree t, string s, int *len, int maxlen)
 /* gen_id -- try some heuristics to generate an ID for element t */
 EXPORT string gen_id(Tree t)
 {
+  IDEntry *e;
   string s;
   int len = 0;
 
@@ -110,19 +177,22 @@ EXPORT string gen_id(Tree t)
     s[len++] = 'x';		/* At least one character */
     s[len] = '\0';
   }
-  if (tfind(s, &idtree, (compar_fn_t)strcasecmp)) {
-    /* No suitable text found or text is already used elsewhere */
-    int seqno = 0;
+  if (size && (e = find(s))->id) {
+    /* No suitable text found or text is already used elsewhere. IDs are
+       never removed, so suffixes below e->next are still in use */
+    int seqno = e->next;
     do {					/* Try adding digits */
       sprintf(s + len, "%d", seqno);
       seqno++;
-    } while (seqno != 10000 && tfind(s, &idtree, (compar_fn_t)strcasecmp));
-    if (seqno == 10000) {			/* 10000 tried, giving up... */
+    } while (seqno < MAXSEQNO && find(s)->id);
+    e->next = seqno;
+    if (seqno >= MAXSEQNO) {			/* All tried, giving up... */
       free(s);
       return NULL;
     }
   }
-  (void) tsearch(s, &idtree, (compar_fn_t)strcasecmp); /* Store it */
-  return s;
+  e = add(s);					/* Store it */
+  free(s);
+  return e->id;
 }
 
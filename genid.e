@@ -1,2 +1,3 @@
 extern void storeID(conststring id);
+extern void reset_ids(void);
 extern string gen_id(Tree t);
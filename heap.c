@@ -1,6 +1,10 @@
 /*
  * Some memory allocation routines, they call abort() in case of failure
  *
+ * Allocations normally go to malloc(), but while an arena is in use
+ * (see arena_use()) they are carved out of large blocks, which are
+ * all freed at once by arena_reset(), e.g., at the end of a document.
+ *
  * Part of HTML-XML-utils, see:
  * http://www.w3.org/Tools/HTML-XML-utils/
  *
@@ -13,6 +17,7 @@
 #include "config.h"
 #include <stdlib.h>
 #include <stdio.h>
+#include <stdint.h>
 #if STDC_HEADERS
 # include <string.h>
 #else
@@ -29,15 +34,14 @@
 #endif
 
 #define fatal(msg) fatal3(msg, __FILE__, __LINE__)
-#define new(p) if (((p)=malloc(sizeof(*(p))))); else fatal("out of memory")
-#define dispose(p) if (!(p)) ; else (free((void*)p), (p) = (void*)0) 
+#define new(p) ((p) = heap_alloc(sizeof(*(p)), __FILE__, __LINE__))
+#define dispose(p) if (!(p)) ; else (heap_free((void*)p), (p) = (void*)0) 
 #define heapmax(p) 9999999 /* ? */
 #define newstring(s) heap_newstring(s, __FILE__, __LINE__) 
 #define newnstring(s,n) heap_newnstring(s, n, __FILE__, __LINE__) 
-#define newarray(p,n) \
-    if (((p)=malloc((n)*sizeof(*(p))))); else fatal("out of memory")
+#define newarray(p,n) ((p) = heap_alloc((n)*sizeof(*(p)), __FILE__, __LINE__))
 #define renewarray(p,n) \
-    if (((p)=realloc(p,(n)*sizeof(*(p))))); else fatal("out of memory")
+    ((p) = heap_realloc(p, (n)*sizeof(*(p)), __FILE__, __LINE__))
 
 EXPORTDEF(fatal(msg))
 EXPORTDEF(new(p))
@@ -48,6 +52,37 @@ EXPORTDEF(newnstring(s,n))
 EXPORTDEF(newarray(p,n))
 EXPORTDEF(renewarray(p,n))
 
+#define ALIGN 16		/* Alignment of memory in an arena */
+#define MINBLOCK 65536		/* Size of an arena's first block */
+#define MAXBLOCK 67108864	/* Blocks don't grow beyond this size */
+#define roundup(n) (((n) + ALIGN - 1) & ~(size_t)(ALIGN - 1))
+#define sizeof_chunk(p) (*(size_t*)((char*)(p) - ALIGN))
+
+/* An arena allocates from a list of large blocks, newest first. Every
+ * chunk is preceded by ALIGN bytes that hold its size, so that it can
+ * be reallocated. The blocks are only given back by arena_reset() and
+ * arena_delete(), dispose() merely reclaims the most recent chunk.
+ * The blocks of all arenas are also in a table sorted by address, so
+ * that find_block() can tell quickly if memory came from malloc(). */
+typedef struct _block {
+  struct _block *next;
+  char *top, *end;		/* Free space in this block */
+  char *start;			/* First chunk in this block */
+  struct _arena *arena;		/* Arena the block belongs to */
+} Block;
+
+EXPORT typedef struct _arena *Arena;
+
+struct _arena {
+  Block *blocks;
+  size_t blocksize;		/* Size of next block */
+};
+
+static Block **table = NULL;	/* All blocks, sorted by address */
+static size_t nblocks = 0;	/* Number of blocks in table */
+static size_t tablesize = 0;	/* Room in table */
+static Arena current = NULL;	/* Arena that new() allocates from, if any */
+
 
 EXPORT void fatal3(const char *s, const char *file, const unsigned int line)
 {
@@ -56,13 +91,204 @@ EXPORT void fatal3(const char *s, const char *file, const unsigned int line)
 }
 
 
+/* block_index -- index in table of the first block at or after p */
+static size_t block_index(const void *p)
+{
+    size_t lo = 0, hi = nblocks, m;
+
+    while (lo < hi)
+	if ((uintptr_t)table[m = (lo + hi)/2] < (uintptr_t)p) lo = m + 1;
+	else hi = m;
+    return lo;
+}
+
+
+/* add_block -- add b to the table of blocks */
+static void add_block(Block *b, const char *file, const int line)
+{
+    size_t i;
+
+    if (nblocks == tablesize) {
+	tablesize = tablesize ? 2 * tablesize : 64;
+	if (!(table = realloc(table, tablesize * sizeof(*table))))
+	    fatal3("out of memory", file, line);
+    }
+    i = block_index(b);
+    memmove(table + i + 1, table + i, (nblocks - i) * sizeof(*table));
+    table[i] = b;
+    nblocks++;
+}
+
+
+/* free_block -- remove b from the table of blocks and free it */
+static void free_block(Block *b)
+{
+    size_t i = block_index(b);
+
+    memmove(table + i, table + i + 1, (nblocks - i - 1) * sizeof(*table));
+    if (--nblocks == 0) {free(table); table = NULL; tablesize = 0;}
+    free(b);
+}
+
+
+/* arena_new -- create an empty arena */
+EXPORT Arena arena_new(void)
+{
+    Arena a;
+
+    if (!(a = malloc(sizeof(*a)))) fatal("out of memory");
+    a->blocks = NULL;
+    a->blocksize = MINBLOCK;
+    return a;
+}
+
+
+/* arena_use -- make new() etc. allocate from a (or malloc if NULL) */
+EXPORT Arena arena_use(Arena a)
+{
+    Arena prev = current;
+
+    current = a;
+    return prev;
+}
+
+
+/* arena_reset -- free everything allocated in a, but keep its last block */
+EXPORT void arena_reset(Arena a)
+{
+    Block *b;
+
+    if (!a->blocks) return;
+    while ((b = a->blocks->next)) {
+	a->blocks->next = b->next;
+	free_block(b);
+    }
+    a->blocks->top = a->blocks->start;
+}
+
+
+/* arena_delete -- free an arena and everything allocated in it */
+EXPORT void arena_delete(Arena a)
+{
+    Block *b;
+
+    while ((b = a->blocks)) {
+	a->blocks = b->next;
+	free_block(b);
+    }
+    if (current == a) current = NULL;
+    free(a);
+}
+
+
+/* arena_alloc -- allocate n bytes in arena a */
+static void *arena_alloc(Arena a, const size_t n,
+			 const char *file, const int line)
+{
+    size_t need = roundup(n) + ALIGN, size;
+    Block *b = a->blocks;
+    char *p;
+
+    if (!b || (size_t)(b->end - b->top) < need) {
+	size = roundup(sizeof(*b)) + need;
+	if (size < a->blocksize) size = a->blocksize;
+	if (!(b = malloc(size))) fatal3("out of memory", file, line);
+	b->start = b->top = (char*)b + roundup(sizeof(*b));
+	b->end = (char*)b + size;
+	b->arena = a;
+	b->next = a->blocks;
+	a->blocks = b;
+	add_block(b, file, line);
+	if (a->blocksize < MAXBLOCK) a->blocksize *= 2;
+    }
+    p = b->top + ALIGN;
+    sizeof_chunk(p) = n;
+    b->top += need;
+    return p;
+}
+
+
+/* find_block -- find the arena and block that p belongs to, or NULL */
+static Block *find_block(const void *p, Arena *a)
+{
+    size_t i = block_index(p);
+    Block *b;
+
+    /* The block that holds p is the last one that starts before it */
+    if (i == 0) return NULL;
+    b = table[i - 1];
+    if ((char*)p <= b->start || (char*)p >= b->end) return NULL;
+    *a = b->arena;
+    return b;
+}
+
+
+/* arena_of -- return the arena that p was allocated in, or NULL */
+EXPORT Arena arena_of(const void *p)
+{
+    Arena a;
+
+    return find_block(p, &a) ? a : NULL;
+}
+
+
+/* heap_alloc -- allocate n bytes in the current arena, or with malloc */
+EXPORT void *heap_alloc(const size_t n, const char *file, const int line)
+{
+    void *p;
+
+    if (current) return arena_alloc(current, n, file, line);
+    if (!(p = malloc(n))) fatal3("out of memory", file, line);
+    return p;
+}
+
+
+/* heap_realloc -- change the size of p, which may have been in an arena */
+EXPORT void *heap_realloc(void *p, const size_t n,
+			  const char *file, const int line)
+{
+    size_t old;
+    Block *b;
+    Arena a;
+    void *q;
+
+    if (!p) return heap_alloc(n, file, line);
+    if (!(b = find_block(p, &a))) {
+	if (!(q = realloc(p, n))) fatal3("out of memory", file, line);
+	return q;
+    }
+    old = sizeof_chunk(p);
+    if ((char*)p + roundup(old) == b->top		/* Last chunk of block */
+	&& (char*)p + roundup(n) <= b->end) {		/* and it fits */
+	b->top = (char*)p + roundup(n);
+	sizeof_chunk(p) = n;
+	return p;
+    }
+    q = arena_alloc(a, n, file, line);
+    memcpy(q, p, old < n ? old : n);
+    return q;
+}
+
+
+/* heap_free -- free memory from heap_alloc(), arena memory is mostly kept */
+EXPORT void heap_free(void *p)
+{
+    Block *b;
+    Arena a;
+
+    if (!(b = find_block(p, &a)))
+	free(p);
+    else if ((char*)p + roundup(sizeof_chunk(p)) == b->top)
+	b->top = (char*)p - ALIGN;
+}
+
+
 EXPORT char * heap_newstring(const char *s, const char *file, const int line)
 {
     char *t;
 
     if (!s) return NULL;
-    t = malloc((strlen(s) + 1) * sizeof(*t));
-    if (!t) fatal3("out of memory", file, line);
+    t = heap_alloc((strlen(s) + 1) * sizeof(*t), file, line);
     strcpy(t, s);
     return t;
 }
@@ -73,8 +299,7 @@ EXPORT char * heap_newnstring(const char *s, const size_t n,
     char *t;
 
     if (!s) return NULL;
-    t = malloc((n + 1) * sizeof(*t));
-    if (!t) fatal3("out of memory", file, line);
+    t = heap_alloc((n + 1) * sizeof(*t), file, line);
     strncpy(t, s, n);
     t[n] = '\0';
     return t;
@@ -1,12 +1,22 @@
 #define fatal(msg)  fatal3(msg, __FILE__, __LINE__)
-#define new(p)  if (((p)=malloc(sizeof(*(p))))); else fatal3("out of memory", __FILE__, __LINE__)
-#define dispose(p)  if (!(p)) ; else (free((void*)p), (p) = (void*)0)
+#define new(p)  ((p) = heap_alloc(sizeof(*(p)), __FILE__, __LINE__))
+#define dispose(p)  if (!(p)) ; else (heap_free((void*)p), (p) = (void*)0)
 #define heapmax(p)  9999999
 #define newstring(s)  heap_newstring(s, __FILE__, __LINE__)
 #define newnstring(s,n)  heap_newnstring(s, n, __FILE__, __LINE__)
-#define newarray(p,n)  if (((p)=malloc((n)*sizeof(*(p))))); else fatal3("out of memory", __FILE__, __LINE__)
-#define renewarray(p,n)  if (((p)=realloc(p,(n)*sizeof(*(p))))); else fatal3("out of memory", __FILE__, __LINE__)
+#define newarray(p,n)  ((p) = heap_alloc((n)*sizeof(*(p)), __FILE__, __LINE__))
+#define renewarray(p,n)  ((p) = heap_realloc(p, (n)*sizeof(*(p)), __FILE__, __LINE__))
+typedef struct _arena *Arena;
 extern void fatal3(const char *s, const char *file, const unsigned int line);
+extern Arena arena_new(void);
+extern Arena arena_use(Arena a);
+extern void arena_reset(Arena a);
+extern void arena_delete(Arena a);
+extern Arena arena_of(const void *p);
+extern void *heap_alloc(const size_t n, const char *file, const int line);
+extern void *heap_realloc(void *p, const size_t n,
+     const char *file, const int line);
+extern void heap_free(void *p);
 extern char * heap_newstring(const char *s, const char *file, const int line);
 extern char * heap_newnstring(const char *s, const size_t n,
          const char *file, const int line);
@@ -1,8 +1,9 @@
-/* A Bison parser, made by GNU Bison 3.0.2.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison implementation for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2013 Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
@@ -15,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -33,6 +34,10 @@
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -40,29 +45,41 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "3.0.2"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
 
 /* Pure parsers.  */
-#define YYPURE 0
+#define YYPURE 2
 
 /* Push parsers.  */
-#define YYPUSH 0
+#define YYPUSH 1
 
 /* Pull parsers.  */
 #define YYPULL 1
 
-
-
-
-/* Copy the first part of user declarations.  */
-#line 1 "html.y" /* yacc.c:339  */
+/* Substitute the type names.  */
+#define YYSTYPE         HTML_STYPE
+/* Substitute the variable and function names.  */
+#define yyparse         html_parse
+#define yypush_parse    html_push_parse
+#define yypull_parse    html_pull_parse
+#define yypstate_new    html_pstate_new
+#define yypstate_clear  html_pstate_clear
+#define yypstate_delete html_pstate_delete
+#define yypstate        html_pstate
+#define yylex           html_lex
+#define yyerror         html_error
+#define yydebug         html_debug
+#define yynerrs         html_nerrs
+
+/* First part of user prologue.  */
+#line 1 "html.y"
 
 /*
  * Simple XML grammar, with call-back functions.
@@ -81,8 +98,15 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <setjmp.h>
 #include "export.h"
 #include "types.e"
+#include "heap.e"
+#include "scan.e"
+#include "tree.e"
+#include "store.e"
 
 /* The types of the various callback routines */
 
@@ -109,173 +133,247 @@ EXPORT typedef void (*html_handle_endtag_fn)
 EXPORT typedef void (*html_handle_endincl_fn)
   (void *clientdata);
 
-/* yyparse -- entry point for the parser */
-EXPORT extern int yyparse(void);
-
-/* Store client data */
-static void *data;
-
-/* All callback routines */
-static struct {
-  html_handle_error_fn error;
-  html_handle_start_fn start;
-  html_handle_end_fn end;
-  html_handle_comment_fn comment;
-  html_handle_text_fn text;
-  html_handle_decl_fn decl;
-  html_handle_pi_fn pi;
-  html_handle_starttag_fn starttag;
-  html_handle_emptytag_fn emptytag;
-  html_handle_endtag_fn endtag;
-  html_handle_endincl_fn endincl;
-} h = {NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL};
+/* A parser has its own callback routines, client data and scanner.
+   Several parsers can be used in one thread, interleaved or nested
+   (e.g., one started from a callback of another), but not in several
+   threads at once. The scanner is flex's non-reentrant one (see
+   Scanner in scan.l), and the tree (tree.c), the atom table (atom.c)
+   and the selector matcher (selmatch.c) are global to the process. To
+   use several cores, use several processes, as batch.c does. */
+EXPORT typedef struct _parser {
+  struct {
+    html_handle_error_fn error;
+    html_handle_start_fn start;
+    html_handle_end_fn end;
+    html_handle_comment_fn comment;
+    html_handle_text_fn text;
+    html_handle_decl_fn decl;
+    html_handle_pi_fn pi;
+    html_handle_starttag_fn starttag;
+    html_handle_emptytag_fn emptytag;
+    html_handle_endtag_fn endtag;
+    html_handle_endincl_fn endincl;
+  } h;				/* All callback routines */
+  void *data;			/* Client data, returned by h.start */
+  int nrerrors;			/* Number of errors so far */
+  struct _scanner *scanner;	/* NULL means the default scanner */
+  struct _push *push;		/* State of html_parser_feed(), or NULL */
+} *Parser;
+
+/* The parser used by yyparse() and the set_*_handler() routines */
+static struct _parser default_parser = {
+  {NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL},
+  NULL, 0, NULL, NULL};
 
 /* Routines to bind concrete routines to the callbacks */
-EXPORT void set_error_handler(html_handle_error_fn f) {h.error = f;}
-EXPORT void set_start_handler(html_handle_start_fn f) {h.start = f;}
-EXPORT void set_end_handler(html_handle_end_fn f) {h.end = f;}
-EXPORT void set_comment_handler(html_handle_comment_fn f) {h.comment = f;}
-EXPORT void set_text_handler(html_handle_text_fn f) {h.text = f;}
-EXPORT void set_decl_handler(html_handle_decl_fn f) {h.decl = f;}
-EXPORT void set_pi_handler(html_handle_pi_fn f) {h.pi = f;}
-EXPORT void set_starttag_handler(html_handle_starttag_fn f){h.starttag = f;}
-EXPORT void set_emptytag_handler(html_handle_emptytag_fn f){h.emptytag = f;}
-EXPORT void set_endtag_handler(html_handle_endtag_fn f) {h.endtag = f;}
-EXPORT void set_endincl_handler(html_handle_endincl_fn f) {h.endincl = f;}
-
-extern int yylex(void);
-EXPORT int lineno = 1;		/* Line number in input file */
-
-static int nrerrors = 0;
+EXPORT void set_error_handler(html_handle_error_fn f)
+{default_parser.h.error = f;}
+EXPORT void set_start_handler(html_handle_start_fn f)
+{default_parser.h.start = f;}
+EXPORT void set_end_handler(html_handle_end_fn f)
+{default_parser.h.end = f;}
+EXPORT void set_comment_handler(html_handle_comment_fn f)
+{default_parser.h.comment = f;}
+EXPORT void set_text_handler(html_handle_text_fn f)
+{default_parser.h.text = f;}
+EXPORT void set_decl_handler(html_handle_decl_fn f)
+{default_parser.h.decl = f;}
+EXPORT void set_pi_handler(html_handle_pi_fn f)
+{default_parser.h.pi = f;}
+EXPORT void set_starttag_handler(html_handle_starttag_fn f)
+{default_parser.h.starttag = f;}
+EXPORT void set_emptytag_handler(html_handle_emptytag_fn f)
+{default_parser.h.emptytag = f;}
+EXPORT void set_endtag_handler(html_handle_endtag_fn f)
+{default_parser.h.endtag = f;}
+EXPORT void set_endincl_handler(html_handle_endincl_fn f)
+{default_parser.h.endincl = f;}
+
+static bool continued = false;	/* Next text/comment callback continues */
+
+/* lineno -- scan_lineno() when the last callback was called
+ *
+ * For programs that read this variable from their callbacks. It is set
+ * only before a callback, so new code should call scan_lineno().
+ */
+EXPORT int lineno = 1;
+
+/* html_continued -- true while a text or comment callback gets a part */
+EXPORT bool html_continued(void)
+{
+  return continued;		/* See set_chunk_size() */
+}
+
 #define MAX_ERRORS_REPORTED 20
 
 /* yyerror -- report parse error */ 
-static void yyerror(const string s)
+static void yyerror(Parser parser, const char *s)
 {
-  nrerrors++;
-  if (nrerrors < MAX_ERRORS_REPORTED)
-    h.error(data, s, lineno);
-  else if (nrerrors == MAX_ERRORS_REPORTED)
-    h.error(data, "too many errors", lineno);
+  parser->nrerrors++;
+  lineno = scan_lineno();
+  if (parser->nrerrors < MAX_ERRORS_REPORTED)
+    parser->h.error(parser->data, (string)s, lineno);
+  else if (parser->nrerrors == MAX_ERRORS_REPORTED)
+    parser->h.error(parser->data, "too many errors", lineno);
   else
     ; /* don't report any more errors */
 }
 
 /* call -- if the function exists, call it with the given aguments */
-#define call(fn, args) do {if (fn) (fn)args;} while (0)
+#define call(fn, args) \
+  do {if (parser->h.fn) {lineno = scan_lineno(); (parser->h.fn)args;}} while (0)
 
-#line 168 "html.c" /* yacc.c:339  */
+#line 227 "html.c"
 
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
 # ifndef YY_NULLPTR
-#  if defined __cplusplus && 201103L <= __cplusplus
-#   define YY_NULLPTR nullptr
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
 #  else
-#   define YY_NULLPTR 0
+#   define YY_NULLPTR ((void*)0)
 #  endif
 # endif
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 0
-#endif
-
-/* In a future release of Bison, this section will be replaced
-   by #include "y.tab.h".  */
-#ifndef YY_YY_HTML_H_INCLUDED
-# define YY_YY_HTML_H_INCLUDED
-/* Debug traces.  */
-#ifndef YYDEBUG
-# define YYDEBUG 0
-#endif
-#if YYDEBUG
-extern int yydebug;
-#endif
-
-/* Token type.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-  enum yytokentype
-  {
-    TEXT = 258,
-    COMMENT = 259,
-    START = 260,
-    END = 261,
-    NAME = 262,
-    STRING = 263,
-    PROCINS = 264,
-    EMPTYEND = 265,
-    DOCTYPE = 266,
-    ENDINCL = 267
-  };
-#endif
-/* Tokens.  */
-#define TEXT 258
-#define COMMENT 259
-#define START 260
-#define END 261
-#define NAME 262
-#define STRING 263
-#define PROCINS 264
-#define EMPTYEND 265
-#define DOCTYPE 266
-#define ENDINCL 267
-
-/* Value type.  */
-#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE YYSTYPE;
-union YYSTYPE
+#include "html.h"
+/* Symbol kind.  */
+enum yysymbol_kind_t
 {
-#line 103 "html.y" /* yacc.c:355  */
-
-    string s;
-    pairlist p;
-
-#line 237 "html.c" /* yacc.c:355  */
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_TEXT = 3,                       /* TEXT  */
+  YYSYMBOL_COMMENT = 4,                    /* COMMENT  */
+  YYSYMBOL_START = 5,                      /* START  */
+  YYSYMBOL_END = 6,                        /* END  */
+  YYSYMBOL_NAME = 7,                       /* NAME  */
+  YYSYMBOL_STRING = 8,                     /* STRING  */
+  YYSYMBOL_PROCINS = 9,                    /* PROCINS  */
+  YYSYMBOL_TEXTPART = 10,                  /* TEXTPART  */
+  YYSYMBOL_COMMENTPART = 11,               /* COMMENTPART  */
+  YYSYMBOL_EMPTYEND = 12,                  /* EMPTYEND  */
+  YYSYMBOL_DOCTYPE = 13,                   /* DOCTYPE  */
+  YYSYMBOL_ENDINCL = 14,                   /* ENDINCL  */
+  YYSYMBOL_15_ = 15,                       /* '>'  */
+  YYSYMBOL_16_ = 16,                       /* '='  */
+  YYSYMBOL_YYACCEPT = 17,                  /* $accept  */
+  YYSYMBOL_start = 18,                     /* start  */
+  YYSYMBOL_19_1 = 19,                      /* $@1  */
+  YYSYMBOL_document = 20,                  /* document  */
+  YYSYMBOL_starttag = 21,                  /* starttag  */
+  YYSYMBOL_attributes = 22,                /* attributes  */
+  YYSYMBOL_attribute = 23,                 /* attribute  */
+  YYSYMBOL_endtag = 24,                    /* endtag  */
+  YYSYMBOL_decl = 25                       /* decl  */
 };
-# define YYSTYPE_IS_TRIVIAL 1
-# define YYSTYPE_IS_DECLARED 1
-#endif
-
+typedef enum yysymbol_kind_t yysymbol_kind_t;
 
-extern YYSTYPE yylval;
 
-int yyparse (void);
 
-#endif /* !YY_YY_HTML_H_INCLUDED  */
+/* Unqualified %code blocks.  */
+#line 162 "html.y"
 
-/* Copy the second part of user declarations.  */
+extern int html_lex(HTML_STYPE *lvalp);
 
-#line 252 "html.c" /* yacc.c:358  */
+#line 291 "html.c"
 
 #ifdef short
 # undef short
 #endif
 
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
-#else
-typedef unsigned char yytype_uint8;
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
 #endif
 
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
 #else
 typedef signed char yytype_int8;
 #endif
 
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
 #else
-typedef unsigned short int yytype_uint16;
+typedef short yytype_int16;
 #endif
 
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
 #else
-typedef short int yytype_int16;
+typedef short yytype_uint8;
+#endif
+
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
+#else
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
 #endif
 
 #ifndef YYSIZE_T
@@ -283,15 +381,28 @@ typedef short int yytype_int16;
 #  define YYSIZE_T __SIZE_TYPE__
 # elif defined size_t
 #  define YYSIZE_T size_t
-# elif ! defined YYSIZE_T
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
 #  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
 #  define YYSIZE_T size_t
 # else
-#  define YYSIZE_T unsigned int
+#  define YYSIZE_T unsigned
 # endif
 #endif
 
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
 
 #ifndef YY_
 # if defined YYENABLE_NLS && YYENABLE_NLS
@@ -305,47 +416,43 @@ typedef short int yytype_int16;
 # endif
 #endif
 
-#ifndef YY_ATTRIBUTE
-# if (defined __GNUC__                                               \
-      && (2 < __GNUC__ || (__GNUC__ == 2 && 96 <= __GNUC_MINOR__)))  \
-     || defined __SUNPRO_C && 0x5110 <= __SUNPRO_C
-#  define YY_ATTRIBUTE(Spec) __attribute__(Spec)
-# else
-#  define YY_ATTRIBUTE(Spec) /* empty */
-# endif
-#endif
 
 #ifndef YY_ATTRIBUTE_PURE
-# define YY_ATTRIBUTE_PURE   YY_ATTRIBUTE ((__pure__))
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
 #endif
 
 #ifndef YY_ATTRIBUTE_UNUSED
-# define YY_ATTRIBUTE_UNUSED YY_ATTRIBUTE ((__unused__))
-#endif
-
-#if !defined _Noreturn \
-     && (!defined __STDC_VERSION__ || __STDC_VERSION__ < 201112)
-# if defined _MSC_VER && 1200 <= _MSC_VER
-#  define _Noreturn __declspec (noreturn)
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
 # else
-#  define _Noreturn YY_ATTRIBUTE ((__noreturn__))
+#  define YY_ATTRIBUTE_UNUSED
 # endif
 #endif
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(E) ((void) (E))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(E) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-#if defined __GNUC__ && 407 <= __GNUC__ * 100 + __GNUC_MINOR__
 /* Suppress an incorrect diagnostic about yylval being uninitialized.  */
-# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN \
-    _Pragma ("GCC diagnostic push") \
-    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")\
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
     _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
-# define YY_IGNORE_MAYBE_UNINITIALIZED_END \
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
     _Pragma ("GCC diagnostic pop")
 #else
 # define YY_INITIAL_VALUE(Value) Value
@@ -358,34 +465,24 @@ typedef short int yytype_int16;
 # define YY_INITIAL_VALUE(Value) /* Nothing. */
 #endif
 
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
 
-/* The parser invokes alloca or malloc; define the necessary symbols.  */
+#define YY_ASSERT(E) ((void) (0 && (E)))
 
-# ifdef YYSTACK_USE_ALLOCA
-#  if YYSTACK_USE_ALLOCA
-#   ifdef __GNUC__
-#    define YYSTACK_ALLOC __builtin_alloca
-#   elif defined __BUILTIN_VA_ARG_INCR
-#    include <alloca.h> /* INFRINGES ON USER NAME SPACE */
-#   elif defined _AIX
-#    define YYSTACK_ALLOC __alloca
-#   elif defined _MSC_VER
-#    include <malloc.h> /* INFRINGES ON USER NAME SPACE */
-#    define alloca _alloca
-#   else
-#    define YYSTACK_ALLOC alloca
-#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
-#     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
-      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
-#     ifndef EXIT_SUCCESS
-#      define EXIT_SUCCESS 0
-#     endif
-#    endif
-#   endif
-#  endif
-# endif
+#if !defined yyoverflow
+
+/* The parser invokes alloca or malloc; define the necessary symbols.  */
 
 # ifdef YYSTACK_ALLOC
    /* Pacify GCC's 'empty if-body' warning.  */
@@ -424,27 +521,26 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* !defined yyoverflow */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
-         || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+         || (defined HTML_STYPE_IS_TRIVIAL && HTML_STYPE_IS_TRIVIAL)))
 
 /* A type that is properly aligned for any stack member.  */
 union yyalloc
 {
-  yytype_int16 yyss_alloc;
+  yy_state_t yyss_alloc;
   YYSTYPE yyvs_alloc;
 };
 
 /* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
 
 /* The size of an array large to enough to hold all stacks, each with
    N elements.  */
 # define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE)) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
       + YYSTACK_GAP_MAXIMUM)
 
 # define YYCOPY_NEEDED 1
@@ -457,11 +553,11 @@ union yyalloc
 # define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
     do                                                                  \
       {                                                                 \
-        YYSIZE_T yynewbytes;                                            \
+        YYPTRDIFF_T yynewbytes;                                         \
         YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
         Stack = &yyptr->Stack_alloc;                                    \
-        yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-        yyptr += yynewbytes / sizeof (*yyptr);                          \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
       }                                                                 \
     while (0)
 
@@ -473,12 +569,12 @@ union yyalloc
 # ifndef YYCOPY
 #  if defined __GNUC__ && 1 < __GNUC__
 #   define YYCOPY(Dst, Src, Count) \
-      __builtin_memcpy (Dst, Src, (Count) * sizeof (*(Src)))
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
 #  else
 #   define YYCOPY(Dst, Src, Count)              \
       do                                        \
         {                                       \
-          YYSIZE_T yyi;                         \
+          YYPTRDIFF_T yyi;                      \
           for (yyi = 0; yyi < (Count); yyi++)   \
             (Dst)[yyi] = (Src)[yyi];            \
         }                                       \
@@ -490,28 +586,31 @@ union yyalloc
 /* YYFINAL -- State number of the termination state.  */
 #define YYFINAL  3
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   27
+#define YYLAST   26
 
 /* YYNTOKENS -- Number of terminals.  */
-#define YYNTOKENS  15
+#define YYNTOKENS  17
 /* YYNNTS -- Number of nonterminals.  */
 #define YYNNTS  9
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  23
+#define YYNRULES  25
 /* YYNSTATES -- Number of states.  */
-#define YYNSTATES  33
+#define YYNSTATES  35
 
-/* YYTRANSLATE[YYX] -- Symbol number corresponding to YYX as returned
-   by yylex, with out-of-bounds checking.  */
-#define YYUNDEFTOK  2
-#define YYMAXUTOK   267
+/* YYMAXUTOK -- Last valid token kind.  */
+#define YYMAXUTOK   269
 
-#define YYTRANSLATE(YYX)                                                \
-  ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
+
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
 
 /* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
-   as returned by yylex, without out-of-bounds checking.  */
-static const yytype_uint8 yytranslate[] =
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
 {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -519,7 +618,7 @@ static const yytype_uint8 yytranslate[] =
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,    14,    13,     2,     2,     2,     2,     2,     2,     2,
+       2,    16,    15,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -539,165 +638,169 @@ static const yytype_uint8 yytranslate[] =
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     1,     2,     3,     4,
-       5,     6,     7,     8,     9,    10,    11,    12
+       5,     6,     7,     8,     9,    10,    11,    12,    13,    14
 };
 
-#if YYDEBUG
-  /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+#if HTML_DEBUG
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
 static const yytype_uint8 yyrline[] =
 {
-       0,   116,   116,   116,   120,   121,   122,   123,   124,   125,
-     126,   127,   128,   131,   132,   135,   136,   139,   142,   145,
-     150,   153,   154,   158
+       0,   171,   171,   171,   175,   176,   177,   180,   183,   184,
+     185,   186,   187,   188,   189,   192,   193,   196,   197,   200,
+     202,   204,   208,   211,   212,   216
 };
 #endif
 
-#if YYDEBUG || YYERROR_VERBOSE || 0
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if HTML_DEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "TEXT", "COMMENT", "START", "END",
-  "NAME", "STRING", "PROCINS", "EMPTYEND", "DOCTYPE", "ENDINCL", "'>'",
-  "'='", "$accept", "start", "$@1", "document", "starttag", "attributes",
-  "attribute", "endtag", "decl", YY_NULLPTR
+  "\"end of file\"", "error", "\"invalid token\"", "TEXT", "COMMENT",
+  "START", "END", "NAME", "STRING", "PROCINS", "TEXTPART", "COMMENTPART",
+  "EMPTYEND", "DOCTYPE", "ENDINCL", "'>'", "'='", "$accept", "start",
+  "$@1", "document", "starttag", "attributes", "attribute", "endtag",
+  "decl", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[NUM] -- (External) token number corresponding to the
-   (internal) symbol number NUM (which must be that of a token).  */
-static const yytype_uint16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,    62,    61
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-#define YYPACT_NINF -6
+#define YYPACT_NINF (-9)
 
-#define yypact_value_is_default(Yystate) \
-  (!!((Yystate) == (-6)))
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
 
-#define YYTABLE_NINF -4
+#define YYTABLE_NINF (-4)
 
-#define yytable_value_is_error(Yytable_value) \
+#define yytable_value_is_error(Yyn) \
   0
 
-  /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-     STATE-NUM.  */
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
 static const yytype_int8 yypact[] =
 {
-      -6,     7,    -6,    -6,     0,    -6,    -6,    -6,    12,     1,
-      -6,    13,    -6,    -6,    -6,    -6,     8,     3,    12,    -6,
-      -5,    10,    -6,    -6,    -6,    15,    -6,    -6,    -6,     2,
-      11,    -6,    -6
+      -9,     2,    -9,    -9,     0,    -9,    -9,    -9,    10,    -8,
+      -9,    -9,    -9,    15,    -9,    -9,    -9,    -9,     7,     3,
+      10,    -9,     1,    13,    -9,    -9,    -9,    16,    -9,    -9,
+      -9,     4,    11,    -9,    -9
 };
 
-  /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
-     Performed when YYTABLE does not specify something else to do.  Zero
-     means the default is an error.  */
-static const yytype_uint8 yydefact[] =
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_int8 yydefact[] =
 {
-       2,     0,    12,     1,     0,    11,     5,     4,    16,     0,
-       9,     0,    10,     6,     7,     8,    17,     0,    16,    20,
-       0,     0,    14,    13,    15,     0,    23,    18,    19,     0,
-       0,    22,    21
+       2,     0,    14,     1,     0,    13,     5,     4,    18,     0,
+      11,     7,     6,     0,    12,     8,     9,    10,    19,     0,
+      18,    22,     0,     0,    16,    15,    17,     0,    25,    20,
+      21,     0,     0,    24,    23
 };
 
-  /* YYPGOTO[NTERM-NUM].  */
+/* YYPGOTO[NTERM-NUM].  */
 static const yytype_int8 yypgoto[] =
 {
-      -6,    -6,    -6,    -6,    -6,     9,    -6,    -6,    -6
+      -9,    -9,    -9,    -9,    -9,     5,    -9,    -9,    -9
 };
 
-  /* YYDEFGOTO[NTERM-NUM].  */
+/* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_int8 yydefgoto[] =
 {
-      -1,     1,     2,     4,    13,    17,    18,    14,    15
+       0,     1,     2,     4,    15,    19,    20,    16,    17
 };
 
-  /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
-     positive, shift that token.  If negative, reduce the rule whose
-     number is the opposite.  If YYTABLE_NINF, syntax error.  */
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_int8 yytable[] =
 {
-      -3,     5,    25,     6,     7,     8,     9,     3,    26,    10,
-      30,    11,    12,    22,    19,    31,    23,    27,    28,    16,
-      20,     0,    21,    29,    32,     0,     0,    24
+      -3,     5,     3,     6,     7,     8,     9,    21,    27,    10,
+      11,    12,    32,    13,    14,    24,    28,    18,    25,    33,
+      29,    30,    22,    23,    31,    26,    34
 };
 
 static const yytype_int8 yycheck[] =
 {
-       0,     1,     7,     3,     4,     5,     6,     0,    13,     9,
-       8,    11,    12,    10,    13,    13,    13,     7,     8,     7,
-       7,    -1,    14,     8,    13,    -1,    -1,    18
+       0,     1,     0,     3,     4,     5,     6,    15,     7,     9,
+      10,    11,     8,    13,    14,    12,    15,     7,    15,    15,
+       7,     8,     7,    16,     8,    20,    15
 };
 
-  /* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-     symbol of state STATE-NUM.  */
-static const yytype_uint8 yystos[] =
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
 {
-       0,    16,    17,     0,    18,     1,     3,     4,     5,     6,
-       9,    11,    12,    19,    22,    23,     7,    20,    21,    13,
-       7,    14,    10,    13,    20,     7,    13,     7,     8,     8,
-       8,    13,    13
+       0,    18,    19,     0,    20,     1,     3,     4,     5,     6,
+       9,    10,    11,    13,    14,    21,    24,    25,     7,    22,
+      23,    15,     7,    16,    12,    15,    22,     7,    15,     7,
+       8,     8,     8,    15,    15
 };
 
-  /* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
-static const yytype_uint8 yyr1[] =
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
 {
-       0,    15,    17,    16,    18,    18,    18,    18,    18,    18,
-      18,    18,    18,    19,    19,    20,    20,    21,    21,    21,
-      22,    23,    23,    23
+       0,    17,    19,    18,    20,    20,    20,    20,    20,    20,
+      20,    20,    20,    20,    20,    21,    21,    22,    22,    23,
+      23,    23,    24,    25,    25,    25
 };
 
-  /* YYR2[YYN] -- Number of symbols on the right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] =
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
 {
        0,     2,     0,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     0,     3,     3,     2,     0,     1,     3,     3,
-       2,     6,     5,     3
+       2,     2,     2,     2,     0,     3,     3,     2,     0,     1,
+       3,     3,     2,     6,     5,     3
 };
 
 
+enum { YYENOMEM = -2 };
+
 #define yyerrok         (yyerrstatus = 0)
-#define yyclearin       (yychar = YYEMPTY)
-#define YYEMPTY         (-2)
-#define YYEOF           0
+#define yyclearin       (yychar = HTML_EMPTY)
 
 #define YYACCEPT        goto yyacceptlab
 #define YYABORT         goto yyabortlab
 #define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
 
 #define YYRECOVERING()  (!!yyerrstatus)
 
-#define YYBACKUP(Token, Value)                                  \
-do                                                              \
-  if (yychar == YYEMPTY)                                        \
-    {                                                           \
-      yychar = (Token);                                         \
-      yylval = (Value);                                         \
-      YYPOPSTACK (yylen);                                       \
-      yystate = *yyssp;                                         \
-      goto yybackup;                                            \
-    }                                                           \
-  else                                                          \
-    {                                                           \
-      yyerror (YY_("syntax error: cannot back up")); \
-      YYERROR;                                                  \
-    }                                                           \
-while (0)
-
-/* Error token number */
-#define YYTERROR        1
-#define YYERRCODE       256
-
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == HTML_EMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (parser, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use HTML_error or HTML_UNDEF. */
+#define YYERRCODE HTML_UNDEF
 
 
 /* Enable debugging if requested.  */
-#if YYDEBUG
+#if HTML_DEBUG
 
 # ifndef YYFPRINTF
 #  include <stdio.h> /* INFRINGES ON USER NAME SPACE */
@@ -710,55 +813,53 @@ do {                                            \
     YYFPRINTF Args;                             \
 } while (0)
 
-/* This macro is provided for backward compatibility. */
-#ifndef YY_LOCATION_PRINT
-# define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-#endif
 
 
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)                    \
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
 do {                                                                      \
   if (yydebug)                                                            \
     {                                                                     \
       YYFPRINTF (stderr, "%s ", Title);                                   \
       yy_symbol_print (stderr,                                            \
-                  Type, Value); \
+                  Kind, Value, parser); \
       YYFPRINTF (stderr, "\n");                                           \
     }                                                                     \
 } while (0)
 
 
-/*----------------------------------------.
-| Print this symbol's value on YYOUTPUT.  |
-`----------------------------------------*/
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
 
 static void
-yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, struct _parser *parser)
 {
-  FILE *yyo = yyoutput;
-  YYUSE (yyo);
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (parser);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyoutput, yytoknum[yytype], *yyvaluep);
-# endif
-  YYUSE (yytype);
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
 
 static void
-yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, struct _parser *parser)
 {
-  YYFPRINTF (yyoutput, "%s %s (",
-             yytype < YYNTOKENS ? "token" : "nterm", yytname[yytype]);
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  yy_symbol_value_print (yyoutput, yytype, yyvaluep);
-  YYFPRINTF (yyoutput, ")");
+  yy_symbol_value_print (yyo, yykind, yyvaluep, parser);
+  YYFPRINTF (yyo, ")");
 }
 
 /*------------------------------------------------------------------.
@@ -767,7 +868,7 @@ yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
 `------------------------------------------------------------------*/
 
 static void
-yy_stack_print (yytype_int16 *yybottom, yytype_int16 *yytop)
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
   YYFPRINTF (stderr, "Stack now");
   for (; yybottom <= yytop; yybottom++)
@@ -790,21 +891,21 @@ do {                                                            \
 `------------------------------------------------*/
 
 static void
-yy_reduce_print (yytype_int16 *yyssp, YYSTYPE *yyvsp, int yyrule)
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule, struct _parser *parser)
 {
-  unsigned long int yylno = yyrline[yyrule];
+  int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
   int yyi;
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu):\n",
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
              yyrule - 1, yylno);
   /* The symbols being reduced.  */
   for (yyi = 0; yyi < yynrhs; yyi++)
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
       yy_symbol_print (stderr,
-                       yystos[yyssp[yyi + 1 - yynrhs]],
-                       &(yyvsp[(yyi + 1) - (yynrhs)])
-                                              );
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)], parser);
       YYFPRINTF (stderr, "\n");
     }
 }
@@ -812,18 +913,18 @@ yy_reduce_print (yytype_int16 *yyssp, YYSTYPE *yyvsp, int yyrule)
 # define YY_REDUCE_PRINT(Rule)          \
 do {                                    \
   if (yydebug)                          \
-    yy_reduce_print (yyssp, yyvsp, Rule); \
+    yy_reduce_print (yyssp, yyvsp, Rule, parser); \
 } while (0)
 
 /* Nonzero means print parse trace.  It is left uninitialized so that
    multiple parsers can coexist.  */
 int yydebug;
-#else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+#else /* !HTML_DEBUG */
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
-#endif /* !YYDEBUG */
+#endif /* !HTML_DEBUG */
 
 
 /* YYINITDEPTH -- initial size of the parser's stacks.  */
@@ -841,303 +942,179 @@ int yydebug;
 #ifndef YYMAXDEPTH
 # define YYMAXDEPTH 10000
 #endif
+/* Parser data structure.  */
+struct yypstate
+  {
+    /* Number of syntax errors so far.  */
+    int yynerrs;
 
+    yy_state_fast_t yystate;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus;
 
-#if YYERROR_VERBOSE
-
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen strlen
-#  else
-/* Return the length of YYSTR.  */
-static YYSIZE_T
-yystrlen (const char *yystr)
-{
-  YYSIZE_T yylen;
-  for (yylen = 0; yystr[yylen]; yylen++)
-    continue;
-  return yylen;
-}
-#  endif
-# endif
-
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
-/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
-   YYDEST.  */
-static char *
-yystpcpy (char *yydest, const char *yysrc)
-{
-  char *yyd = yydest;
-  const char *yys = yysrc;
-
-  while ((*yyd++ = *yys++) != '\0')
-    continue;
-
-  return yyd - 1;
-}
-#  endif
-# endif
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
+       to reallocate them elsewhere.  */
 
-# ifndef yytnamerr
-/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
-   quotes and backslashes, so that it's suitable for yyerror.  The
-   heuristic is that double-quoting is unnecessary unless the string
-   contains an apostrophe, a comma, or backslash (other than
-   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
-   null, do not copy; instead, return the length of what the result
-   would have been.  */
-static YYSIZE_T
-yytnamerr (char *yyres, const char *yystr)
-{
-  if (*yystr == '"')
-    {
-      YYSIZE_T yyn = 0;
-      char const *yyp = yystr;
-
-      for (;;)
-        switch (*++yyp)
-          {
-          case '\'':
-          case ',':
-            goto do_not_strip_quotes;
-
-          case '\\':
-            if (*++yyp != '\\')
-              goto do_not_strip_quotes;
-            /* Fall through.  */
-          default:
-            if (yyres)
-              yyres[yyn] = *yyp;
-            yyn++;
-            break;
-
-          case '"':
-            if (yyres)
-              yyres[yyn] = '\0';
-            return yyn;
-          }
-    do_not_strip_quotes: ;
-    }
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize;
 
-  if (! yyres)
-    return yystrlen (yystr);
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss;
+    yy_state_t *yyssp;
 
-  return yystpcpy (yyres, yystr) - yyres;
-}
-# endif
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs;
+    YYSTYPE *yyvsp;
+    /* Whether this instance has not started parsing yet.
+     * If 2, it corresponds to a finished parsing.  */
+    int yynew;
+  };
 
-/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
-   about the unexpected token YYTOKEN for the state stack whose top is
-   YYSSP.
-
-   Return 0 if *YYMSG was successfully written.  Return 1 if *YYMSG is
-   not large enough to hold the message.  In that case, also set
-   *YYMSG_ALLOC to the required number of bytes.  Return 2 if the
-   required number of bytes is too large to store.  */
-static int
-yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
-                yytype_int16 *yyssp, int yytoken)
-{
-  YYSIZE_T yysize0 = yytnamerr (YY_NULLPTR, yytname[yytoken]);
-  YYSIZE_T yysize = yysize0;
-  enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-  /* Internationalized format string. */
-  const char *yyformat = YY_NULLPTR;
-  /* Arguments of yyformat. */
-  char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-  /* Number of reported tokens (one for the "unexpected", one per
-     "expected"). */
-  int yycount = 0;
-
-  /* There are many possibilities here to consider:
-     - If this state is a consistent state with a default action, then
-       the only way this function was invoked is if the default action
-       is an error action.  In that case, don't check for expected
-       tokens because there are none.
-     - The only way there can be no lookahead present (in yychar) is if
-       this state is a consistent state with a default action.  Thus,
-       detecting the absence of a lookahead is sufficient to determine
-       that there is no unexpected or expected token to report.  In that
-       case, just report a simple "syntax error".
-     - Don't assume there isn't a lookahead just because this state is a
-       consistent state with a default action.  There might have been a
-       previous inconsistent state, consistent state with a non-default
-       action, or user semantic action that manipulated yychar.
-     - Of course, the expected token list depends on states to have
-       correct lookahead information, and it depends on the parser not
-       to perform extra reductions after fetching a lookahead from the
-       scanner and before detecting a syntax error.  Thus, state merging
-       (from LALR or IELR) and default reductions corrupt the expected
-       token list.  However, the list is correct for canonical LR with
-       one exception: it will still contain any token that will not be
-       accepted due to an error action in a later state.
-  */
-  if (yytoken != YYEMPTY)
-    {
-      int yyn = yypact[*yyssp];
-      yyarg[yycount++] = yytname[yytoken];
-      if (!yypact_value_is_default (yyn))
-        {
-          /* Start YYX at -YYN if negative to avoid negative indexes in
-             YYCHECK.  In other words, skip the first -YYN actions for
-             this state because they are default actions.  */
-          int yyxbegin = yyn < 0 ? -yyn : 0;
-          /* Stay within bounds of both yycheck and yytname.  */
-          int yychecklim = YYLAST - yyn + 1;
-          int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-          int yyx;
-
-          for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-            if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR
-                && !yytable_value_is_error (yytable[yyx + yyn]))
-              {
-                if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-                  {
-                    yycount = 1;
-                    yysize = yysize0;
-                    break;
-                  }
-                yyarg[yycount++] = yytname[yyx];
-                {
-                  YYSIZE_T yysize1 = yysize + yytnamerr (YY_NULLPTR, yytname[yyx]);
-                  if (! (yysize <= yysize1
-                         && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-                    return 2;
-                  yysize = yysize1;
-                }
-              }
-        }
-    }
 
-  switch (yycount)
-    {
-# define YYCASE_(N, S)                      \
-      case N:                               \
-        yyformat = S;                       \
-      break
-      YYCASE_(0, YY_("syntax error"));
-      YYCASE_(1, YY_("syntax error, unexpected %s"));
-      YYCASE_(2, YY_("syntax error, unexpected %s, expecting %s"));
-      YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
-      YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
-      YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
-# undef YYCASE_
-    }
 
-  {
-    YYSIZE_T yysize1 = yysize + yystrlen (yyformat);
-    if (! (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-      return 2;
-    yysize = yysize1;
-  }
 
-  if (*yymsg_alloc < yysize)
-    {
-      *yymsg_alloc = 2 * yysize;
-      if (! (yysize <= *yymsg_alloc
-             && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
-        *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
-      return 1;
-    }
 
-  /* Avoid sprintf, as that infringes on the user's name space.
-     Don't have undefined behavior even if the translation
-     produced a string with the wrong number of "%s"s.  */
-  {
-    char *yyp = *yymsg;
-    int yyi = 0;
-    while ((*yyp = *yyformat) != '\0')
-      if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
-        {
-          yyp += yytnamerr (yyp, yyarg[yyi++]);
-          yyformat += 2;
-        }
-      else
-        {
-          yyp++;
-          yyformat++;
-        }
-  }
-  return 0;
-}
-#endif /* YYERROR_VERBOSE */
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
 static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep)
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, struct _parser *parser)
 {
-  YYUSE (yyvaluep);
+  YY_USE (yyvaluep);
+  YY_USE (parser);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  YYUSE (yytype);
+  YY_USE (yykind);
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
 
 
-/* The lookahead symbol.  */
-int yychar;
 
-/* The semantic value of the lookahead symbol.  */
-YYSTYPE yylval;
-/* Number of syntax errors so far.  */
-int yynerrs;
+int
+yyparse (struct _parser *parser)
+{
+  yypstate *yyps = yypstate_new ();
+  if (!yyps)
+    {
+      yyerror (parser, YY_("memory exhausted"));
+      return 2;
+    }
+  int yystatus = yypull_parse (yyps, parser);
+  yypstate_delete (yyps);
+  return yystatus;
+}
 
+int
+yypull_parse (yypstate *yyps, struct _parser *parser)
+{
+  YY_ASSERT (yyps);
+  int yystatus;
+  do {
+    YYSTYPE yylval;
+    int yychar = yylex (&yylval);
+    yystatus = yypush_parse (yyps, yychar, &yylval, parser);
+  } while (yystatus == YYPUSH_MORE);
+  return yystatus;
+}
 
-/*----------.
-| yyparse.  |
-`----------*/
+#define html_nerrs yyps->html_nerrs
+#define yystate yyps->yystate
+#define yyerrstatus yyps->yyerrstatus
+#define yyssa yyps->yyssa
+#define yyss yyps->yyss
+#define yyssp yyps->yyssp
+#define yyvsa yyps->yyvsa
+#define yyvs yyps->yyvs
+#define yyvsp yyps->yyvsp
+#define yystacksize yyps->yystacksize
+
+/* Initialize the parser data structure.  */
+static void
+yypstate_clear (yypstate *yyps)
+{
+  yynerrs = 0;
+  yystate = 0;
+  yyerrstatus = 0;
 
-int
-yyparse (void)
+  yyssp = yyss;
+  yyvsp = yyvs;
+
+  /* Initialize the state stack, in case yypcontext_expected_tokens is
+     called before the first call to yyparse. */
+  *yyssp = 0;
+  yyps->yynew = 1;
+}
+
+/* Initialize the parser data structure.  */
+yypstate *
+yypstate_new (void)
 {
-    int yystate;
-    /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
+  yypstate *yyps;
+  yyps = YY_CAST (yypstate *, YYMALLOC (sizeof *yyps));
+  if (!yyps)
+    return YY_NULLPTR;
+  yystacksize = YYINITDEPTH;
+  yyss = yyssa;
+  yyvs = yyvsa;
+  yypstate_clear (yyps);
+  return yyps;
+}
+
+void
+yypstate_delete (yypstate *yyps)
+{
+  if (yyps)
+    {
+#ifndef yyoverflow
+      /* If the stack was reallocated but the parse did not complete, then the
+         stack still needs to be freed.  */
+      if (yyss != yyssa)
+        YYSTACK_FREE (yyss);
+#endif
+      YYFREE (yyps);
+    }
+}
 
-    /* The stacks and their tools:
-       'yyss': related to states.
-       'yyvs': related to semantic values.
 
-       Refer to the stacks through separate pointers, to allow yyoverflow
-       to reallocate them elsewhere.  */
 
-    /* The state stack.  */
-    yytype_int16 yyssa[YYINITDEPTH];
-    yytype_int16 *yyss;
-    yytype_int16 *yyssp;
+/*---------------.
+| yypush_parse.  |
+`---------------*/
+
+int
+yypush_parse (yypstate *yyps,
+              int yypushed_char, YYSTYPE const *yypushed_val, struct _parser *parser)
+{
+/* Lookahead token kind.  */
+int yychar;
 
-    /* The semantic value stack.  */
-    YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
 
-    YYSIZE_T yystacksize;
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
 
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken = 0;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
 
-#if YYERROR_VERBOSE
-  /* Buffer for error messages, and its allocated size.  */
-  char yymsgbuf[128];
-  char *yymsg = yymsgbuf;
-  YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
-#endif
+
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
 
@@ -1145,71 +1122,89 @@ yyparse (void)
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yyssp = yyss = yyssa;
-  yyvsp = yyvs = yyvsa;
-  yystacksize = YYINITDEPTH;
+  switch (yyps->yynew)
+    {
+    case 0:
+      yyn = yypact[yystate];
+      goto yyread_pushed_token;
+
+    case 2:
+      yypstate_clear (yyps);
+      break;
+
+    default:
+      break;
+    }
 
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
-  yychar = YYEMPTY; /* Cause a token to be read.  */
+  yychar = HTML_EMPTY; /* Cause a token to be read.  */
+
   goto yysetstate;
 
+
 /*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
+| yynewstate -- push a new state, which is found in yystate.  |
 `------------------------------------------------------------*/
- yynewstate:
+yynewstate:
   /* In all cases, when you get here, the value and location stacks
      have just been pushed.  So pushing a state here evens the stacks.  */
   yyssp++;
 
- yysetstate:
-  *yyssp = yystate;
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
     {
       /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = yyssp - yyss + 1;
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
 
-#ifdef yyoverflow
+# if defined yyoverflow
       {
         /* Give user a chance to reallocate the stack.  Use copies of
            these so that the &'s don't force the real ones into
            memory.  */
+        yy_state_t *yyss1 = yyss;
         YYSTYPE *yyvs1 = yyvs;
-        yytype_int16 *yyss1 = yyss;
 
         /* Each stack pointer address is followed by the size of the
            data in use in that stack, in bytes.  This used to be a
            conditional around just the two extra args, but that might
            be undefined if yyoverflow is a macro.  */
         yyoverflow (YY_("memory exhausted"),
-                    &yyss1, yysize * sizeof (*yyssp),
-                    &yyvs1, yysize * sizeof (*yyvsp),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
                     &yystacksize);
-
         yyss = yyss1;
         yyvs = yyvs1;
       }
-#else /* no yyoverflow */
-# ifndef YYSTACK_RELOCATE
-      goto yyexhaustedlab;
-# else
+# else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-        goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
         yystacksize = YYMAXDEPTH;
 
       {
-        yytype_int16 *yyss1 = yyss;
+        yy_state_t *yyss1 = yyss;
         union yyalloc *yyptr =
-          (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
         if (! yyptr)
-          goto yyexhaustedlab;
+          YYNOMEM;
         YYSTACK_RELOCATE (yyss_alloc, yyss);
         YYSTACK_RELOCATE (yyvs_alloc, yyvs);
 #  undef YYSTACK_RELOCATE
@@ -1217,30 +1212,31 @@ yyparse (void)
           YYSTACK_FREE (yyss1);
       }
 # endif
-#endif /* no yyoverflow */
 
       yyssp = yyss + yysize - 1;
       yyvsp = yyvs + yysize - 1;
 
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-                  (unsigned long int) yystacksize));
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
 
       if (yyss + yystacksize - 1 <= yyssp)
         YYABORT;
     }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
-  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
 
   if (yystate == YYFINAL)
     YYACCEPT;
 
   goto yybackup;
 
+
 /*-----------.
 | yybackup.  |
 `-----------*/
 yybackup:
-
   /* Do appropriate processing given the current state.  Read a
      lookahead token if we need one and don't already have one.  */
 
@@ -1251,18 +1247,39 @@ yybackup:
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
-  if (yychar == YYEMPTY)
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
+  if (yychar == HTML_EMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
-      yychar = yylex ();
+      if (!yyps->yynew)
+        {
+          YYDPRINTF ((stderr, "Return for a new token:\n"));
+          yyresult = YYPUSH_MORE;
+          goto yypushreturn;
+        }
+      yyps->yynew = 0;
+yyread_pushed_token:
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yypushed_char;
+      if (yypushed_val)
+        yylval = *yypushed_val;
     }
 
-  if (yychar <= YYEOF)
+  if (yychar <= HTML_EOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = HTML_EOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == HTML_error)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = HTML_UNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1290,15 +1307,13 @@ yybackup:
 
   /* Shift the lookahead token.  */
   YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the shifted token.  */
-  yychar = YYEMPTY;
-
   yystate = yyn;
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 
+  /* Discard the shifted token.  */
+  yychar = HTML_EMPTY;
   goto yynewstate;
 
 
@@ -1313,7 +1328,7 @@ yydefault:
 
 
 /*-----------------------------.
-| yyreduce -- Do a reduction.  |
+| yyreduce -- do a reduction.  |
 `-----------------------------*/
 yyreduce:
   /* yyn is the number of a rule to reduce with.  */
@@ -1333,119 +1348,133 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-        case 2:
-#line 116 "html.y" /* yacc.c:1646  */
-    {data = h.start ? h.start() : NULL;}
-#line 1340 "html.c" /* yacc.c:1646  */
+  case 2: /* $@1: %empty  */
+#line 171 "html.y"
+                                        {parser->data = parser->h.start ? parser->h.start() : NULL;}
+#line 1355 "html.c"
+    break;
+
+  case 3: /* start: $@1 document  */
+#line 172 "html.y"
+                                        {call(end, (parser->data));}
+#line 1361 "html.c"
     break;
 
-  case 3:
-#line 117 "html.y" /* yacc.c:1646  */
-    {call(h.end, (data));}
-#line 1346 "html.c" /* yacc.c:1646  */
+  case 4: /* document: document COMMENT  */
+#line 175 "html.y"
+                                        {call(comment, (parser->data, (yyvsp[0].s)));}
+#line 1367 "html.c"
     break;
 
-  case 4:
-#line 120 "html.y" /* yacc.c:1646  */
-    {call(h.comment, (data, (yyvsp[0].s)));}
-#line 1352 "html.c" /* yacc.c:1646  */
+  case 5: /* document: document TEXT  */
+#line 176 "html.y"
+                                        {call(text, (parser->data, (yyvsp[0].s)));}
+#line 1373 "html.c"
     break;
 
-  case 5:
-#line 121 "html.y" /* yacc.c:1646  */
-    {call(h.text, (data, (yyvsp[0].s)));}
-#line 1358 "html.c" /* yacc.c:1646  */
+  case 6: /* document: document COMMENTPART  */
+#line 177 "html.y"
+                                        {continued = true;
+					 call(comment, (parser->data, (yyvsp[0].s)));
+					 continued = false;}
+#line 1381 "html.c"
     break;
 
-  case 9:
-#line 125 "html.y" /* yacc.c:1646  */
-    {call(h.pi, (data, (yyvsp[0].s)));}
-#line 1364 "html.c" /* yacc.c:1646  */
+  case 7: /* document: document TEXTPART  */
+#line 180 "html.y"
+                                        {continued = true;
+					 call(text, (parser->data, (yyvsp[0].s)));
+					 continued = false;}
+#line 1389 "html.c"
     break;
 
-  case 10:
-#line 126 "html.y" /* yacc.c:1646  */
-    {call(h.endincl, (data));}
-#line 1370 "html.c" /* yacc.c:1646  */
+  case 11: /* document: document PROCINS  */
+#line 186 "html.y"
+                                        {call(pi, (parser->data, (yyvsp[0].s)));}
+#line 1395 "html.c"
     break;
 
-  case 13:
-#line 131 "html.y" /* yacc.c:1646  */
-    {call(h.starttag, (data, (yyvsp[-2].s), (yyvsp[-1].p)));}
-#line 1376 "html.c" /* yacc.c:1646  */
+  case 12: /* document: document ENDINCL  */
+#line 187 "html.y"
+                                        {call(endincl, (parser->data));}
+#line 1401 "html.c"
     break;
 
-  case 14:
-#line 132 "html.y" /* yacc.c:1646  */
-    {call(h.emptytag, (data, (yyvsp[-2].s), (yyvsp[-1].p)));}
-#line 1382 "html.c" /* yacc.c:1646  */
+  case 15: /* starttag: START attributes '>'  */
+#line 192 "html.y"
+                                        {call(starttag, (parser->data, (yyvsp[-2].s), (yyvsp[-1].p)));}
+#line 1407 "html.c"
     break;
 
-  case 15:
-#line 135 "html.y" /* yacc.c:1646  */
-    {(yyval.p) = (yyvsp[-1].p); (yyval.p)->next = (yyvsp[0].p);}
-#line 1388 "html.c" /* yacc.c:1646  */
+  case 16: /* starttag: START attributes EMPTYEND  */
+#line 193 "html.y"
+                                        {call(emptytag, (parser->data, (yyvsp[-2].s), (yyvsp[-1].p)));}
+#line 1413 "html.c"
     break;
 
-  case 16:
-#line 136 "html.y" /* yacc.c:1646  */
-    {(yyval.p) = NULL;}
-#line 1394 "html.c" /* yacc.c:1646  */
+  case 17: /* attributes: attribute attributes  */
+#line 196 "html.y"
+                                        {(yyval.p) = (yyvsp[-1].p); (yyval.p)->next = (yyvsp[0].p);}
+#line 1419 "html.c"
     break;
 
-  case 17:
-#line 139 "html.y" /* yacc.c:1646  */
-    {pairlist h = malloc(sizeof(*h));
-					 assert(h != NULL); h->name = (yyvsp[0].s);
+  case 18: /* attributes: %empty  */
+#line 197 "html.y"
+                                        {(yyval.p) = NULL;}
+#line 1425 "html.c"
+    break;
+
+  case 19: /* attribute: NAME  */
+#line 200 "html.y"
+                                        {pairlist h; new(h); h->name = (yyvsp[0].s);
 					 h->value=NULL; (yyval.p) = h;}
-#line 1402 "html.c" /* yacc.c:1646  */
+#line 1432 "html.c"
     break;
 
-  case 18:
-#line 142 "html.y" /* yacc.c:1646  */
-    {pairlist h = malloc(sizeof(*h));
-					 assert(h != NULL); h->name = (yyvsp[-2].s);
+  case 20: /* attribute: NAME '=' NAME  */
+#line 202 "html.y"
+                                        {pairlist h; new(h); h->name = (yyvsp[-2].s);
 					 h->value = (yyvsp[0].s); (yyval.p) = h;}
-#line 1410 "html.c" /* yacc.c:1646  */
+#line 1439 "html.c"
     break;
 
-  case 19:
-#line 145 "html.y" /* yacc.c:1646  */
-    {pairlist h = malloc(sizeof(*h));
-					 assert(h != NULL); h->name = (yyvsp[-2].s);
+  case 21: /* attribute: NAME '=' STRING  */
+#line 204 "html.y"
+                                        {pairlist h; new(h); h->name = (yyvsp[-2].s);
 					 h->value = (yyvsp[0].s); (yyval.p) = h;}
-#line 1418 "html.c" /* yacc.c:1646  */
+#line 1446 "html.c"
     break;
 
-  case 20:
-#line 150 "html.y" /* yacc.c:1646  */
-    {call(h.endtag, (data, (yyvsp[-1].s)));}
-#line 1424 "html.c" /* yacc.c:1646  */
+  case 22: /* endtag: END '>'  */
+#line 208 "html.y"
+                                        {call(endtag, (parser->data, (yyvsp[-1].s)));}
+#line 1452 "html.c"
     break;
 
-  case 21:
-#line 153 "html.y" /* yacc.c:1646  */
-    {call(h.decl, (data, (yyvsp[-4].s), (yyvsp[-2].s), (yyvsp[-1].s)));}
-#line 1430 "html.c" /* yacc.c:1646  */
+  case 23: /* decl: DOCTYPE NAME NAME STRING STRING '>'  */
+#line 211 "html.y"
+                                        {call(decl, (parser->data, (yyvsp[-4].s), (yyvsp[-2].s), (yyvsp[-1].s)));}
+#line 1458 "html.c"
     break;
 
-  case 22:
-#line 154 "html.y" /* yacc.c:1646  */
-    {if (strcasecmp((yyvsp[-2].s), "public") == 0)
-				     	   call(h.decl, (data, (yyvsp[-3].s), (yyvsp[-1].s), NULL));
+  case 24: /* decl: DOCTYPE NAME NAME STRING '>'  */
+#line 212 "html.y"
+                                        {if (strcasecmp((yyvsp[-2].s), "public") == 0)
+				     	   call(decl, (parser->data, (yyvsp[-3].s), (yyvsp[-1].s), NULL));
 					 else /* "system" */
-					   call(h.decl, (data, (yyvsp[-3].s), NULL, (yyvsp[-1].s)));}
-#line 1439 "html.c" /* yacc.c:1646  */
+					   call(decl, (parser->data, (yyvsp[-3].s), NULL, (yyvsp[-1].s)));}
+#line 1467 "html.c"
     break;
 
-  case 23:
-#line 158 "html.y" /* yacc.c:1646  */
-    {call(h.decl, (data, (yyvsp[-1].s), NULL, NULL));}
-#line 1445 "html.c" /* yacc.c:1646  */
+  case 25: /* decl: DOCTYPE NAME '>'  */
+#line 216 "html.y"
+                                        {call(decl, (parser->data, (yyvsp[-1].s), NULL, NULL));}
+#line 1473 "html.c"
     break;
 
 
-#line 1449 "html.c" /* yacc.c:1646  */
+#line 1477 "html.c"
+
       default: break;
     }
   /* User semantic actions sometimes alter yychar, and that requires
@@ -1459,25 +1488,23 @@ yyreduce:
      case of YYERROR or YYBACKUP, subsequent parser actions might lead
      to an incorrect destructor call or verbose syntax error message
      before the lookahead is translated.  */
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
 
   /* Now 'shift' the result of the reduction.  Determine what state
      that goes to, based on the state we popped back to and the rule
      number reduced by.  */
-
-  yyn = yyr1[yyn];
-
-  yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-  if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-    yystate = yytable[yystate];
-  else
-    yystate = yydefgoto[yyn - YYNTOKENS];
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
 
   goto yynewstate;
 
@@ -1488,66 +1515,30 @@ yyreduce:
 yyerrlab:
   /* Make sure we have latest lookahead translation.  See comments at
      user semantic actions for why this is necessary.  */
-  yytoken = yychar == YYEMPTY ? YYEMPTY : YYTRANSLATE (yychar);
-
+  yytoken = yychar == HTML_EMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
-      yyerror (YY_("syntax error"));
-#else
-# define YYSYNTAX_ERROR yysyntax_error (&yymsg_alloc, &yymsg, \
-                                        yyssp, yytoken)
-      {
-        char const *yymsgp = YY_("syntax error");
-        int yysyntax_error_status;
-        yysyntax_error_status = YYSYNTAX_ERROR;
-        if (yysyntax_error_status == 0)
-          yymsgp = yymsg;
-        else if (yysyntax_error_status == 1)
-          {
-            if (yymsg != yymsgbuf)
-              YYSTACK_FREE (yymsg);
-            yymsg = (char *) YYSTACK_ALLOC (yymsg_alloc);
-            if (!yymsg)
-              {
-                yymsg = yymsgbuf;
-                yymsg_alloc = sizeof yymsgbuf;
-                yysyntax_error_status = 2;
-              }
-            else
-              {
-                yysyntax_error_status = YYSYNTAX_ERROR;
-                yymsgp = yymsg;
-              }
-          }
-        yyerror (yymsgp);
-        if (yysyntax_error_status == 2)
-          goto yyexhaustedlab;
-      }
-# undef YYSYNTAX_ERROR
-#endif
+      yyerror (parser, YY_("syntax error"));
     }
 
-
-
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
          error, discard it.  */
 
-      if (yychar <= YYEOF)
+      if (yychar <= HTML_EOF)
         {
           /* Return failure if at end of input.  */
-          if (yychar == YYEOF)
+          if (yychar == HTML_EOF)
             YYABORT;
         }
       else
         {
           yydestruct ("Error: discarding",
-                      yytoken, &yylval);
-          yychar = YYEMPTY;
+                      yytoken, &yylval, parser);
+          yychar = HTML_EMPTY;
         }
     }
 
@@ -1560,12 +1551,11 @@ yyerrlab:
 | yyerrorlab -- error raised explicitly by YYERROR.  |
 `---------------------------------------------------*/
 yyerrorlab:
-
-  /* Pacify compilers like GCC when the user code never invokes
-     YYERROR and the label yyerrorlab therefore never appears in user
-     code.  */
-  if (/*CONSTCOND*/ 0)
-     goto yyerrorlab;
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
 
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
@@ -1582,13 +1572,14 @@ yyerrorlab:
 yyerrlab1:
   yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
       if (!yypact_value_is_default (yyn))
         {
-          yyn += YYTERROR;
-          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
             {
               yyn = yytable[yyn];
               if (0 < yyn)
@@ -1602,7 +1593,7 @@ yyerrlab1:
 
 
       yydestruct ("Error: popping",
-                  yystos[yystate], yyvsp);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, parser);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
@@ -1614,7 +1605,7 @@ yyerrlab1:
 
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -1625,33 +1616,37 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
 /*-----------------------------------.
 | yyabortlab -- YYABORT comes here.  |
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
 
-#if !defined yyoverflow || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
-  yyerror (YY_("memory exhausted"));
+  yyerror (parser, YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
+
 
-yyreturn:
-  if (yychar != YYEMPTY)
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
+  if (yychar != HTML_EMPTY)
     {
       /* Make sure we have latest lookahead translation.  See comments at
          user semantic actions for why this is necessary.  */
       yytoken = YYTRANSLATE (yychar);
       yydestruct ("Cleanup: discarding lookahead",
-                  yytoken, &yylval);
+                  yytoken, &yylval, parser);
     }
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYABORT or YYACCEPT.  */
@@ -1660,16 +1655,241 @@ yyreturn:
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-                  yystos[*yyssp], yyvsp);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, parser);
       YYPOPSTACK (1);
     }
-#ifndef yyoverflow
-  if (yyss != yyssa)
-    YYSTACK_FREE (yyss);
-#endif
-#if YYERROR_VERBOSE
-  if (yymsg != yymsgbuf)
-    YYSTACK_FREE (yymsg);
-#endif
+  yyps->yynew = 2;
+  goto yypushreturn;
+
+
+/*-------------------------.
+| yypushreturn -- return.  |
+`-------------------------*/
+yypushreturn:
+
   return yyresult;
 }
+#undef html_nerrs
+#undef yystate
+#undef yyerrstatus
+#undef yyssa
+#undef yyss
+#undef yyssp
+#undef yyvsa
+#undef yyvs
+#undef yyvsp
+#undef yystacksize
+#line 219 "html.y"
+
+
+/* A parser that is fed bytes, instead of reading a file, pushes the
+   tokens into bison's push parser as the scanner finds them. When the
+   scanner has used up the bytes, it calls stall(), which jumps back to
+   push_tokens(), to wait for the next html_parser_feed(). */
+struct _push {
+  html_pstate *ps;		/* Bison's parser state */
+  int status;			/* YYPUSH_MORE or the result of the parse */
+  jmp_buf stalled;		/* Where push_tokens() waits for bytes */
+};
+
+/* end_push -- free p's push parser state, if any */
+static void end_push(Parser p)
+{
+  if (p->push) {
+    html_pstate_delete(p->push->ps);
+    dispose(p->push);
+  }
+}
+
+/* html_parser_create -- create a parser with its own scanner */
+EXPORT Parser html_parser_create(void)
+{
+  Arena a = arena_use(NULL);	/* A parser may outlive a document's arena */
+  Parser p;
+
+  new(p);
+  memset(&p->h, 0, sizeof(p->h));
+  p->data = NULL;
+  p->nrerrors = 0;
+  p->scanner = scanner_create();
+  p->push = NULL;
+  (void) arena_use(a);
+  return p;
+}
+
+/* html_parser_delete -- free a parser, its scanner and its open buffers */
+EXPORT void html_parser_delete(Parser p)
+{
+  end_push(p);
+  scanner_delete(p->scanner);
+  dispose(p);
+}
+
+/* html_parser_reset -- reset p (NULL = default parser) for a new document */
+EXPORT void html_parser_reset(Parser p)
+{
+  if (!p) p = &default_parser;
+  end_push(p);
+  p->data = NULL;
+  p->nrerrors = 0;
+  lineno = 1;
+  scanner_reset(p->scanner);
+}
+
+/* html_parser_set_input -- set the file that p will parse and its name */
+EXPORT void html_parser_set_input(Parser p, FILE *f, const conststring name)
+{
+  scanner_set_input(p->scanner, f, name);
+}
+
+/* copy_attribs -- return a copy of the attributes of element n of st */
+static pairlist copy_attribs(const Store st, NodeId n)
+{
+  pairlist attribs, *tail = &attribs;
+  conststring v;
+  uint32_t a;
+
+  for (a = store_attribs(st, n); a; a = store_attr_next(st, a)) {
+    new(*tail);
+    (*tail)->name = newstring(store_attr_name(st, a));
+    (*tail)->value = (v = store_attr_value(st, a)) ? newstring(v) : NULL;
+    tail = &(*tail)->next;
+  }
+  *tail = NULL;
+  return attribs;
+}
+
+/* replay -- call the parser's callbacks for the nodes of a snapshot */
+static void replay(Parser parser, const Store st)
+{
+  NodeId n, open = store_root(st), last = store_count(st);
+  conststring fpi, url;
+
+  /* The callbacks get their own copies of the strings, as when parsing */
+  parser->data = parser->h.start ? parser->h.start() : NULL;
+  for (n = store_root(st) + 1; n <= last; n++) {
+    for (; open != store_parent(st, n); open = store_parent(st, open))
+      call(endtag, (parser->data, newstring(store_name(st, open))));
+    switch (store_type(st, n)) {
+    case Element:
+      if (store_is_empty(st, n)) {
+	call(emptytag, (parser->data, newstring(store_name(st, n)),
+			copy_attribs(st, n)));
+      } else {
+	call(starttag, (parser->data, newstring(store_name(st, n)),
+			copy_attribs(st, n)));
+	open = n;
+      }
+      break;
+    case Text:
+      call(text, (parser->data, newstring(store_text(st, n))));
+      break;
+    case Comment:
+      call(comment, (parser->data, newstring(store_text(st, n))));
+      break;
+    case Procins:
+      call(pi, (parser->data, newstring(store_text(st, n))));
+      break;
+    case Declaration:
+      fpi = store_text(st, n);
+      url = store_url(st, n);
+      call(decl, (parser->data, newstring(store_name(st, n)),
+		  fpi ? newstring(fpi) : NULL, url ? newstring(url) : NULL));
+      break;
+    default:
+      assert(!"Cannot happen");
+    }
+  }
+  for (; open != store_root(st); open = store_parent(st, open))
+    call(endtag, (parser->data, newstring(store_name(st, open))));
+  call(end, (parser->data));
+}
+
+/* html_parser_run -- parse p's input, calling p's callbacks; 0 if OK */
+EXPORT int html_parser_run(Parser p)
+{
+  Scanner prev = scanner_switch(p->scanner);
+  int result = 0;
+  Store st;
+  FILE *f;
+
+  /* A snapshot written by a tool with -S needs no parsing, only replay */
+  if ((f = unread_input()) && (st = store_read(f))) {
+    replay(p, st);
+    store_delete(st);
+  } else {
+    result = html_parse(p);
+  }
+  (void) scanner_switch(prev);		/* In case we were called recursively */
+  return result;
+}
+
+/* stall -- called by the scanner when it has used up the bytes it was fed */
+static void stall(void *push)
+{
+  longjmp(((struct _push *)push)->stalled, 1);
+}
+
+/* push_tokens -- scan the bytes fed to p and push the tokens into p */
+static void push_tokens(Parser p, const char *buf, size_t len, bool eof)
+{
+  Scanner prev = scanner_switch(p->scanner);
+  HTML_STYPE lval;
+  int token;
+
+  if (scanner_feed(p->scanner, buf, len, eof, stall, p->push)
+      && !setjmp(p->push->stalled))
+    while (p->push->status == YYPUSH_MORE) {
+      token = html_lex(&lval);
+      p->push->status = html_push_parse(p->push->ps, token, &lval, p);
+    }
+  /* Forget buf */
+  (void) scanner_feed(p->scanner, NULL, 0, eof, stall, p->push);
+  (void) scanner_switch(prev);
+}
+
+/* html_parser_feed -- parse the next len bytes of p's input; 0 if OK
+ *
+ * A token that is cut off at the end of buf is scanned again from its
+ * start. To bound that work, the bytes of later calls are only copied
+ * until there are at least as many as that partial token has. The
+ * tokens in them are thus handled by a later call, or by
+ * html_parser_finish(), but the total time stays linear in the input.
+ */
+EXPORT int html_parser_feed(Parser p, const char *buf, size_t len)
+{
+  Arena a;
+
+  if (!p) p = &default_parser;
+  if (!p->push) {				/* The start of a document */
+    html_parser_reset(p);
+    a = arena_use(NULL);
+    new(p->push);
+    (void) arena_use(a);
+    p->push->ps = html_pstate_new();
+    p->push->status = p->push->ps ? YYPUSH_MORE : 2; /* As html_parse() */
+  }
+  if (p->push->status == YYPUSH_MORE) push_tokens(p, buf, len, false);
+  return p->push->status == YYPUSH_MORE ? 0 : p->push->status;
+}
+
+/* html_parser_finish -- parse the rest of the fed input; 0 if OK */
+EXPORT int html_parser_finish(Parser p)
+{
+  int result;
+
+  if (!p) p = &default_parser;
+  if (!p->push) (void) html_parser_feed(p, NULL, 0); /* Empty document */
+  if (p->push->status == YYPUSH_MORE) push_tokens(p, NULL, 0, true);
+  result = p->push->status;
+  end_push(p);
+  return result;
+}
+
+#undef yyparse			/* Not bison's, but the traditional entry */
+
+/* yyparse -- parse yyin with the default parser and the default scanner */
+EXPORT int yyparse(void)
+{
+  return html_parser_run(&default_parser);
+}
@@ -20,7 +20,25 @@ typedef void (*html_handle_endtag_fn)
   (void *clientdata, const string name);
 typedef void (*html_handle_endincl_fn)
   (void *clientdata);
-extern int yyparse(void);
+typedef struct _parser {
+  struct {
+    html_handle_error_fn error;
+    html_handle_start_fn start;
+    html_handle_end_fn end;
+    html_handle_comment_fn comment;
+    html_handle_text_fn text;
+    html_handle_decl_fn decl;
+    html_handle_pi_fn pi;
+    html_handle_starttag_fn starttag;
+    html_handle_emptytag_fn emptytag;
+    html_handle_endtag_fn endtag;
+    html_handle_endincl_fn endincl;
+  } h;
+  void *data;
+  int nrerrors;
+  struct _scanner *scanner;
+  struct _push *push;
+} *Parser;
 extern void set_error_handler(html_handle_error_fn f);
 extern void set_start_handler(html_handle_start_fn f);
 extern void set_end_handler(html_handle_end_fn f);
@@ -33,3 +51,13 @@ extern void set_emptytag_handler(html_handle_emptytag_fn f);
 extern void set_endtag_handler(html_handle_endtag_fn f);
 extern void set_endincl_handler(html_handle_endincl_fn f);
 extern int lineno ;
+extern _Bool 
+           html_continued(void);
+extern Parser html_parser_create(void);
+extern void html_parser_delete(Parser p);
+extern void html_parser_reset(Parser p);
+extern void html_parser_set_input(Parser p, FILE *f, const conststring name);
+extern int html_parser_run(Parser p);
+extern int html_parser_feed(Parser p, const char *buf, size_t len);
+extern int html_parser_finish(Parser p);
+extern int yyparse(void);
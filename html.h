@@ -1,8 +1,9 @@
-/* A Bison parser, made by GNU Bison 3.0.2.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison interface for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2013 Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
@@ -15,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -30,34 +31,63 @@
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
-#ifndef YY_YY_HTML_H_INCLUDED
-# define YY_YY_HTML_H_INCLUDED
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+#ifndef YY_HTML_HTML_H_INCLUDED
+# define YY_HTML_HTML_H_INCLUDED
 /* Debug traces.  */
-#ifndef YYDEBUG
-# define YYDEBUG 0
-#endif
+#ifndef HTML_DEBUG
+# if defined YYDEBUG
 #if YYDEBUG
-extern int yydebug;
+#   define HTML_DEBUG 1
+#  else
+#   define HTML_DEBUG 0
+#  endif
+# else /* ! defined YYDEBUG */
+#  define HTML_DEBUG 0
+# endif /* ! defined YYDEBUG */
+#endif  /* ! defined HTML_DEBUG */
+#if HTML_DEBUG
+extern int html_debug;
 #endif
+/* "%code requires" blocks.  */
+#line 150 "html.y"
+
+struct _parser;
 
-/* Token type.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-  enum yytokentype
+#line 61 "html.h"
+
+/* Token kinds.  */
+#ifndef HTML_TOKENTYPE
+# define HTML_TOKENTYPE
+  enum html_tokentype
   {
-    TEXT = 258,
-    COMMENT = 259,
-    START = 260,
-    END = 261,
-    NAME = 262,
-    STRING = 263,
-    PROCINS = 264,
-    EMPTYEND = 265,
-    DOCTYPE = 266,
-    ENDINCL = 267
+    HTML_EMPTY = -2,
+    HTML_EOF = 0,                  /* "end of file"  */
+    HTML_error = 256,              /* error  */
+    HTML_UNDEF = 257,              /* "invalid token"  */
+    TEXT = 258,                    /* TEXT  */
+    COMMENT = 259,                 /* COMMENT  */
+    START = 260,                   /* START  */
+    END = 261,                     /* END  */
+    NAME = 262,                    /* NAME  */
+    STRING = 263,                  /* STRING  */
+    PROCINS = 264,                 /* PROCINS  */
+    TEXTPART = 265,                /* TEXTPART  */
+    COMMENTPART = 266,             /* COMMENTPART  */
+    EMPTYEND = 267,                /* EMPTYEND  */
+    DOCTYPE = 268,                 /* DOCTYPE  */
+    ENDINCL = 269                  /* ENDINCL  */
   };
+  typedef enum html_tokentype html_token_kind_t;
 #endif
-/* Tokens.  */
+/* Token kinds.  */
+#define HTML_EMPTY -2
+#define HTML_EOF 0
+#define HTML_error 256
+#define HTML_UNDEF 257
 #define TEXT 258
 #define COMMENT 259
 #define START 260
@@ -65,29 +95,46 @@ extern int yydebug;
 #define NAME 262
 #define STRING 263
 #define PROCINS 264
-#define EMPTYEND 265
-#define DOCTYPE 266
-#define ENDINCL 267
+#define TEXTPART 265
+#define COMMENTPART 266
+#define EMPTYEND 267
+#define DOCTYPE 268
+#define ENDINCL 269
 
 /* Value type.  */
-#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE YYSTYPE;
-union YYSTYPE
+#if ! defined HTML_STYPE && ! defined HTML_STYPE_IS_DECLARED
+union HTML_STYPE
 {
-#line 103 "html.y" /* yacc.c:1909  */
+#line 154 "html.y"
 
     string s;
     pairlist p;
 
-#line 83 "html.h" /* yacc.c:1909  */
+#line 114 "html.h"
+
 };
-# define YYSTYPE_IS_TRIVIAL 1
-# define YYSTYPE_IS_DECLARED 1
+typedef union HTML_STYPE HTML_STYPE;
+# define HTML_STYPE_IS_TRIVIAL 1
+# define HTML_STYPE_IS_DECLARED 1
 #endif
 
 
-extern YYSTYPE yylval;
 
-int yyparse (void);
 
-#endif /* !YY_YY_HTML_H_INCLUDED  */
+#ifndef YYPUSH_MORE_DEFINED
+# define YYPUSH_MORE_DEFINED
+enum { YYPUSH_MORE = 4 };
+#endif
+
+typedef struct html_pstate html_pstate;
+
+
+int html_parse (struct _parser *parser);
+int html_push_parse (html_pstate *ps,
+                  int pushed_char, HTML_STYPE const *pushed_val, struct _parser *parser);
+int html_pull_parse (html_pstate *ps, struct _parser *parser);
+html_pstate *html_pstate_new (void);
+void html_pstate_delete (html_pstate *ps);
+
+
+#endif /* !YY_HTML_HTML_H_INCLUDED  */
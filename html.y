@@ -16,8 +16,15 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <setjmp.h>
 #include "export.h"
 #include "types.e"
+#include "heap.e"
+#include "scan.e"
+#include "tree.e"
+#include "store.e"
 
 /* The types of the various callback routines */
 
@@ -44,116 +51,381 @@ EXPORT typedef void (*html_handle_endtag_fn)
 EXPORT typedef void (*html_handle_endincl_fn)
   (void *clientdata);
 
-/* yyparse -- entry point for the parser */
-EXPORT extern int yyparse(void);
-
-/* Store client data */
-static void *data;
-
-/* All callback routines */
-static struct {
-  html_handle_error_fn error;
-  html_handle_start_fn start;
-  html_handle_end_fn end;
-  html_handle_comment_fn comment;
-  html_handle_text_fn text;
-  html_handle_decl_fn decl;
-  html_handle_pi_fn pi;
-  html_handle_starttag_fn starttag;
-  html_handle_emptytag_fn emptytag;
-  html_handle_endtag_fn endtag;
-  html_handle_endincl_fn endincl;
-} h = {NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL};
+/* A parser has its own callback routines, client data and scanner.
+   Several parsers can be used in one thread, interleaved or nested
+   (e.g., one started from a callback of another), but not in several
+   threads at once. The scanner is flex's non-reentrant one (see
+   Scanner in scan.l), and the tree (tree.c), the atom table (atom.c)
+   and the selector matcher (selmatch.c) are global to the process. To
+   use several cores, use several processes, as batch.c does. */
+EXPORT typedef struct _parser {
+  struct {
+    html_handle_error_fn error;
+    html_handle_start_fn start;
+    html_handle_end_fn end;
+    html_handle_comment_fn comment;
+    html_handle_text_fn text;
+    html_handle_decl_fn decl;
+    html_handle_pi_fn pi;
+    html_handle_starttag_fn starttag;
+    html_handle_emptytag_fn emptytag;
+    html_handle_endtag_fn endtag;
+    html_handle_endincl_fn endincl;
+  } h;				/* All callback routines */
+  void *data;			/* Client data, returned by h.start */
+  int nrerrors;			/* Number of errors so far */
+  struct _scanner *scanner;	/* NULL means the default scanner */
+  struct _push *push;		/* State of html_parser_feed(), or NULL */
+} *Parser;
+
+/* The parser used by yyparse() and the set_*_handler() routines */
+static struct _parser default_parser = {
+  {NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL},
+  NULL, 0, NULL, NULL};
 
 /* Routines to bind concrete routines to the callbacks */
-EXPORT void set_error_handler(html_handle_error_fn f) {h.error = f;}
-EXPORT void set_start_handler(html_handle_start_fn f) {h.start = f;}
-EXPORT void set_end_handler(html_handle_end_fn f) {h.end = f;}
-EXPORT void set_comment_handler(html_handle_comment_fn f) {h.comment = f;}
-EXPORT void set_text_handler(html_handle_text_fn f) {h.text = f;}
-EXPORT void set_decl_handler(html_handle_decl_fn f) {h.decl = f;}
-EXPORT void set_pi_handler(html_handle_pi_fn f) {h.pi = f;}
-EXPORT void set_starttag_handler(html_handle_starttag_fn f){h.starttag = f;}
-EXPORT void set_emptytag_handler(html_handle_emptytag_fn f){h.emptytag = f;}
-EXPORT void set_endtag_handler(html_handle_endtag_fn f) {h.endtag = f;}
-EXPORT void set_endincl_handler(html_handle_endincl_fn f) {h.endincl = f;}
-
-extern int yylex(void);
-EXPORT int lineno = 1;		/* Line number in input file */
-
-static int nrerrors = 0;
+EXPORT void set_error_handler(html_handle_error_fn f)
+{default_parser.h.error = f;}
+EXPORT void set_start_handler(html_handle_start_fn f)
+{default_parser.h.start = f;}
+EXPORT void set_end_handler(html_handle_end_fn f)
+{default_parser.h.end = f;}
+EXPORT void set_comment_handler(html_handle_comment_fn f)
+{default_parser.h.comment = f;}
+EXPORT void set_text_handler(html_handle_text_fn f)
+{default_parser.h.text = f;}
+EXPORT void set_decl_handler(html_handle_decl_fn f)
+{default_parser.h.decl = f;}
+EXPORT void set_pi_handler(html_handle_pi_fn f)
+{default_parser.h.pi = f;}
+EXPORT void set_starttag_handler(html_handle_starttag_fn f)
+{default_parser.h.starttag = f;}
+EXPORT void set_emptytag_handler(html_handle_emptytag_fn f)
+{default_parser.h.emptytag = f;}
+EXPORT void set_endtag_handler(html_handle_endtag_fn f)
+{default_parser.h.endtag = f;}
+EXPORT void set_endincl_handler(html_handle_endincl_fn f)
+{default_parser.h.endincl = f;}
+
+static bool continued = false;	/* Next text/comment callback continues */
+
+/* lineno -- scan_lineno() when the last callback was called
+ *
+ * For programs that read this variable from their callbacks. It is set
+ * only before a callback, so new code should call scan_lineno().
+ */
+EXPORT int lineno = 1;
+
+/* html_continued -- true while a text or comment callback gets a part */
+EXPORT bool html_continued(void)
+{
+  return continued;		/* See set_chunk_size() */
+}
+
 #define MAX_ERRORS_REPORTED 20
 
 /* yyerror -- report parse error */ 
-static void yyerror(const string s)
+static void yyerror(Parser parser, const char *s)
 {
-  nrerrors++;
-  if (nrerrors < MAX_ERRORS_REPORTED)
-    h.error(data, s, lineno);
-  else if (nrerrors == MAX_ERRORS_REPORTED)
-    h.error(data, "too many errors", lineno);
+  parser->nrerrors++;
+  lineno = scan_lineno();
+  if (parser->nrerrors < MAX_ERRORS_REPORTED)
+    parser->h.error(parser->data, (string)s, lineno);
+  else if (parser->nrerrors == MAX_ERRORS_REPORTED)
+    parser->h.error(parser->data, "too many errors", lineno);
   else
     ; /* don't report any more errors */
 }
 
 /* call -- if the function exists, call it with the given aguments */
-#define call(fn, args) do {if (fn) (fn)args;} while (0)
+#define call(fn, args) \
+  do {if (parser->h.fn) {lineno = scan_lineno(); (parser->h.fn)args;}} while (0)
 %}
 
+%define api.pure full
+%define api.push-pull both
+%define api.prefix {html_}
+%parse-param {struct _parser *parser}
+
+%code requires {
+struct _parser;
+}
+
 %union {
     string s;
     pairlist p;
 }
 
-%token <s> TEXT COMMENT START END NAME STRING PROCINS
+%token <s> TEXT COMMENT START END NAME STRING PROCINS TEXTPART COMMENTPART
 %token EMPTYEND DOCTYPE ENDINCL
 
+%code {
+extern int html_lex(HTML_STYPE *lvalp);
+}
+
 %type <p> attribute attributes
 
 %%
 
 start
-:					{data = h.start ? h.start() : NULL;}
-    document				{call(h.end, (data));}
+:					{parser->data = parser->h.start ? parser->h.start() : NULL;}
+    document				{call(end, (parser->data));}
   ;
 document
-  : document COMMENT			{call(h.comment, (data, $2));}
-  | document TEXT			{call(h.text, (data, $2));}
+  : document COMMENT			{call(comment, (parser->data, $2));}
+  | document TEXT			{call(text, (parser->data, $2));}
+  | document COMMENTPART		{continued = true;
+					 call(comment, (parser->data, $2));
+					 continued = false;}
+  | document TEXTPART			{continued = true;
+					 call(text, (parser->data, $2));
+					 continued = false;}
   | document starttag
   | document endtag
   | document decl
-  | document PROCINS			{call(h.pi, (data, $2));}
-  | document ENDINCL			{call(h.endincl, (data));}
+  | document PROCINS			{call(pi, (parser->data, $2));}
+  | document ENDINCL			{call(endincl, (parser->data));}
   | document error
   | /* empty */
   ;
 starttag
-  : START attributes '>'		{call(h.starttag, (data, $1, $2));}
-  | START attributes EMPTYEND		{call(h.emptytag, (data, $1, $2));}
+  : START attributes '>'		{call(starttag, (parser->data, $1, $2));}
+  | START attributes EMPTYEND		{call(emptytag, (parser->data, $1, $2));}
   ;
 attributes
   : attribute attributes		{$$ = $1; $$->next = $2;}
   | /* empty */				{$$ = NULL;}
   ;
 attribute
-  : NAME				{pairlist h = malloc(sizeof(*h));
-					 assert(h != NULL); h->name = $1;
+  : NAME				{pairlist h; new(h); h->name = $1;
 					 h->value=NULL; $$ = h;}
-  | NAME '=' NAME			{pairlist h = malloc(sizeof(*h));
-					 assert(h != NULL); h->name = $1;
+  | NAME '=' NAME			{pairlist h; new(h); h->name = $1;
 					 h->value = $3; $$ = h;}
-  | NAME '=' STRING			{pairlist h = malloc(sizeof(*h));
-					 assert(h != NULL); h->name = $1;
+  | NAME '=' STRING			{pairlist h; new(h); h->name = $1;
 					 h->value = $3; $$ = h;}
   ;
 endtag
-  : END '>'				{call(h.endtag, (data, $1));}
+  : END '>'				{call(endtag, (parser->data, $1));}
   ;
 decl
-  : DOCTYPE NAME NAME STRING STRING '>'	{call(h.decl, (data, $2, $4, $5));}
+  : DOCTYPE NAME NAME STRING STRING '>'	{call(decl, (parser->data, $2, $4, $5));}
   | DOCTYPE NAME NAME STRING '>'	{if (strcasecmp($3, "public") == 0)
-				     	   call(h.decl, (data, $2, $4, NULL));
+				     	   call(decl, (parser->data, $2, $4, NULL));
 					 else /* "system" */
-					   call(h.decl, (data, $2, NULL, $4));}
-  | DOCTYPE NAME '>'			{call(h.decl, (data, $2, NULL, NULL));}
+					   call(decl, (parser->data, $2, NULL, $4));}
+  | DOCTYPE NAME '>'			{call(decl, (parser->data, $2, NULL, NULL));}
   ;
+
+%%
+
+/* A parser that is fed bytes, instead of reading a file, pushes the
+   tokens into bison's push parser as the scanner finds them. When the
+   scanner has used up the bytes, it calls stall(), which jumps back to
+   push_tokens(), to wait for the next html_parser_feed(). */
+struct _push {
+  html_pstate *ps;		/* Bison's parser state */
+  int status;			/* YYPUSH_MORE or the result of the parse */
+  jmp_buf stalled;		/* Where push_tokens() waits for bytes */
+};
+
+/* end_push -- free p's push parser state, if any */
+static void end_push(Parser p)
+{
+  if (p->push) {
+    html_pstate_delete(p->push->ps);
+    dispose(p->push);
+  }
+}
+
+/* html_parser_create -- create a parser with its own scanner */
+EXPORT Parser html_parser_create(void)
+{
+  Arena a = arena_use(NULL);	/* A parser may outlive a document's arena */
+  Parser p;
+
+  new(p);
+  memset(&p->h, 0, sizeof(p->h));
+  p->data = NULL;
+  p->nrerrors = 0;
+  p->scanner = scanner_create();
+  p->push = NULL;
+  (void) arena_use(a);
+  return p;
+}
+
+/* html_parser_delete -- free a parser, its scanner and its open buffers */
+EXPORT void html_parser_delete(Parser p)
+{
+  end_push(p);
+  scanner_delete(p->scanner);
+  dispose(p);
+}
+
+/* html_parser_reset -- reset p (NULL = default parser) for a new document */
+EXPORT void html_parser_reset(Parser p)
+{
+  if (!p) p = &default_parser;
+  end_push(p);
+  p->data = NULL;
+  p->nrerrors = 0;
+  lineno = 1;
+  scanner_reset(p->scanner);
+}
+
+/* html_parser_set_input -- set the file that p will parse and its name */
+EXPORT void html_parser_set_input(Parser p, FILE *f, const conststring name)
+{
+  scanner_set_input(p->scanner, f, name);
+}
+
+/* copy_attribs -- return a copy of the attributes of element n of st */
+static pairlist copy_attribs(const Store st, NodeId n)
+{
+  pairlist attribs, *tail = &attribs;
+  conststring v;
+  uint32_t a;
+
+  for (a = store_attribs(st, n); a; a = store_attr_next(st, a)) {
+    new(*tail);
+    (*tail)->name = newstring(store_attr_name(st, a));
+    (*tail)->value = (v = store_attr_value(st, a)) ? newstring(v) : NULL;
+    tail = &(*tail)->next;
+  }
+  *tail = NULL;
+  return attribs;
+}
+
+/* replay -- call the parser's callbacks for the nodes of a snapshot */
+static void replay(Parser parser, const Store st)
+{
+  NodeId n, open = store_root(st), last = store_count(st);
+  conststring fpi, url;
+
+  /* The callbacks get their own copies of the strings, as when parsing */
+  parser->data = parser->h.start ? parser->h.start() : NULL;
+  for (n = store_root(st) + 1; n <= last; n++) {
+    for (; open != store_parent(st, n); open = store_parent(st, open))
+      call(endtag, (parser->data, newstring(store_name(st, open))));
+    switch (store_type(st, n)) {
+    case Element:
+      if (store_is_empty(st, n)) {
+	call(emptytag, (parser->data, newstring(store_name(st, n)),
+			copy_attribs(st, n)));
+      } else {
+	call(starttag, (parser->data, newstring(store_name(st, n)),
+			copy_attribs(st, n)));
+	open = n;
+      }
+      break;
+    case Text:
+      call(text, (parser->data, newstring(store_text(st, n))));
+      break;
+    case Comment:
+      call(comment, (parser->data, newstring(store_text(st, n))));
+      break;
+    case Procins:
+      call(pi, (parser->data, newstring(store_text(st, n))));
+      break;
+    case Declaration:
+      fpi = store_text(st, n);
+      url = store_url(st, n);
+      call(decl, (parser->data, newstring(store_name(st, n)),
+		  fpi ? newstring(fpi) : NULL, url ? newstring(url) : NULL));
+      break;
+    default:
+      assert(!"Cannot happen");
+    }
+  }
+  for (; open != store_root(st); open = store_parent(st, open))
+    call(endtag, (parser->data, newstring(store_name(st, open))));
+  call(end, (parser->data));
+}
+
+/* html_parser_run -- parse p's input, calling p's callbacks; 0 if OK */
+EXPORT int html_parser_run(Parser p)
+{
+  Scanner prev = scanner_switch(p->scanner);
+  int result = 0;
+  Store st;
+  FILE *f;
+
+  /* A snapshot written by a tool with -S needs no parsing, only replay */
+  if ((f = unread_input()) && (st = store_read(f))) {
+    replay(p, st);
+    store_delete(st);
+  } else {
+    result = html_parse(p);
+  }
+  (void) scanner_switch(prev);		/* In case we were called recursively */
+  return result;
+}
+
+/* stall -- called by the scanner when it has used up the bytes it was fed */
+static void stall(void *push)
+{
+  longjmp(((struct _push *)push)->stalled, 1);
+}
+
+/* push_tokens -- scan the bytes fed to p and push the tokens into p */
+static void push_tokens(Parser p, const char *buf, size_t len, bool eof)
+{
+  Scanner prev = scanner_switch(p->scanner);
+  HTML_STYPE lval;
+  int token;
+
+  if (scanner_feed(p->scanner, buf, len, eof, stall, p->push)
+      && !setjmp(p->push->stalled))
+    while (p->push->status == YYPUSH_MORE) {
+      token = html_lex(&lval);
+      p->push->status = html_push_parse(p->push->ps, token, &lval, p);
+    }
+  /* Forget buf */
+  (void) scanner_feed(p->scanner, NULL, 0, eof, stall, p->push);
+  (void) scanner_switch(prev);
+}
+
+/* html_parser_feed -- parse the next len bytes of p's input; 0 if OK
+ *
+ * A token that is cut off at the end of buf is scanned again from its
+ * start. To bound that work, the bytes of later calls are only copied
+ * until there are at least as many as that partial token has. The
+ * tokens in them are thus handled by a later call, or by
+ * html_parser_finish(), but the total time stays linear in the input.
+ */
+EXPORT int html_parser_feed(Parser p, const char *buf, size_t len)
+{
+  Arena a;
+
+  if (!p) p = &default_parser;
+  if (!p->push) {				/* The start of a document */
+    html_parser_reset(p);
+    a = arena_use(NULL);
+    new(p->push);
+    (void) arena_use(a);
+    p->push->ps = html_pstate_new();
+    p->push->status = p->push->ps ? YYPUSH_MORE : 2; /* As html_parse() */
+  }
+  if (p->push->status == YYPUSH_MORE) push_tokens(p, buf, len, false);
+  return p->push->status == YYPUSH_MORE ? 0 : p->push->status;
+}
+
+/* html_parser_finish -- parse the rest of the fed input; 0 if OK */
+EXPORT int html_parser_finish(Parser p)
+{
+  int result;
+
+  if (!p) p = &default_parser;
+  if (!p->push) (void) html_parser_feed(p, NULL, 0); /* Empty document */
+  if (p->push->status == YYPUSH_MORE) push_tokens(p, NULL, 0, true);
+  result = p->push->status;
+  end_push(p);
+  return result;
+}
+
+#undef yyparse			/* Not bison's, but the traditional entry */
+
+/* yyparse -- parse yyin with the default parser and the default scanner */
+EXPORT int yyparse(void)
+{
+  return html_parser_run(&default_parser);
+}
@@ -42,6 +42,7 @@
 #include "errexit.e"
 #include "genid.e"
 #include "class.e"
+#include "batch.e"
 
 static Tree tree;
 static bool xml = false;			/* Use <empty /> convention */
@@ -152,7 +153,7 @@ static void expand(Tree t)
 	  printf(" %s", a->name);
 	  if (a->value != NULL) printf("=\"%s\"", a->value);
 	}
-	if (is_empty(h->name)) {
+	if (elt_flags(h) & ELT_EMPTY) {
 	  printf(xml ? " />" : ">");
 	} else {
 	  printf(">");
@@ -166,11 +167,22 @@ static void expand(Tree t)
   }
 }
 
+/* process -- parse one document and print it with ID's, return status */
+static int process(void)
+{
+  if (yyparse() != 0) return 3;
+  tree = get_root(tree);
+  expand(tree);
+  reset_ids();
+  return 0;
+}
+
 /* usage -- print usage message and exit */
 static void usage(string name)
 {
-  errexit("Usage: %s [-x] [-v] [--] elem|.class|elem.class [html-file]\n",
-	  name);
+  errexit("Usage: %s [-x] [-v] [--] elem|.class|elem.class [html-file]\n\
+       %s -B [-j jobs] [-x] [--] elem|.class|elem.class [input output...]\n",
+	  name, name);
 }
 
 
@@ -178,6 +190,9 @@ int main(int argc, char *argv[])
 {
   char *p;
   int i, status = 200;
+  bool batch_mode = false;
+  int jobs = 1;
+  Arena arena;
 
   /* Bind the parser callback routines to our handlers */
   set_error_handler(handle_error);
@@ -195,6 +210,8 @@ int main(int argc, char *argv[])
   for (i = 1; i < argc && argv[i][0] == '-' && !eq(argv[i], "--"); i++) {
     switch (argv[i][1]) {
       case 'x': xml = true; break;
+      case 'B': batch_mode = true; break;
+      case 'j': if (++i == argc) usage(argv[0]); jobs = atoi(argv[i]); break;
       case 'v': printf("Version: %s %s\n", PACKAGE, VERSION); return 0;
       default: usage(argv[0]);
     }
@@ -212,6 +229,8 @@ int main(int argc, char *argv[])
     }
   }
   i++;
+  if (batch_mode) return batch(argc, argv, i, jobs, process);
+
   if (i == argc) yyin = stdin;
   else if (i == argc - 1 && eq(argv[i], "-")) yyin = stdin;
   else if (i == argc - 1) yyin = fopenurl(argv[i], "r", &status);
@@ -220,10 +239,9 @@ int main(int argc, char *argv[])
   if (yyin == NULL) {perror(argv[i]); exit(1);}
   if (status != 200) errexit("%s : %s\n", argv[i], http_strerror(status));
 
-  if (yyparse() != 0) exit(3);
-
-  tree = get_root(tree);
-  expand(tree);
-  tree_delete(tree);				/* Just to test memory mgmt */
+  arena = arena_new();				/* Holds the whole document */
+  (void) arena_use(arena);
+  if (process() != 0) exit(3);
+  arena_delete(arena);				/* Frees the tree in one go */
   return 0;
 }
@@ -12,6 +12,8 @@
 #include "config.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
 #include "export.h"
 #include "types.e"
 #include "tree.e"
@@ -85,6 +87,8 @@ void handle_endtag(void *clientdata, string name)
 
 int main(int argc, char *argv[])
 {
+  bool snapshot = false;
+
   /* Bind the parser callback routines to our handlers */
   set_error_handler(handle_error);
   set_start_handler(start);
@@ -97,6 +101,11 @@ int main(int argc, char *argv[])
   set_emptytag_handler(handle_emptytag);
   set_endtag_handler(handle_endtag);
 
+  if (argc > 1 && strcmp(argv[1], "-S") == 0) {
+    snapshot = true;
+    argv[1] = argv[0];			/* Drop the option */
+    argc--; argv++;
+  }
   if (argc == 1) {
     yyin = stdin;
   } else if (argc == 2) {
@@ -107,14 +116,19 @@ int main(int argc, char *argv[])
     }
   } else {
     fprintf(stderr, "Version %s\n", VERSION);
-    fprintf(stderr, "Usage: %s [html-file]\n", argv[0]);
+    fprintf(stderr, "Usage: %s [-S] [html-file]\n", argv[0]);
     exit(1);
   }
   if (yyparse() != 0) {
     exit(3);
   }
   tree = get_root(tree);
-  dumptree(tree, stdout);
+  if (!snapshot) {
+    dumptree(tree, stdout);
+  } else if (!write_snapshot(tree, stdout)) {
+    perror("stdout");
+    exit(2);
+  }
   return 0;
   
 }
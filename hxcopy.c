@@ -42,11 +42,12 @@
 #include "dict.e"
 #include "openurl.e"
 #include "errexit.e"
+#include "outbuf.e"
 
 #define same(a, b) ((a) ? ((b) && eq((a), (b))) : !(b))
 
 static bool has_errors = false;		/* Enconutered errors during parsing */
-static FILE *out = NULL;		/* Where to write output */
+static Outbuf out;			/* Where to write output */
 static bool has_base = false;		/* Document has a <BASE> element */
 static string newbase;			/* Path from OLDURL to NEWURL */
 static bool replace_self = false;	/* Change link to self in link to old */
@@ -140,14 +141,14 @@ void end(void *clientdata)
 /* handle_comment -- called after a comment is parsed */
 void handle_comment(void *clientdata, string commenttext)
 {
-  fprintf(out, "<!--%s-->", commenttext);
+  outbuf_wrap(out, "<!--", commenttext, "-->");
 }
 
 
 /* handle_text -- called after a text chunk is parsed */
 void handle_text(void *clientdata, string text)
 {
-  fprintf(out, "%s", text);
+  outbuf_puts(out, text);
 }
 
 
@@ -155,17 +156,17 @@ void handle_text(void *clientdata, string text)
 void handle_decl(void *clientdata, string gi,
 		 string fpi, string url)
 {
-  fprintf(out, "<!DOCTYPE %s", gi);
-  if (fpi) fprintf(out, " PUBLIC \"%s\"", fpi);
-  if (url) fprintf(out, " %s\"%s\"", fpi ? "" : "SYSTEM ", url);
-  fprintf(out, ">");
+  outbuf_wrap(out, "<!DOCTYPE ", gi, "");
+  if (fpi) outbuf_wrap(out, " PUBLIC \"", fpi, "\"");
+  if (url) outbuf_printf(out, " %s\"%s\"", fpi ? "" : "SYSTEM ", url);
+  outbuf_puts(out, ">");
 }
 
 
 /* handle_pi -- called after a PI is parsed */
 void handle_pi(void *clientdata, string pi_text)
 {
-  fprintf(out, "<?%s>", pi_text);
+  outbuf_wrap(out, "<?", pi_text, ">");
 }
 
 
@@ -175,17 +176,17 @@ void handle_starttag(void *clientdata, string name, pairlist attribs)
   conststring v;
   pairlist p;
 
-  fprintf(out, "<%s", name);
+  outbuf_wrap(out, "<", name, "");
   for (p = attribs; p; p = p->next) {
-    fprintf(out, " %s", p->name);
+    outbuf_wrap(out, " ", p->name, "");
     if (!p->value) v = NULL;
     else if (has_base) v = newstring(p->value);	/* No need to adjust */
     else if (attribute_is_url(p->name)) v = adjust_url(p->value);
     else v = newstring(p->value);		/* No need to adjust */
-    if (v) fprintf(out, "=\"%s\"", v);
+    if (v) outbuf_wrap(out, "=\"", v, "\"");
     dispose(v);
   }
-  fprintf(out, ">");
+  outbuf_puts(out, ">");
 
   /* If this is a <BASE> tag, no further adjustments are needed */
   if (strcasecmp(name, "base") == 0) has_base = true;
@@ -198,17 +199,17 @@ void handle_emptytag(void *clientdata, string name, pairlist attribs)
   conststring v;
   pairlist p;
 
-  fprintf(out, "<%s", name);
+  outbuf_wrap(out, "<", name, "");
   for (p = attribs; p; p = p->next) {
-    fprintf(out, " %s", p->name);
+    outbuf_wrap(out, " ", p->name, "");
     if (!p->value) v = NULL;
     else if (has_base) v = newstring(p->value);	/* No need to adjust */
     else if (attribute_is_url(p->name)) v = adjust_url(p->value);
     else v = newstring(p->value);		/* No need to adjust */
-    if (v) fprintf(out, "=\"%s\"", v);
+    if (v) outbuf_wrap(out, "=\"", v, "\"");
     dispose(v);
   }
-  fprintf(out, " />");
+  outbuf_puts(out, " />");
 
   /* If this is a <BASE> tag, no further adjustments are needed */
   if (strcasecmp(name, "base") == 0) has_base = true;
@@ -218,7 +219,7 @@ void handle_emptytag(void *clientdata, string name, pairlist attribs)
 /* handle_endtag -- called after an endtag is parsed (name may be "") */
 void handle_endtag(void *clientdata, string name)
 {
-  fprintf(out, "</%s>", name);
+  outbuf_wrap(out, "</", name, ">");
 }
 
 
@@ -234,6 +235,7 @@ int main(int argc, char *argv[])
 {
   int c, status = 200;
   string oldurl = NULL, newurl = NULL;
+  FILE *f = NULL;
 
   /* Bind the parser callback routines to our handlers */
   set_error_handler(handle_error);
@@ -257,10 +259,11 @@ int main(int argc, char *argv[])
     default: usage(argv[0]);
     }
   if (argc > optind + 2) usage(argv[0]);
-  if (argc > optind + 1) out =  fopenurl(argv[optind+1], "w", NULL);
-  else if (newurl) out = stdout;
+  if (argc > optind + 1) f = fopenurl(argv[optind+1], "w", NULL);
+  else if (newurl) f = stdout;
   else errexit("%s: option -o is required if output is to stdout\n", argv[0]);
-  if (!out) {perror(argv[optind+1]); exit(3);}
+  if (!f) {perror(argv[optind+1]); exit(3);}
+  out = outbuf_new(f);
   if (argc > optind) yyin = fopenurl(argv[optind], "r", &status);
   else if (oldurl) yyin = stdin;
   else errexit("%s: option -i is required if input is from stdin\n", argv[0]);
@@ -271,5 +274,6 @@ int main(int argc, char *argv[])
   newbase = path_from_url_to_url(newurl, oldurl);
   if (!newbase) errexit("%s: could not parse argument as a URL\n", argv[0]);
   if (yyparse() != 0) exit(4);
+  if (!outbuf_delete(out)) {perror(f == stdout ? "stdout" : argv[optind+1]); exit(3);}
   return has_errors ? 1 : 0;
 }
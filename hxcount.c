@@ -156,7 +156,8 @@ int main(int argc, char *argv[])
   if (yyin == NULL) {perror(argv[1]); exit(1);}
   if (status != 200) errexit("%s : %s\n", argv[1], http_strerror(status));
 
-  /* Parse input */
+  /* Parse input, only the tags are needed */
+  set_event_mask(0);
   if (yyparse() != 0) exit(3);
 
   /* Print results */
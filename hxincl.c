@@ -52,10 +52,12 @@
 #include "openurl.e"
 #include "heap.e"
 #include "url.e"
+#include "outbuf.e"
 
 #define INCLUDE "include"
 #define BEGIN "begin-include"
 #define END "end-include"
+#define CHUNK 65536		/* Pass longer texts and comments in parts */
 
 typedef struct _stack {
   bool skipping;
@@ -71,6 +73,8 @@ static stack skipping = NULL;
 static Dictionary substitutions = NULL;
 static string target = NULL;
 static bool warn_missing = true;
+static bool in_comment = false;	/* Inside a comment that comes in parts */
+static Outbuf out;
 
 
 /* push -- push a skipping state on the stack */
@@ -191,6 +195,16 @@ void handle_comment(void *clientdata, string commenttext)
   FILE *f;
   Key key;
 
+  /* A comment that is passed in parts is too long to be a directive */
+  if (in_comment || html_continued()) {
+    if (!top(skipping) && !target)
+      outbuf_wrap(out, in_comment ? "" : "<!--", commenttext,
+		  html_continued() ? "" : "-->");
+    in_comment = html_continued();
+    free(commenttext);
+    return;
+  }
+
   i = strspn(commenttext, " \t\n\r\f");		/* Skip whitespace */
   j = strcspn(commenttext + i, " \t\n\r\f");	/* First word */
   key = word_to_key(commenttext + i, j);
@@ -208,7 +222,7 @@ void handle_comment(void *clientdata, string commenttext)
   } else if (key == KNone) {			/* Unrecognized comment? */
 
     /* Print the comment verbatim */
-    if (!target) printf("<!--%s-->", commenttext);
+    if (!target) outbuf_wrap(out, "<!--", commenttext, "-->");
 
   } else {					/* include or begin-include */
 
@@ -240,14 +254,15 @@ void handle_comment(void *clientdata, string commenttext)
     /* Get the file and recursively parse it */
     assert(get_yyin_name());
     s = URL_s_absolutize(get_yyin_name(), url);
-    if (target) printf(" \\\n %s", s); /* To do: escape spaces in s */
+    if (target) outbuf_wrap(out, " \\\n ", s, ""); /* To do: escape spaces */
     if (!(f = fopenurl(s, "r", &status))) {
       if (!target || warn_missing) perror(url);
     } else if (status != 200) {
       if (!target || warn_missing)
 	fprintf(stderr, "%s : %s\n", url, http_strerror(status));
     } else {
-      if (!final && !target) printf("<!--%s %s-->", BEGIN, commenttext + i);
+      if (!final && !target)
+	outbuf_printf(out, "<!--%s %s-->", BEGIN, commenttext + i);
       push(&skipping, false);
       include_file(f, s);
     }
@@ -261,7 +276,7 @@ void handle_comment(void *clientdata, string commenttext)
 /* handle_text -- called after a text chunk is parsed */
 void handle_text(void *clientdata, string text)
 {
-  if (top(skipping) == false && !target) printf("%s", text);
+  if (top(skipping) == false && !target) outbuf_puts(out, text);
   free(text);
 }
 
@@ -269,10 +284,10 @@ void handle_text(void *clientdata, string text)
 void handle_decl(void *clientdata, string gi, string fpi, string url)
 {
   if (!target) {
-    printf("<!DOCTYPE %s", gi);
-    if (fpi) printf(" PUBLIC \"%s\"", fpi);
-    if (url) printf(" %s\"%s\"", fpi ? "" : "SYSTEM ", url);
-    printf(">");
+    outbuf_wrap(out, "<!DOCTYPE ", gi, "");
+    if (fpi) outbuf_wrap(out, " PUBLIC \"", fpi, "\"");
+    if (url) outbuf_printf(out, " %s\"%s\"", fpi ? "" : "SYSTEM ", url);
+    outbuf_puts(out, ">");
   }
   free(gi);
   free(fpi);
@@ -282,7 +297,7 @@ void handle_decl(void *clientdata, string gi, string fpi, string url)
 /* handle_pi -- called after a PI is parsed */
 void handle_pi(void *clientdata, string pi_text)
 {
-  if (top(skipping) == false && !target) printf("<?%s>", pi_text);
+  if (top(skipping) == false && !target) outbuf_wrap(out, "<?", pi_text, ">");
   free(pi_text);
 }
 
@@ -292,13 +307,13 @@ void handle_starttag(void *clientdata, string name, pairlist attribs)
   pairlist p;
 
   if (top(skipping) == false && !target) {
-    printf("<%s", name);
+    outbuf_wrap(out, "<", name, "");
     for (p = attribs; p; p = p->next) {
-      if (p->value != NULL) printf(" %s=\"%s\"", p->name, p->value);
-      else if (do_xml) printf(" %s=\"%s\"", p->name, p->name);
-      else printf(" %s", p->name);
+      outbuf_wrap(out, " ", p->name, "");
+      if (p->value != NULL) outbuf_wrap(out, "=\"", p->value, "\"");
+      else if (do_xml) outbuf_wrap(out, "=\"", p->name, "\"");
     }
-    printf(">");
+    outbuf_puts(out, ">");
   }
   free(name);
   pairlist_delete(attribs);
@@ -310,13 +325,13 @@ void handle_emptytag(void *clientdata, string name, pairlist attribs)
   pairlist p;
 
   if (top(skipping) == false && !target) {
-    printf("<%s", name);
+    outbuf_wrap(out, "<", name, "");
     for (p = attribs; p; p = p->next) {
-      if (p->value != NULL) printf(" %s=\"%s\"", p->name, p->value);
-      else if (do_xml) printf(" %s=\"%s\"", p->name, p->name);
-      else printf(" %s", p->name);
+      outbuf_wrap(out, " ", p->name, "");
+      if (p->value != NULL) outbuf_wrap(out, "=\"", p->value, "\"");
+      else if (do_xml) outbuf_wrap(out, "=\"", p->name, "\"");
     }
-    printf(do_xml ? " />" : ">");
+    outbuf_puts(out, do_xml ? " />" : ">");
   }
   free(name);
   pairlist_delete(attribs);
@@ -325,7 +340,7 @@ void handle_emptytag(void *clientdata, string name, pairlist attribs)
 /* handle_endtag -- called after an endtag is parsed (name may be "") */
 void handle_endtag(void *clientdata, string name)
 {
-  if (top(skipping) == false && !target) printf("</%s>", name);
+  if (top(skipping) == false && !target) outbuf_wrap(out, "</", name, ">");
   free(name);
 }
 
@@ -335,7 +350,7 @@ void handle_endincl(void *clientdata)
   pop(&skipping);
 
   /* Mark the end of the inclusion */
-  if (!final && !target) printf("<!--%s-->", END);
+  if (!final && !target) outbuf_wrap(out, "<!--", END, "-->");
 }
 
 /* --------------------------------------------------------------------- */
@@ -390,9 +405,12 @@ int main(int argc, char *argv[])
   if (yyin == NULL) {perror(argv[optind]); exit(1);}
   if (status != 200) errexit("%s : %s\n", argv[optind], http_strerror(status));
 
-  if (target) printf("%s:", target);
+  out = outbuf_stdout();
+  set_chunk_size(CHUNK);
+  if (target) outbuf_wrap(out, "", target, ":");
   if (yyparse() != 0) exit(3);
-  if (target) printf("\n");
+  if (target) outbuf_putc(out, '\n');
+  if (!outbuf_flush(out)) {perror("stdout"); exit(2);}
 
   return has_error ? 1 : 0;
 }
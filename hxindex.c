@@ -516,15 +516,15 @@ static void expand(Tree t, bool *write, Indexterm terms)
 	      printf(" %s", a->name);
 	      if (a->value != NULL) printf("=\"%s\"", a->value);
 	    }
-	    assert(! is_empty(h->name) || h->children == NULL);
-	    printf(xml && is_empty(h->name) ? " />" : ">");
+	    assert(!(elt_flags(h) & ELT_EMPTY) || h->children == NULL);
+	    printf(xml && (elt_flags(h) & ELT_EMPTY) ? " />" : ">");
 	    /* Insert an <A NAME> if element has an ID and is not <A> */
-	    if (bctarget && is_mixed(h->name) && (val = get_attrib(h, "id"))
-		&& !eq(h->name, "a") && ! xml)
+	    if (bctarget && (elt_flags(h) & ELT_MIXED)
+		&& (val = get_attrib(h, "id")) && !eq(h->name, "a") && ! xml)
 	      printf("<a class=\"%s\" name=\"%s\"></a>", TARGET, val);
 	  }
 	  expand(h, write, terms);
-	  if (do_tag && ! is_empty(h->name)) printf("</%s>", h->name);
+	  if (do_tag && !(elt_flags(h) & ELT_EMPTY)) printf("</%s>", h->name);
 	}
 	break;
       case Root:
@@ -586,8 +586,8 @@ static void copy_contents(Tree t, string *s)
 	    if (! a->value) strapp(s, " ", a->name, NULL);
 	    else strapp(s, " ", a->name, "=\"", a->value, "\"", NULL);
 	  }
-	  assert(! is_empty(h->name) || h->children == NULL);
-	  if (is_empty(h->name)) {
+	  assert(!(elt_flags(h) & ELT_EMPTY) || h->children == NULL);
+	  if (elt_flags(h) & ELT_EMPTY) {
 	    strapp(s, xml ? " />" : ">", NULL);
 	  } else {
 	    strapp(s, ">", NULL);
@@ -64,6 +64,13 @@ static string base = NULL;			/* URL of each file */
 static string endtext = "";			/* Text to insert at end */
 
 
+/* set_copying -- start or stop copying, text is only needed while copying */
+static void set_copying(bool on)
+{
+  copying = on;
+  set_event_mask(on ? EVENT_TEXT | EVENT_VALUE : EVENT_VALUE);
+}
+
 /* handle_error -- called when a parse error occurred */
 static void handle_error(void *clientdata, const string s, int lineno)
 {
@@ -109,7 +116,7 @@ static void handle_header(int level, pairlist attribs)
   } else {
     printf("<li><a href=\"%s#%s\">", base, id ? id : (string) "");
   }
-  copying = true;
+  set_copying(true);
 }
 
 /* handle_span -- print a <span> starttag but without class=index */
@@ -139,18 +146,22 @@ static void finalize(void)
   for (; curlevel >= toc_low; curlevel--) printf("</ul>\n");
 }
 
+/* heading_level -- return n if name is "hn" or "Hn" (1 <= n <= 6), else 0 */
+static int heading_level(const conststring name)
+{
+  if ((name[0] == 'h' || name[0] == 'H') && '1' <= name[1] && name[1] <= '6'
+      && name[2] == '\0') return name[1] - '0';
+  return 0;
+}
+
 /* handle_starttag -- called after a start tag is parsed */
 static void handle_starttag(void *clientdata, const string name,
 			    pairlist attribs)
 {
   pairlist a;
+  int lev;
 
-  if (eq(name, "h1") || eq(name, "H1")) handle_header(1, attribs);
-  else if (eq(name, "h2") || eq(name, "H2")) handle_header(2, attribs);
-  else if (eq(name, "h3") || eq(name, "H3")) handle_header(3, attribs);
-  else if (eq(name, "h4") || eq(name, "H4")) handle_header(4, attribs);
-  else if (eq(name, "h5") || eq(name, "H5")) handle_header(5, attribs);
-  else if (eq(name, "h6") || eq(name, "H6")) handle_header(6, attribs);
+  if ((lev = heading_level(name))) handle_header(lev, attribs);
   else if (eq(name, "a") || eq(name, "A")) ;	/* Skip anchors */
   else if (copying && !strcasecmp(name, "span")) handle_span(attribs);
   else if (copying) {				/* Copy the tag */
@@ -183,12 +194,9 @@ static void handle_emptytag(void *clientdata, const string name,
 static void handle_endtag(void *clientdata, const string name)
 {
   if (copying) {
-    if (eq(name, "h1") || eq(name, "H1") || eq(name, "h2")
-	|| eq(name, "H2") || eq(name, "h3") || eq(name, "H3")
-	|| eq(name, "h4") || eq(name, "H4") || eq(name, "h5")
-	|| eq(name, "H5") || eq(name, "h6") || eq(name, "H6")) {
+    if (heading_level(name)) {
       printf("</a>\n");
-      copying = false;
+      set_copying(false);
     } else if (eq(name, "a") || eq(name, "A")) {
       /* skip anchors */
     } else {
@@ -245,6 +253,7 @@ int main(int argc, char *argv[])
   set_starttag_handler(handle_starttag);
   set_emptytag_handler(handle_emptytag);
   set_endtag_handler(handle_endtag);
+  set_copying(false);				/* Text only in headings */
 
   /* Loop over arguments; options may be in between file names */
   for (i = 1; i < argc; i++) {
@@ -183,7 +183,7 @@ static void process(Tree t, bool remove_anchor)
 	    if (a->value != NULL) printf("=\"%s\"", a->value);
 	  }
 	}
-	if (is_empty(h->name)) {
+	if (elt_flags(h) & ELT_EMPTY) {
 	  assert(h->children == NULL);
 	  printf(xml ? " />" : ">");
 	} else {
@@ -211,6 +211,7 @@ static void usage(string name)
 int main(int argc, char *argv[])
 {
   int i, status;
+  Arena arena;
 
   /* Bind the parser callback routines to our handlers */
   set_error_handler(handle_error);
@@ -238,10 +239,12 @@ int main(int argc, char *argv[])
       if (status != 200) errexit("%s : %s\n", argv[i], http_strerror(status));
     }
   }
+  arena = arena_new();				/* Holds the whole document */
+  (void) arena_use(arena);
   if (yyparse() != 0) exit(3);
 
   tree = get_root(tree);
   process(tree, false);
-  tree_delete(tree);				/* Just to test memory mgmt */
+  arena_delete(arena);				/* Frees the tree in one go */
   return 0;
 }
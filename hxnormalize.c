@@ -27,11 +27,14 @@
 #include "tree.e"
 #include "html.e"
 #include "scan.e"
+#include "outbuf.e"
 #include "textwrap.e"
 #include "dict.e"
 #include "openurl.e"
 #include "errexit.e"
 #include "langinfo.e"
+#include "heap.e"
+#include "batch.e"
 
 static Tree tree;
 static bool do_xml = false;
@@ -42,6 +45,8 @@ static bool clean_span = false;
 static string long_comment = NULL;
 static bool do_lang = false;
 static bool input_is_xml = false;
+static bool snapshot = false;
+static Textwrap formatter;			/* Writes to stdout */
 
 
 /* handle_error -- called when a parse error occurred */
@@ -99,21 +104,21 @@ void handle_pi(void *clientdata, string pi_text)
 void handle_html_starttag(void *clientdata, string name, pairlist attribs)
 {
   tree = html_push(tree, name, attribs);
-  free(name);
+  dispose(name);
 }
 
 /* handle_starttag -- called after a start tag is parsed */
 void handle_starttag(void *clientdata, string name, pairlist attribs)
 {
   tree = tree_push(tree, name, attribs);
-  free(name);
+  dispose(name);
 }
 
 /* handle_html_emptytag -- called after an empty tag is parsed */
 void handle_html_emptytag(void *clientdata, string name, pairlist attribs)
 {
   tree = html_push(tree, name, attribs);
-  free(name);
+  dispose(name);
 }
 
 /* handle_emptytag -- called after an empty tag is parsed */
@@ -121,21 +126,21 @@ void handle_emptytag(void *clientdata, string name, pairlist attribs)
 {
   tree = tree_push(tree, name, attribs);
   tree = tree_pop(tree, name);
-  free(name);
+  dispose(name);
 }
 
 /* handle_html_endtag -- called after an endtag is parsed (name may be "") */
 void handle_html_endtag(void *clientdata, string name)
 {
   tree = html_pop(tree, name);
-  free(name);
+  dispose(name);
 }
 
 /* handle_endtag -- called after an endtag is parsed (name may be "") */
 void handle_endtag(void *clientdata, string name)
 {
   tree = tree_pop(tree, name);
-  free(name);
+  dispose(name);
 }
 
 /* insert -- insert an attribute into a sorted list of attributes */
@@ -176,7 +181,7 @@ static bool next_ambiguous(Node *n)
   if (h->sister->tp == Procins) return true;
   if (h->sister->tp == Declaration) return false; /* Should not occur */
   assert(h->sister->tp == Element);		/* Cannot be Root */
-  return has_parent(h->sister->name, n->name);
+  return elt_has_parent(h->sister, n);
 }
 
 /* needs_quotes -- check if the attribute value can be printed unquoted */
@@ -191,14 +196,14 @@ static bool needs_quotes(const string s)
 }
 
 /* pp -- print the document normalized */
-static void pp(Tree n, bool preformatted, bool allow_text,
+static void pp(Textwrap w, Tree n, bool preformatted, bool allow_text,
 	       conststring lang)
 {
   bool pre, mixed, with_space;
   conststring lang2;
   string s;
   pairlist h;
-  size_t i, j;
+  size_t i;
   Tree l;
 
   with_space = with_spaces(lang);	/* Language with spaces between words? */
@@ -209,49 +214,49 @@ static void pp(Tree n, bool preformatted, bool allow_text,
 	assert(only_space(n->text));
       } else {
 	s = n->text;
-	out(s, preformatted, with_space);
+	out(w, s, preformatted, with_space);
       }
       break;
     case Comment:
       if (long_comment && strstr(n->text, long_comment) && !preformatted) {
 	/* Found a comment that should have an empty line before it */
-	outbreak();
-	outln(NULL, true, with_space);
+	outbreak(w);
+	outln(w, NULL, true, with_space);
       }
-      out("<!--", true, true); out(n->text, true, with_space);
-      if (allow_text || preformatted) out("-->", true, true);
-      else outln("-->", preformatted, true);
+      out(w, "<!--", true, true); out(w, n->text, true, with_space);
+      if (allow_text || preformatted) out(w, "-->", true, true);
+      else outln(w, "-->", preformatted, true);
       break;
     case Declaration:
       if (do_doctype) {
-	out("<!DOCTYPE ", false, true);
-	out(n->name, false, true);
+	out(w, "<!DOCTYPE ", false, true);
+	out(w, n->name, false, true);
 	if (n->text) {
-	  out(" PUBLIC \"", false, true);
-	  out(n->text, false, true);
-	  out("\"", false, true);
+	  out(w, " PUBLIC \"", false, true);
+	  out(w, n->text, false, true);
+	  out(w, "\"", false, true);
 	}
 	if (n->url) {
-	  if (!n->text) out(" SYSTEM", false, true);
-	  out(" \"", false, true);
-	  out(n->url, false, true);
-	  out("\"", false, true);
+	  if (!n->text) out(w, " SYSTEM", false, true);
+	  out(w, " \"", false, true);
+	  out(w, n->url, false, true);
+	  out(w, "\"", false, true);
 	} else if (n->text && do_xml) {	/* XML cannot omit the system literal */
-	  out(" \"\"", false, true);
+	  out(w, " \"\"", false, true);
 	}
-	outln(">", false, true);
+	outln(w, ">", false, true);
       }
       break;
     case Procins:
-      out("<?", false, true); out(n->text, true, true);
-      if (allow_text || preformatted) out(">", false, true);
-      else outln(">", false, true);
+      out(w, "<?", false, true); out(w, n->text, true, true);
+      if (allow_text || preformatted) out(w, ">", false, true);
+      else outln(w, ">", false, true);
       break;
     case Element:
       if (clean_span && eq(n->name, "span") && ! n->attribs) {
 	/* Omit start and end tags, print just the children. */
 	for (l = n->children; l != NULL; l = l->sister)
-	  pp(l, preformatted, true, lang);
+	  pp(w, l, preformatted, true, lang);
 	break;
       }
       /* Check for language attribute. */
@@ -267,63 +272,68 @@ static void pp(Tree n, bool preformatted, bool allow_text,
       /* Update inherited language. */
       if (lang2) lang = lang2;
 
-      if (!preformatted && break_before(n->name)) outln(NULL, false, true);
-      out("<", preformatted, true); out(n->name, preformatted, true);
-      if (break_before(n->name)) inc_indent();
+      if (!preformatted && (elt_flags(n) & ELT_BREAK_BEFORE))
+	outln(w, NULL, false, true);
+      out(w, "<", preformatted, true); out(w, n->name, preformatted, true);
+      if (elt_flags(n) & ELT_BREAK_BEFORE) inc_indent(w);
       n->attribs = sort_list(n->attribs);
       for (h = n->attribs; h != NULL; h = h->next) {
-	out(" ", false, true); out(h->name, false, true);
+	out(w, " ", false, true); out(w, h->name, false, true);
 	if (do_xml) {
-	  out("=\"", false, true);
-	  out(h->value ? h->value : h->name, true, true);
-	  outc('"', false, true);
+	  out(w, "=\"", false, true);
+	  out(w, h->value ? h->value : h->name, true, true);
+	  outc(w, '"', false, true);
 	} else if (h->value == NULL) {
 	  /* The h->name *is* the value (and the attribute name is implicit) */
 	} else if (!needs_quotes(h->value)) {
-	  out("=", false, true); /* Omit the quotes */
-	  out(h->value, true, true);
+	  out(w, "=", false, true); /* Omit the quotes */
+	  out(w, h->value, true, true);
 	} else {
-	  out("=\"", false, true);
-	  out(h->value, true, true);
-	  outc('"', false, true);
+	  out(w, "=\"", false, true);
+	  out(w, h->value, true, true);
+	  outc(w, '"', false, true);
 	}
       }
-      if (is_empty(n->name)) {
+      if (elt_flags(n) & ELT_EMPTY) {
 	assert(n->children == NULL);
-	outbreakpoint();
-	out(do_xml ? " />" : ">", true, true);
-	if (break_before(n->name)) dec_indent();
-	if (!preformatted && break_after(n->name)) outln(NULL, false, true);
+	outbreakpoint(w);
+	out(w, do_xml ? " />" : ">", true, true);
+	if (elt_flags(n) & ELT_BREAK_BEFORE) dec_indent(w);
+	if (!preformatted && (elt_flags(n) & ELT_BREAK_AFTER))
+	  outln(w, NULL, false, true);
 
-      } else if (do_xml && !input_is_xml && is_cdata_elt(n->name)) {
+      } else if (do_xml && !input_is_xml && (elt_flags(n) & ELT_CDATA)) {
 	/* Escape '<' and '&', but only if input was HTML, not XML */
 	if (!n->children) {
-	  out(" />", true, true);
-	  if (break_before(n->name)) dec_indent();
+	  out(w, " />", true, true);
+	  if (elt_flags(n) & ELT_BREAK_BEFORE) dec_indent(w);
 	} else {
-	  outbreakpoint();
-	  out(">", preformatted, true);
+	  outbreakpoint(w);
+	  out(w, ">", preformatted, true);
 	  for (l = n->children; l; l = l->sister) {
 	    assert(l->tp == Text);
-	    for (s = l->text; *s; s++)
-	      if (*s == '<') out("&lt;", true, true);
-	      else if (*s == '&') out("&amp;", true, true);
-	      else outc(*s, true, with_space);
+	    for (s = l->text; *s; s += i + 1) {
+	      i = strcspn(s, "<&");
+	      outn(w, s, i, true, with_space);
+	      if (s[i] == '<') out(w, "&lt;", true, true);
+	      else if (s[i] == '&') out(w, "&amp;", true, true);
+	      else break;
+	    }
 	  }
-	  if (break_before(n->name)) dec_indent();
-	  out("</", true, true);
-	  out(n->name, true, true);
-	  outbreakpoint();
-	  out(">", preformatted, true);
+	  if (elt_flags(n) & ELT_BREAK_BEFORE) dec_indent(w);
+	  out(w, "</", true, true);
+	  out(w, n->name, true, true);
+	  outbreakpoint(w);
+	  out(w, ">", preformatted, true);
 	}
-	if (!preformatted && break_after(n->name)) outbreak();
+	if (!preformatted && (elt_flags(n) & ELT_BREAK_AFTER)) outbreak(w);
 
-      } else if (!do_xml && input_is_xml && is_cdata_elt(n->name) &&
+      } else if (!do_xml && input_is_xml && (elt_flags(n) & ELT_CDATA) &&
 		 n->children) {
 	/* Remove "<![CDATA[" and "]]>", or unescape &lt; and &amp;,
 	   but only if input was XML, not HTML */
-	outbreakpoint();
-	out(">", preformatted, true);
+	outbreakpoint(w);
+	out(w, ">", preformatted, true);
 	for (l = n->children; l != NULL; l = l->sister) {
 	  if (l->tp != Text) {
 	    errexit("Cannot convert <%s> to HTML because it has children\n",
@@ -332,38 +342,39 @@ static void pp(Tree n, bool preformatted, bool allow_text,
 	    assert(hasaffix(l->text, "]]>"));
 	    s = l->text + 9;	/* Skip "<![CDATA[" */
 	    i = strlen(s) - 3;	/* Omit "]]>" */
-	    for (j = 0; j < i; j++) outc(s[j], true, with_space);
+	    outn(w, s, i, true, with_space);
 	  } else {		/* Unescape &lt; and &amp; */
 	    for (s = l->text; *s; s++)
-	      if (hasprefix(s, "&amp;")) {outc('&', true, true); s += 4;}
-	      else if (hasprefix(s, "&lt;")) {outc('<', true, true); s += 3;}
-	      else if (hasprefix(s, "&gt;")) {outc('>', true, true); s += 3;}
-	      else if (hasprefix(s, "&quot;")) {outc('"', true, true); s += 5;}
-	      else if (hasprefix(s, "&apos;")) {outc('\'', true, true); s += 5;}
-	      else outc(*s, true, with_space);
+	      if (hasprefix(s, "&amp;")) {outc(w, '&', true, true); s += 4;}
+	      else if (hasprefix(s, "&lt;")) {outc(w, '<', true, true); s += 3;}
+	      else if (hasprefix(s, "&gt;")) {outc(w, '>', true, true); s += 3;}
+	      else if (hasprefix(s, "&quot;")) {outc(w, '"', true, true); s += 5;}
+	      else if (hasprefix(s, "&apos;")) {outc(w, '\'', true, true); s += 5;}
+	      else outc(w, *s, true, with_space);
 	  }
 	}
-	if (break_before(n->name)) dec_indent();
-	out("</", preformatted, true);
-	out(n->name, preformatted, true);
-	outbreakpoint();
-	out(">", preformatted, true);
-	if (!preformatted && break_after(n->name)) outbreak();
+	if (elt_flags(n) & ELT_BREAK_BEFORE) dec_indent(w);
+	out(w, "</", preformatted, true);
+	out(w, n->name, preformatted, true);
+	outbreakpoint(w);
+	out(w, ">", preformatted, true);
+	if (!preformatted && (elt_flags(n) & ELT_BREAK_AFTER)) outbreak(w);
 
       } else {
-	outbreakpoint();
-	out(">", preformatted, true);
-	pre = preformatted || is_pre(n->name);
-	mixed = is_mixed(n->name);
+	outbreakpoint(w);
+	out(w, ">", preformatted, true);
+	pre = preformatted || (elt_flags(n) & ELT_PRE);
+	mixed = elt_flags(n) & ELT_MIXED;
 	for (l = n->children; l != NULL; l = l->sister)
-	  pp(l, pre, mixed, lang);
-	if (break_before(n->name)) dec_indent();
-	if (do_xml || do_endtag || need_etag(n->name) || next_ambiguous(n)) {
-	  out("</", pre, true); out(n->name, pre, true);
-	  outbreakpoint();
-	  out(">", preformatted, true);
+	  pp(w, l, pre, mixed, lang);
+	if (elt_flags(n) & ELT_BREAK_BEFORE) dec_indent(w);
+	if (do_xml || do_endtag || (elt_flags(n) & ELT_ETAG)
+	    || next_ambiguous(n)) {
+	  out(w, "</", pre, true); out(w, n->name, pre, true);
+	  outbreakpoint(w);
+	  out(w, ">", preformatted, true);
 	}
-	if (!preformatted && break_after(n->name)) outbreak();
+	if (!preformatted && (elt_flags(n) & ELT_BREAK_AFTER)) outbreak(w);
       }
       break;
     default:
@@ -371,21 +382,36 @@ static void pp(Tree n, bool preformatted, bool allow_text,
   }
 }
 
-/* prettyprint -- print the tree normalized */
-static void prettyprint(Tree t)
+/* prettyprint -- print the tree normalized with formatter w */
+static void prettyprint(Textwrap w, Tree t)
 {
   Tree h;
   assert(t->tp == Root);
-  for (h = t->children; h != NULL; h = h->sister) pp(h, false, false, NULL);
-  flush();
+  for (h = t->children; h != NULL; h = h->sister) pp(w, h, false, false, NULL);
+  flush(w);
+}
+
+/* process -- parse one document and print it normalized, return status */
+static int process(void)
+{
+  has_errors = false;
+  reset_textwrap(formatter);		/* The previous one may have failed */
+  if (yyparse() != 0) return 3;
+  tree = get_root(tree);
+  if (!snapshot) prettyprint(formatter, tree);
+  else if (!write_snapshot(tree, stdout)) {perror("stdout"); return 2;}
+  reset_textwrap(formatter);
+  if (!outbuf_flush(outbuf_stdout())) {perror("stdout"); return 2;}
+  return has_errors ? 1 : 0;
 }
 
 /* usage -- print usage message and exit */
 static void usage(string prog)
 {
   fprintf(stderr, "%s version %s\n\
-Usage: %s [-e] [-d] [-x] [-L] [-i indent] [-l linelen] [-c commentmagic] [file_or_url]\n",
-	  prog, VERSION, prog);
+Usage: %s [-e] [-d] [-x] [-L] [-S] [-i indent] [-l linelen] [-c commentmagic] [file_or_url]\n\
+       %s -B [-j jobs] [options] [input output...]\n",
+	  prog, VERSION, prog, prog);
   exit(1);
 }
 
@@ -393,26 +419,26 @@ Usage: %s [-e] [-d] [-x] [-L] [-i indent] [-l linelen] [-c commentmagic] [file_o
 int main(int argc, char *argv[])
 {
   int c, status = 200;
+  bool batch_mode = false;
+  int jobs = 1;
 
-  while ((c = getopt(argc, argv, "edxXi:l:sc:L")) != -1)
+  formatter = textwrap_new(outbuf_stdout());
+  while ((c = getopt(argc, argv, "edxXi:l:sc:LSBj:")) != -1)
     switch (c) {
+    case 'B': batch_mode = true; break;
+    case 'j': jobs = atoi(optarg); break;
     case 'e': do_endtag = true; break;
     case 'x': do_xml = true; break;
     case 'X': input_is_xml = true; break;
     case 'd': do_doctype = false; break;
-    case 'i': set_indent(atoi(optarg)); break;
-    case 'l': set_linelen(atoi(optarg)); break;
+    case 'i': set_indent(formatter, atoi(optarg)); break;
+    case 'l': set_linelen(formatter, atoi(optarg)); break;
     case 's': clean_span = true; break;
     case 'c': long_comment = optarg; break;
     case 'L': do_lang = true; break;
+    case 'S': snapshot = true; break;
     default: usage(argv[0]);
     }
-  if (optind == argc) yyin = stdin;
-  else if (optind == argc - 1) yyin = fopenurl(argv[optind], "r", &status);
-  else usage(argv[0]);
-  if (yyin == NULL) {perror(argv[optind]); exit(2);}
-  if (status != 200) errexit("%s : %s\n", argv[optind], http_strerror(status));
-
   /* Bind the parser callback routines to our handlers */
   if (input_is_xml) {
     set_error_handler(handle_error);
@@ -438,8 +464,13 @@ int main(int argc, char *argv[])
     set_endtag_handler(handle_html_endtag);
   }
 
-  if (yyparse() != 0) {exit(3);}
-  tree = get_root(tree);
-  prettyprint(tree);
-  return has_errors ? 1 : 0;
+  if (batch_mode) return batch(argc, argv, optind, jobs, process);
+
+  if (optind == argc) yyin = stdin;
+  else if (optind == argc - 1) yyin = fopenurl(argv[optind], "r", &status);
+  else usage(argv[0]);
+  if (yyin == NULL) {perror(argv[optind]); exit(2);}
+  if (status != 200) errexit("%s : %s\n", argv[optind], http_strerror(status));
+
+  return process();
 }
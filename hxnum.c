@@ -29,6 +29,7 @@
 #endif
 #include <stdlib.h>
 #include <assert.h>
+#include <stdbool.h>
 #include "export.h"
 #include "types.e"
 #include "class.e"
@@ -37,18 +38,22 @@
 #include "dict.e"
 #include "openurl.e"
 #include "errexit.e"
+#include "batch.e"
+#include "outbuf.e"
 
 #define SECNO "secno"				/* class attribute */
 #define NO_NUM "no-num"				/* class-attribute */
-#define OPTS ":l:h:n:1:2:3:4:5:6:?"		/* Command line options */
+#define OPTS ":l:h:n:1:2:3:4:5:6:?Bj:"		/* Command line options */
 
 static int h[] = {-1, 0, 0, 0, 0, 0, 0};	/* Counters for each level */
+static int h0[7];				/* Initial values of h */
 static int low = 1;				/* First counter to use */
 static int high = 6;				/* Last counter to use */
 static string format[7] = {			/* Format for each counter */
   NULL, "%d. ", "%d.%d. ", "%d.%d.%d. ", "%d.%d.%d.%d. ",
   "%d.%d.%d.%d.%d. ", "%d.%d.%d.%d.%d.%d. "};
 static int skipping = 0;			/* >0 to suppress output */
+static Outbuf out;				/* Buffer for stdout */
 
 
 /* romannumeral -- generate roman numeral for 1 <= n <= 4000 */
@@ -93,13 +98,13 @@ void end(void *clientdata)
 /* handle_comment -- called after a comment is parsed */
 void handle_comment(void *clientdata, string commenttext)
 {
-  printf("<!--%s-->", commenttext);
+  outbuf_wrap(out, "<!--", commenttext, "-->");
 }
 
 /* handle_text -- called after a text chunk is parsed */
 void handle_text(void *clientdata, string text)
 {
-  if (skipping == 0) fputs(text, stdout);
+  if (skipping == 0) outbuf_puts(out, text);
 }
 
 /* handle_decl -- called after a declaration is parsed */
@@ -107,23 +112,30 @@ void handle_decl(void *clientdata, const string gi,
 		 const string fpi, const string url)
 {
   if (skipping == 0) {
-    printf("<!DOCTYPE %s", gi);
-    if (fpi) printf(" PUBLIC \"%s\"\n", fpi);
-    if (url) printf(" %s\"%s\"", fpi ? "" : "SYSTEM ", url);
-    printf(">");
+    outbuf_wrap(out, "<!DOCTYPE ", gi, "");
+    if (fpi) outbuf_wrap(out, " PUBLIC \"", fpi, "\"\n");
+    if (url) outbuf_printf(out, " %s\"%s\"", fpi ? "" : "SYSTEM ", url);
+    outbuf_puts(out, ">");
   }
 }
 
 /* handle_pi -- called after a PI is parsed */
 void handle_pi(void *clientdata, string pi_text)
 {
-  if (skipping == 0) printf("<?%s>", pi_text);
+  if (skipping == 0) outbuf_wrap(out, "<?", pi_text, ">");
+}
+
+/* heading_level -- return n if name is "hn" or "Hn" (1 <= n <= 6), else 0 */
+static int heading_level(const conststring name)
+{
+  if ((name[0] == 'h' || name[0] == 'H') && '1' <= name[1] && name[1] <= '6'
+      && name[2] == '\0') return name[1] - '0';
+  return 0;
 }
 
 /* handle_starttag -- called after a start tag is parsed */
 void handle_starttag(void *clientdata, string name, pairlist attribs)
 {
-  pairlist p;
   int lev, i;
   string s;
 
@@ -140,21 +152,12 @@ void handle_starttag(void *clientdata, string name, pairlist attribs)
   }
 
   /* Print tag and attributes */
-  printf("<%s", name);
-  for (p = attribs; p != NULL; p = p->next) {
-    printf(" %s", p->name);
-    if (p->value != NULL) printf("=\"%s\"", p->value);
-  }
-  printf(">");
+  outbuf_wrap(out, "<", name, "");
+  outbuf_attribs(out, attribs);
+  outbuf_puts(out, ">");
 
   /* If header, insert counters */
-  if (eq("h1", name) || eq("H1", name)) lev = 1;
-  else if (eq("h2", name) || eq("H2", name)) lev = 2;
-  else if (eq("h3", name) || eq("H3", name)) lev = 3;
-  else if (eq("h4", name) || eq("H4", name)) lev = 4;
-  else if (eq("h5", name) || eq("H5", name)) lev = 5;
-  else if (eq("h6", name) || eq("H6", name)) lev = 6;
-  else lev = 0;
+  lev = heading_level(name);
 
   /* Don't number headers with class "no-num" */
   if (lev > 0 && has_class(attribs, NO_NUM)) lev = 0;
@@ -162,57 +165,66 @@ void handle_starttag(void *clientdata, string name, pairlist attribs)
   if (low <= lev && lev <= high) {
     h[lev]++;
     for (i = lev + 1; i <= high; i++) h[i] = 0;
-    printf("<span class=\"%s\">", SECNO);
+    outbuf_wrap(out, "<span class=\"", SECNO, "\">");
     for (i = low, s = format[lev]; *s; s++) {
       if (*s == '%') {
 	s++;
 	switch (*s) {
 	  case 'n': i++; break;			/* No number */
-	  case 'd': printf("%d", h[i++]); break; /* Decimal */
-	  case 'a': printf("%c", 'a' + (h[i++] - 1)); break; /* Lowercase */
-	  case 'A': printf("%c", 'A' + (h[i++] - 1)); break; /* Uppercase */
-	  case 'i': printf("%s", down(romannumeral(h[i++]))); break;
-	  case 'I': printf("%s", romannumeral(h[i++])); break; /* Roman */
-	  default: putchar(*s);			/* Escaped char */
+	  case 'd': outbuf_printf(out, "%d", h[i++]); break; /* Decimal */
+	  case 'a': outbuf_putc(out, 'a' + (h[i++] - 1)); break; /* Lowercase */
+	  case 'A': outbuf_putc(out, 'A' + (h[i++] - 1)); break; /* Uppercase */
+	  case 'i': outbuf_puts(out, down(romannumeral(h[i++]))); break;
+	  case 'I': outbuf_puts(out, romannumeral(h[i++])); break; /* Roman */
+	  default: outbuf_putc(out, *s);	/* Escaped char */
 	}
       } else {
-	putchar(*s);
+	outbuf_putc(out, *s);
       }
     }
-    printf("</span>");
+    outbuf_puts(out, "</span>");
   }
 }
 
 /* handle_emptytag -- called after an empty tag is parsed */
 void handle_emptytag(void *clientdata, string name, pairlist attribs)
 {
-  pairlist p;
-
   if (skipping == 0) {
-    printf("<%s", name);
-    for (p = attribs; p != NULL; p = p->next) {
-      printf(" %s", p->name);
-      if (p->value != NULL) printf("=\"%s\"", p->value);
-    }
-    printf(" />");
+    outbuf_wrap(out, "<", name, "");
+    outbuf_attribs(out, attribs);
+    outbuf_puts(out, " />");
   }
 }
 
 /* handle_endtag -- called after an endtag is parsed (name may be "") */
 void handle_endtag(void *clientdata, string name)
 {
-  if (skipping == 0) printf("</%s>", name);
+  if (skipping == 0) outbuf_wrap(out, "</", name, ">");
   else skipping--;
 }
 
 /* --------------------------------------------------------------------- */
 
+/* process -- parse one document and print it numbered, return status */
+static int process(void)
+{
+  int r;
+
+  memcpy(h, h0, sizeof(h));			/* Restart the counters */
+  skipping = 0;
+  out = outbuf_stdout();
+  r = yyparse() != 0 ? 3 : 0;
+  if (!outbuf_flush(out)) {perror("stdout"); return 2;}
+  return r;
+}
+
 /* usage -- print usage message and exit */
 static void usage(string prog)
 {
   fprintf(stderr, "Version %s\n\
 Usage: %s [-l low] [-h high] [-1 format] [-2 format] [-3 format]\n\
-  [-4 format] [-5 format] [-6 format] [html-file]\n", VERSION, prog);
+  [-4 format] [-5 format] [-6 format] [html-file]\n\
+       %s -B [-j jobs] [options] [input output...]\n", VERSION, prog, prog);
   exit(2);
 }
 
@@ -230,6 +242,8 @@ static void help(void)
   printf("  -4 format  format for level 4 [default \"%%d.%%d.%%d.%%d. \"]\n");
   printf("  -5 format  format for level 5 [default \"%%d.%%d.%%d.%%d.%%d. \"]\n");
   printf("  -6 format  format for level 6 [default \"%%d.%%d.%%d.%%d.%%d.%%d. \"]\n");
+  printf("  -B         batch mode: number pairs of input and output files\n");
+  printf("  -j jobs    with -B, number of documents to treat in parallel\n");
   printf("  -?         this help\n");
   printf("The format strings may contain:\n");
   printf("  %%d  replaced by decimal number\n");
@@ -247,6 +261,8 @@ static void help(void)
 int main(int argc, char *argv[])
 {
   int i, status = 200, c;
+  bool batch_mode = false;
+  int jobs = 1;
 
   /* Bind the parser callback routines to our handlers */
   set_error_handler(handle_error);
@@ -293,10 +309,15 @@ int main(int argc, char *argv[])
     case '4': format[4] = optarg; break;
     case '5': format[5] = optarg; break;
     case '6': format[6] = optarg; break;
+    case 'B': batch_mode = true; break;
+    case 'j': jobs = atoi(optarg); break;
     case '?': help(); break;
     default: usage(argv[0]);
     }
   }
+  memcpy(h0, h, sizeof(h));
+
+  if (batch_mode) return batch(argc, argv, optind, jobs, process);
 
   if (optind == argc) yyin = stdin;
   else if (optind == argc - 1 && eq(argv[optind], "-")) yyin = stdin;
@@ -306,8 +327,5 @@ int main(int argc, char *argv[])
   if (yyin == NULL) {perror(argv[optind]); exit(1);}
   if (status != 200) errexit("%s : %s\n", argv[optind], http_strerror(status));
 
-  if (yyparse() != 0) {
-    exit(3);
-  }
-  return 0;
+  return process();
 }
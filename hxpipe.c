@@ -92,6 +92,9 @@
 #include <stdlib.h>
 #include <assert.h>
 #include <stdbool.h>
+#include <errno.h>
+#include <sys/types.h>
+#include <sys/stat.h>
 #include "export.h"
 #include "types.e"
 #include "html.e"
@@ -99,28 +102,38 @@
 #include "dict.e"
 #include "openurl.e"
 #include "errexit.e"
+#include "outbuf.e"
 
 #define XMLID "{http://www.w3.org/XML/1998/namespace}id"
+#define CHUNK 65536		/* Pass longer texts and comments in parts */
 
 static bool has_error = false;
 static bool in_text = false;
+static bool in_comment = false;
 static bool linenumbering = false;
+static Outbuf out;
 
 
 /* escape -- print a string with certain characters escaped */
 static void escape(const string t)
 {
-  string s;
+  string s = t;
+  size_t n;
 
-  for (s = t; *s; s++)
-    switch (*s) {
-      case '\r': printf("\\r"); break;
-      case '\t': printf("\\t"); break;
-      case '\n': printf("\\n"); break;
-      case '\\': printf("\\\\"); break;
-      case '&': if (*(s+1) == '#') printf("\\"); else printf("&"); break;
-      default: putchar(*s);
+  for (;;) {
+    n = strcspn(s, "\r\t\n\\&");		/* Copy up to a special char */
+    outbuf_write(out, s, n);
+    switch (*(s += n)) {
+      case '\0': return;
+      case '\r': outbuf_write(out, "\\r", 2); break;
+      case '\t': outbuf_write(out, "\\t", 2); break;
+      case '\n': outbuf_write(out, "\\n", 2); break;
+      case '\\': outbuf_write(out, "\\\\", 2); break;
+      case '&': outbuf_putc(out, *(s+1) == '#' ? '\\' : '&'); break;
+      default: assert(!"Cannot happen");
     }
+    s++;
+  }
 }
 
 
@@ -142,17 +155,21 @@ void* start(void)
 /* end -- called after the last event is reported */
 void end(void *clientdata)
 {
-  if (in_text) {putchar('\n'); in_text = false;}
+  if (in_text) {outbuf_putc(out, '\n'); in_text = false;}
 }
 
 /* handle_comment -- called after a comment is parsed */
 void handle_comment(void *clientdata, string commenttext)
 {
-  if (in_text) {putchar('\n'); in_text = false;}
-  if (linenumbering) printf("L%d\n", lineno);
-  putchar('*');
+  if (!in_comment) {
+    if (in_text) {outbuf_putc(out, '\n'); in_text = false;}
+    if (linenumbering) outbuf_printf(out, "L%d\n", scan_lineno());
+    outbuf_putc(out, '*');
+  }
   escape(commenttext);
-  putchar('\n');
+  in_comment = html_continued();	/* Parts of a long comment on one line */
+  if (!in_comment) outbuf_putc(out, '\n');
+  free(commenttext);
 }
 
 /* handle_text -- called after a text chunk is parsed */
@@ -163,30 +180,35 @@ void handle_text(void *clientdata, string text)
    * same line.
    **/
   if (! in_text) {
-    if (linenumbering) printf("L%d\n", lineno);
-    putchar('-');
+    if (linenumbering) outbuf_printf(out, "L%d\n", scan_lineno());
+    outbuf_putc(out, '-');
     in_text = true;
   }
   escape(text);
+  free(text);
 }
 
 /* handle_decl -- called after a declaration is parsed */
 void handle_decl(void *clientdata, string gi, string fpi,
 		 string url)
 {
-  if (in_text) {putchar('\n'); in_text = false;}
-  if (linenumbering) printf("L%d\n", lineno);
-  printf("!%s \"%s\" %s\n", gi, fpi ? fpi : "", url ? url : "");
+  if (in_text) {outbuf_putc(out, '\n'); in_text = false;}
+  if (linenumbering) outbuf_printf(out, "L%d\n", scan_lineno());
+  outbuf_printf(out, "!%s \"%s\" %s\n", gi, fpi ? fpi : "", url ? url : "");
+  free(gi);
+  free(fpi);
+  free(url);
 }
 
 /* handle_pi -- called after a PI is parsed */
 void handle_pi(void *clientdata, string pi_text)
 {
-  if (in_text) {putchar('\n'); in_text = false;}
-  if (linenumbering) printf("L%d\n", lineno);
-  putchar('?');
+  if (in_text) {outbuf_putc(out, '\n'); in_text = false;}
+  if (linenumbering) outbuf_printf(out, "L%d\n", scan_lineno());
+  outbuf_putc(out, '?');
   escape(pi_text);
-  putchar('\n');
+  outbuf_putc(out, '\n');
+  free(pi_text);
 }
 
 /* print_attrs -- print attributes */
@@ -195,50 +217,88 @@ void print_attrs(const pairlist attribs)
   pairlist p;
 
   for (p = attribs; p; p = p->next) {
-    putchar('A');
-    printf("%s", p->name);
+    outbuf_putc(out, 'A');
+    outbuf_puts(out, p->name);
     if (eq(p->name, "xmlid") || eq(p->name, "xml:id") ||
-	eq(p->name, XMLID)) printf(" TOKEN ");
-    else printf(" CDATA ");
-    if (p->value) escape(p->value); else printf("%s", p->name);
-    putchar('\n');
+	eq(p->name, XMLID)) outbuf_puts(out, " TOKEN ");
+    else outbuf_puts(out, " CDATA ");
+    if (p->value) escape(p->value); else outbuf_puts(out, p->name);
+    outbuf_putc(out, '\n');
   }
 }
 
 /* handle_starttag -- called after a start tag is parsed */
 void handle_starttag(void *clientdata, string name, pairlist attribs)
 {
-  if (in_text) {putchar('\n'); in_text = false;}
+  if (in_text) {outbuf_putc(out, '\n'); in_text = false;}
   print_attrs(attribs);
-  if (linenumbering) printf("L%d\n", lineno);
-  putchar('(');
-  printf("%s", name);
-  putchar('\n');
+  if (linenumbering) outbuf_printf(out, "L%d\n", scan_lineno());
+  outbuf_putc(out, '(');
+  outbuf_puts(out, name);
+  outbuf_putc(out, '\n');
+  free(name);
+  pairlist_delete(attribs);
 }
 
 /* handle_emptytag -- called after an empty tag is parsed */
 void handle_emptytag(void *clientdata, string name, pairlist attribs)
 {
-  if (in_text) {putchar('\n'); in_text = false;}
+  if (in_text) {outbuf_putc(out, '\n'); in_text = false;}
   print_attrs(attribs);
-  if (linenumbering) printf("L%d\n", lineno);
-  putchar('|');
-  printf("%s", name);
-  putchar('\n');
+  if (linenumbering) outbuf_printf(out, "L%d\n", scan_lineno());
+  outbuf_putc(out, '|');
+  outbuf_puts(out, name);
+  outbuf_putc(out, '\n');
+  free(name);
+  pairlist_delete(attribs);
 }
 
 /* handle_endtag -- called after an endtag is parsed (name may be "") */
 void handle_endtag(void *clientdata, string name)
 {
-  if (in_text) {putchar('\n'); in_text = false;}
-  if (linenumbering) printf("L%d\n", lineno);
-  putchar(')');
-  printf("%s", name);
-  putchar('\n');
+  if (in_text) {outbuf_putc(out, '\n'); in_text = false;}
+  if (linenumbering) outbuf_printf(out, "L%d\n", scan_lineno());
+  outbuf_putc(out, ')');
+  outbuf_puts(out, name);
+  outbuf_putc(out, '\n');
+  free(name);
 }
 
 /* --------------------------------------------------------------------- */
 
+/* parse_stream -- parse stdin, a pipe or socket, in chunks as they arrive */
+static int parse_stream(void)
+{
+  static char buf[65536];
+  ssize_t n;
+  int c;
+
+  /* No HTML or XML document starts with a DEL, but a snapshot does.
+     Peek at it without buffering, so that read() gets all the rest */
+  setvbuf(stdin, NULL, _IONBF, 0);
+  if ((c = getc(stdin)) == EOF || c == '\177') {
+    if (c != EOF) (void) ungetc(c, stdin);
+    return yyparse();
+  }
+  buf[0] = c;
+  if (html_parser_feed(NULL, buf, 1) != 0) return html_parser_finish(NULL);
+  while ((n = read(fileno(stdin), buf, sizeof(buf))) != 0) {
+    if (n < 0 && errno == EINTR) continue;
+    if (n < 0) {perror("stdin"); exit(2);}
+    if (html_parser_feed(NULL, buf, n) != 0) break;
+  }
+  return html_parser_finish(NULL);
+}
+
+/* is_stream -- true if f is a pipe or a socket */
+static bool is_stream(FILE *f)
+{
+  struct stat st;
+
+  return fstat(fileno(f), &st) == 0
+    && (S_ISFIFO(st.st_mode) || S_ISSOCK(st.st_mode));
+}
+
 /* usage -- print usage message and exit */
 static void usage(string prog)
 {
@@ -279,7 +339,10 @@ int main(int argc, char *argv[])
   if (yyin == NULL) {perror(argv[optind]); exit(1);}
   if (status != 200) errexit("%s : %s\n", argv[optind], http_strerror(status));
 
-  if (yyparse() != 0) exit(3);
-
+  out = outbuf_stdout();
+  set_chunk_size(CHUNK);
+  if ((yyin == stdin && is_stream(stdin) ? parse_stream() : yyparse()) != 0)
+    exit(3);
+  if (!outbuf_flush(out)) {perror("stdout"); exit(2);}
   return has_error ? 1 : 0;
 }
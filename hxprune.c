@@ -37,6 +37,7 @@
 #include "openurl.e"
 #include "class.e"
 #include "errexit.e"
+#include "heap.e"
 
 #define EXCLUDE_CLASS "exclude"			/* Default value for class */
 
@@ -137,7 +138,7 @@ static void prune(Tree t, const string class)
 	    if (a->value != NULL) printf("=\"%s\"", a->value);
 	    else if (xml) printf("=\"%s\"", a->name);
 	  }
-	  if (is_empty(h->name)) {
+	  if (elt_flags(h) & ELT_EMPTY) {
 	    assert(h->children == NULL);
 	    printf(xml ? " />" : ">");
 	  } else {
@@ -167,6 +168,7 @@ static void usage(string name)
 int main(int argc, char *argv[])
 {
   int i, status;
+  Arena arena;
   string class = EXCLUDE_CLASS;
 
   /*  mtrace(); */
@@ -197,11 +199,13 @@ int main(int argc, char *argv[])
     }
   }
 
+  arena = arena_new();				/* Holds the whole document */
+  (void) arena_use(arena);
   if (yyparse() != 0) {
     exit(3);
   }
   tree = get_root(tree);
   prune(tree, class);
-  tree_delete(tree);				/* Just to test memory mgmt */
+  arena_delete(arena);				/* Frees the tree in one go */
   return 0;
 }
@@ -61,6 +61,7 @@
 #include "openurl.e"
 #include "genid.e"
 #include "errexit.e"
+#include "atom.e"
 
 
 /* Warning: arbitrary limit! */
@@ -72,7 +73,15 @@ static Tree tree;
 static string base = NULL, progname;
 static bool do_xml = false;
 static bool use_language = false;
+static bool snapshot = false;
 static char *extras = "-_@()";			/* Significant characters */
+static conststring a_a, a_dfn, a_span;		/* Atoms for element names */
+
+/* Inline elements whose contents can be an instance of a term */
+static conststring inline_elts[] = {
+  "abbr", "acronym", "b", "bdo", "big", /*"cite",*/ "code", "del", /*"dt",*/
+  "em", "i", "ins", "kbd", "label", "legend", "q", "samp", "small",
+  "span", "strong", "sub", "sup", "tt", "var", NULL};
 
 
 /* handle_error -- called when a parse error occurred */
@@ -169,6 +178,28 @@ static void load_definitions(FILE *f)
 }
 
 
+/* init_atoms -- turn the element names we look for into atoms */
+static void init_atoms(void)
+{
+  int i;
+
+  a_a = atom("a");
+  a_dfn = atom("dfn");
+  a_span = atom("span");
+  for (i = 0; inline_elts[i]; i++) inline_elts[i] = atom(inline_elts[i]);
+}
+
+
+/* is_inline -- check if name (an atom) is in inline_elts */
+static bool is_inline(const conststring name)
+{
+  int i;
+
+  for (i = 0; inline_elts[i]; i++) if (inline_elts[i] == name) return true;
+  return false;
+}
+
+
 /* get_contents -- collect all text content of an elt into a single string */
 static string get_contents(Tree t)
 {
@@ -179,7 +210,7 @@ static string get_contents(Tree t)
   for (h = t->children; h; h = h->sister) {
     if (h->tp == Text) {
       strapp(&contents, h->text, NULL);
-    } else if (h->tp == Element && !eq(h->name, "a") && !eq(h->name, "dfn")
+    } else if (h->tp == Element && h->name != a_a && h->name != a_dfn
 	       && (k = get_contents(h))) {
       strapp(&contents, k, NULL);
       dispose(k);
@@ -280,7 +311,7 @@ static void collect_terms(Tree tree, FILE *db)
       for (h = tree->children; h; h = h->sister) collect_terms(h, db);
       break;
     case Element:
-      if (! eq(tree->name, "dfn")) {
+      if (tree->name != a_dfn) {
 	for (h = tree->children; h; h = h->sister) collect_terms(h, db);
       } else {
 	if (! (id = get_attrib(tree, "id"))) {	/* Make sure there's an ID */
@@ -313,62 +344,50 @@ static void collect_terms(Tree tree, FILE *db)
 }
 
 
+/* lang_of -- return the language of element t, or NULL if unknown */
+static conststring lang_of(Tree t)
+{
+  conststring lang;
+
+  for (; t->tp == Element; t = t->parent)
+    if ((lang = get_attrib(t, "lang")) || (lang = get_attrib(t, "xml:lang")))
+      return lang;
+  return NULL;
+}
+
+
 /* find_instances -- walk tree, make instances of defined terms into links */
-static void find_instances(Tree tree, const conststring language)
+static void find_instances(Tree tree)
 {
   ENTRY *e;
-  conststring title, lang;
+  conststring title;
   string key;
-
-  if (!tree) return;
-
-  switch (tree->tp) {
-    case Text: case Comment: case Declaration: case Procins:
-      find_instances(tree->sister, language);
-      break;
-    case Root:
-      find_instances(tree->children, language);	/* Recurse over children */
-      find_instances(tree->sister, language);	/* Recurse over siblings */
-      break;
-    case Element:
-      if (!(lang = get_attrib(tree, "lang")) &&
-	  !(lang = get_attrib(tree, "xml:lang")))
-	lang = language;
-      if (eq(tree->name, "a") || eq(tree->name, "dfn"))
-	;					/* Don't descend into these */
-      else if (eq(tree->name, "abbr") || eq(tree->name, "acronym")
-	       || eq(tree->name, "b") || eq(tree->name, "bdo")
-	       || eq(tree->name, "big") /*|| eq(tree->name, "cite")*/
-	       || eq(tree->name, "code") || eq(tree->name, "del")
-	       /*|| eq(tree->name, "dt")*/ || eq(tree->name, "em")
-	       || eq(tree->name, "i") || eq(tree->name, "ins")
-	       || eq(tree->name, "kbd") || eq(tree->name, "label")
-	       || eq(tree->name, "legend") || eq(tree->name, "q")
-	       || eq(tree->name, "samp") || eq(tree->name, "small")
-	       || eq(tree->name, "span") || eq(tree->name, "strong")
-	       || eq(tree->name, "sub") || eq(tree->name, "sup")
-	       || eq(tree->name, "tt") || eq(tree->name, "var")) {
-	if ((title = get_attrib(tree, "title"))) /* Use title if it exists */
-	  key = newstring(title);
-	else					/* Get flattened contents */
-	  key = get_contents(tree);
-	if (!(e = search(normalize(key), lang))) { /* If not an instance */
-	  find_instances(tree->children, lang); /* Recurse over children */
-	} else if (eq(tree->name, "span")) {	/* Found an instance */
-	  rename_elt(tree, "a");		/* Turn the span into an a */
-	  set_attrib(tree, "href", e->data);
-	} else {
-	  tree = wrap_elt(tree, "a", NULL);	/* Wrap element in an <a> */
-	  set_attrib(tree, "href", e->data);
-	}
-	dispose(key);
-      } else {					/* Not an inline element */
-	find_instances(tree->children, lang);	/* Recurse over children */
+  Cursor c;
+
+  for (cursor_start(&c, tree); c.node; cursor_next(&c)) {
+    tree = c.node;
+    if (c.leaving || tree->tp != Element) continue;
+    if (tree->name == a_a || tree->name == a_dfn) {
+      cursor_skip(&c);				/* Don't descend into these */
+    } else if (is_inline(tree->name)) {
+      if ((title = get_attrib(tree, "title")))	/* Use title if it exists */
+	key = newstring(title);
+      else					/* Get flattened contents */
+	key = get_contents(tree);
+      if (!(e = search(normalize(key), lang_of(tree)))) {
+	;					/* Not an instance, descend */
+      } else if (tree->name == a_span) {	/* Found an instance */
+	rename_elt(tree, "a");			/* Turn the span into an a */
+	set_attrib(tree, "href", e->data);
+	cursor_skip(&c);
+      } else {
+	/* Wrap element in an <a>. The cursor then continues by leaving
+	   the <a> and going on with the sister that followed tree */
+	set_attrib(wrap_elt(tree, "a", NULL), "href", e->data);
+	cursor_skip(&c);
       }
-      find_instances(tree->sister, language);	/* Recurse over siblings */
-      break;
-    default:
-      assert(!"Cannot happen");
+      dispose(key);
+    }
   }
 }
 
@@ -405,7 +424,7 @@ static void write_doc(Tree n, bool do_xml, FILE *f)
 	if (h->value != NULL) fprintf(f, "=\"%s\"", h->value);
 	else if (do_xml) fprintf(f, "=\"%s\"", h->name);
       }
-      if (is_empty(n->name)) {
+      if (elt_flags(n) & ELT_EMPTY) {
 	assert(n->children == NULL);
 	fprintf(f, do_xml ? " />" : ">");
       } else {
@@ -424,7 +443,7 @@ static void write_doc(Tree n, bool do_xml, FILE *f)
 static void usage(void)
 {
   fprintf(stderr,
-	  "Usage: %s [-v] [-b base] [-i index] [-x] [-l] [--] [input [output]]\n",
+	  "Usage: %s [-v] [-b base] [-i index] [-x] [-l] [-S] [--] [input [output]]\n",
 	  progname);
   exit(1);
 }
@@ -448,6 +467,8 @@ int main(int argc, char *argv[])
   set_emptytag_handler(handle_emptytag);
   set_endtag_handler(handle_endtag);
 
+  init_atoms();
+
   /* Parse command line */
   progname = argv[0];
   yyin = NULL;
@@ -472,6 +493,10 @@ int main(int argc, char *argv[])
 	if (use_language) usage(); 		/* Option was already set */
 	use_language = true;
 	break;
+      case 'S':
+	if (snapshot) usage();			/* Option was already set */
+	snapshot = true;
+	break;
       case 'v':
 	printf("Version: %s %s\n", PACKAGE, VERSION);
 	return 0;
@@ -517,11 +542,13 @@ int main(int argc, char *argv[])
   
   tree = get_root(tree);
   collect_terms(tree, db);
-  find_instances(tree, NULL);
+  find_instances(tree);
 
   if (db) fclose(db);
 
-  write_doc(tree, do_xml, outfile);
+  if (!snapshot) write_doc(tree, do_xml, outfile);
+  else if (!write_snapshot(tree, outfile))
+    errexit("%s: %s\n", progname, strerror(errno));
 
   return 0;
 }
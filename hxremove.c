@@ -34,6 +34,7 @@
 #include "html.e"
 #include "scan.e"
 #include "selmatch.e"
+#include "batch.e"
 
 
 static Selector selector;			/* The selector to match */
@@ -43,13 +44,26 @@ static Selector selector;			/* The selector to match */
 static void print_tree(Tree t)
 {
   pairlist p;
-
-  if (!t) return;
-
-  switch (t->tp) {
-  case Element:
-    /* Print the element, unless it matches the selector */
-    if (!matches_sel(t, selector)) {
+  Cursor c;
+
+  for (cursor_start(&c, t); c.node; cursor_next(&c)) {
+    t = c.node;
+    if (c.leaving) {
+      if (t->tp == Root) {
+	match_leave();
+      } else if (t->tp == Element && t->children) {
+	match_leave();
+	printf("</%s>", t->name);
+      }
+      continue;
+    }
+    switch (t->tp) {
+    case Element:
+      /* Print the element, unless it matches the selector */
+      if (matches_sel(t, selector)) {
+	cursor_skip(&c);
+	break;
+      }
       printf("<%s", t->name);
       /* Print each attribute, unless it matches the selector */
       for (p = t->attribs; p; p = p->next)
@@ -61,34 +75,32 @@ static void print_tree(Tree t)
 	printf("/>");
       } else {
 	printf(">");
-	print_tree(t->children);
-	printf("</%s>", t->name);
+	match_enter(t);
       }
+      break;
+    case Text:
+      printf("%s", t->text);
+      break;
+    case Comment:
+      printf("<!--%s-->", t->text);
+      break;
+    case Declaration:
+      printf("<!DOCTYPE %s", t->name);
+      if (t->text && t->url) printf(" PUBLIC \"%s\" \"%s\"", t->text, t->url);
+      else if (t->text) printf(" PUBLIC \"%s\"", t->text);
+      else if (t->url) printf(" SYSTEM \"%s\"", t->url);
+      printf(">");
+      break;
+    case Procins:
+      printf("<?%s>", t->text);
+      break;
+    case Root:
+      match_reset();
+      match_enter(t);
+      break;
+    default: assert(!"Cannot happen!");
     }
-    break;
-  case Text:
-    printf("%s", t->text);
-    break;
-  case Comment:
-    printf("<!--%s-->", t->text);
-    break;
-  case Declaration:
-    printf("<!DOCTYPE %s", t->name);
-    if (t->text && t->url) printf(" PUBLIC \"%s\" \"%s\"", t->text, t->url);
-    else if (t->text) printf(" PUBLIC \"%s\"", t->text);
-    else if (t->url) printf(" SYSTEM \"%s\"", t->url);
-    printf(">");
-    break;
-  case Procins:
-    printf("<?%s>", t->text);
-    break;
-  case Root:
-    print_tree(t->children);
-    break;
-  default: assert(!"Cannot happen!");
   }
-
-  print_tree(t->sister);
 }
 
 
@@ -105,6 +117,7 @@ static void handle_error(void *clientdata, const string s, int lineno)
 static void* handle_start(void)
 {
   Tree *tp;
+
   new(tp);
   *tp = create();		/* Create an empty tree */
   return tp;
@@ -116,7 +129,6 @@ static void handle_end(void *clientdata)
 {
   Tree *t = (Tree*)clientdata;
   print_tree(get_root(*t)); /* Print tree, filtering out unwanted elements */
-  tree_delete(*t);
 }
 
 
@@ -186,21 +198,35 @@ static void handle_endtag(void *clientdata, const string name)
 /********************* End of parser callbacks *********************/
 
 
+/* process -- parse one document and print it filtered, return status */
+static int process(void)
+{
+  return yyparse() != 0 ? 3 : 0;
+}
+
+
 /* usage -- print usage message and exit */
 static void usage(const conststring progname)
 {
-  errexit("Usage: %s [-v] [-l language] [-i] selector\n", progname);
+  errexit("Usage: %s [-v] [-l language] [-i] selector\n\
+       %s -B [-j jobs] [-l language] [-i] selector [input output...]\n",
+	  progname, progname);
 }
 
 
 int main(int argc, char *argv[])
 {
+  bool batch_mode = false;
+  int jobs = 1;
+  Arena arena;
   string s;
   int c;
 
   /* Command line options */
-  while ((c = getopt(argc, argv, "il:v")) != -1) {
+  while ((c = getopt(argc, argv, "il:vBj:")) != -1) {
     switch (c) {
+    case 'B': batch_mode = true; break;
+    case 'j': jobs = atoi(optarg); break;
     case 'l': init_language(optarg); break;
     case 'i': set_case_insensitive();  break;
     case 'v': printf("Version: %s %s\n", PACKAGE, VERSION); return 0;
@@ -223,13 +249,19 @@ int main(int argc, char *argv[])
 
   /* Parse the selector */
   if (optind >= argc) usage(argv[0]);		/* Need at least 1 arg */
-  for (s = newstring(argv[optind++]); optind < argc; optind++)
+  if (batch_mode) s = newstring(argv[optind++]); /* Files follow selector */
+  else for (s = newstring(argv[optind++]); optind < argc; optind++)
     strapp(&s, " ", argv[optind], NULL);
   selector = parse_selector(s, &s);
   if (*s) errexit("Syntax error at \"%c\"\n", *s);
 
+  if (batch_mode) return batch(argc, argv, optind, jobs, process);
+
   /* Parse the input, build a tree, filter the tree */
+  arena = arena_new();				/* Holds the whole document */
+  (void) arena_use(arena);
   yyin = stdin;
-  if (yyparse() != 0) exit(3);
+  if (process() != 0) exit(3);
+  arena_delete(arena);
   return 0;
 }
@@ -31,6 +31,22 @@
  *     matched element are printed as well; with -c only the contents
  *     of the matched element are printed.
  *
+ * -f file
+ *
+ *     Read selectors from file, one per line, instead of from the
+ *     command line. A line may start with a label and a tab. Each
+ *     match is preceded by the label of the selector that it
+ *     matched, or the line number if it has no label, and a tab. The
+ *     document is read only once, however many selectors there are.
+ *
+ * Unless the selector uses pseudo-classes that depend on what comes
+ * after an element's start tag (:last-child, :empty, etc.), elements
+ * are matched as soon as their start tag is parsed and printed as
+ * soon as their end tag is parsed. The content of elements that have
+ * ended is then discarded, so the memory needed depends on the depth
+ * of the document, not its size. Otherwise, the whole document is
+ * read into a tree first.
+ *
  * TODO: Escape double quotes when printing an attribute that matches
  * ::attr().
  *
@@ -71,22 +87,34 @@
 #include "html.e"
 #include "scan.e"
 #include "selmatch.e"
+#include "batch.e"
+#include "outbuf.e"
+
 
+typedef struct {
+  Tree t;					/* A matched element */
+  int rule;					/* The rule it matched */
+  Selector sel;					/* If it matched a pseudo-element */
+} Pending;
 
 static Tree tree = NULL;			/* Current elt in tree */
-static Selector selector;			/* The selector to match */
+static RuleSet rules;				/* The selectors to match */
+static bool labelled = false;			/* Print rule labels? */
 static bool content_only = false;		/* Omit start/end tag */
 static string separator = "";			/* Printed between matches */
+static bool streaming;				/* Match while parsing? */
+static bool keep_sisters;			/* Selector needs old sisters? */
+static Pending *pending = NULL;			/* Matches not yet printed */
+static int npending = 0;			/* Length of pending */
+static Outbuf out;				/* Buffer for stdout */
 
 
 /* print_starttag -- print a start tag */
 static void print_starttag(Node *n)
 {
-  pairlist p;
-
-  printf("<%s", n->name);
-  for (p = n->attribs; p; p = p->next) printf(" %s=\"%s\"", p->name, p->value);
-  putchar('>');
+  outbuf_wrap(out, "<", n->name, "");
+  outbuf_attribs(out, n->attribs);
+  outbuf_putc(out, '>');
 }
 
 
@@ -97,106 +125,178 @@ static void printsep(const string separator)
   int c;
 
   while (*s) {
-    if (*s != '\\') putchar(*(s++));
+    if (*s != '\\') outbuf_putc(out, *(s++));
     else if ('0' <= *(++s) && *s <= '7') {
       c = *s - '0';
       if ('0' <= *(++s) && *s <= '7') {
 	c = 8 * c + *s - '0';
 	if ('0' <= *(++s) && *s <= '7') c = 8 * c + *s - '0';
       }
-      putchar(c); s++;
+      outbuf_putc(out, c); s++;
     } else
       switch (*s) {
-      case '\0': putchar('\\'); break;
-      case 'n': putchar('\n'); s++; break;
-      case 't': putchar('\t'); s++; break;
-      case 'r': putchar('\r'); s++; break;
-      case 'f': putchar('\f'); s++; break;
-      default: putchar(*(s++)); break;
+      case '\0': outbuf_putc(out, '\\'); break;
+      case 'n': outbuf_putc(out, '\n'); s++; break;
+      case 't': outbuf_putc(out, '\t'); s++; break;
+      case 'r': outbuf_putc(out, '\r'); s++; break;
+      case 'f': outbuf_putc(out, '\f'); s++; break;
+      default: outbuf_putc(out, *(s++)); break;
       }
   }
 }
 
 
-/* print_recursively -- print the element t, its children and sisters */
-static void print_recursively(Tree t)
+/* print_nodes -- print t, its sisters and all their descendants */
+static void print_nodes(Tree t)
 {
-  if (!t) return;
-
-  switch (t->tp) {
-  case Element:
-    print_starttag(t);
-    print_recursively(t->children);
-    printf("</%s>", t->name);
-    break;
-  case Text: printf("%s", t->text); break;
-  case Comment: printf("<!--%s-->", t->text); break;
-  case Declaration: assert(!"Cannot happen"); break;
-  case Procins: printf("<?%s>", t->text); break;
-  case Root: print_recursively(t->children); break;
-  default: assert(!"Cannot happen");
+  Cursor c;
+
+  for (cursor_start(&c, t); c.node; cursor_next(&c)) {
+    t = c.node;
+    if (c.leaving) {
+      if (t->tp == Element) outbuf_wrap(out, "</", t->name, ">");
+      continue;
+    }
+    switch (t->tp) {
+    case Element: print_starttag(t); break;
+    case Text: outbuf_puts(out, t->text); break;
+    case Comment: outbuf_wrap(out, "<!--", t->text, "-->"); break;
+    case Declaration: assert(!"Cannot happen"); break;
+    case Procins: outbuf_wrap(out, "<?", t->text, ">"); break;
+    case Root: break;
+    default: assert(!"Cannot happen");
+    }
   }
+}
+
 
-  print_recursively(t->sister);
+/* print_label -- print the label of a rule, if labels are wanted */
+static void print_label(int rule)
+{
+  if (labelled) outbuf_wrap(out, "", ruleset_label(rules, rule), "\t");
 }
 
 
 /* print_tree -- print the element t, with or without its tags */
-static void print_tree(Tree t)
+static void print_tree(Tree t, int rule)
 {
   assert(t->tp == Element);
+  print_label(rule);
   if (!content_only) print_starttag(t);
-  print_recursively(t->children);
-  if (!content_only) printf("</%s>", t->name);
+  print_nodes(t->children);
+  if (!content_only) outbuf_wrap(out, "</", t->name, ">");
   printsep(separator);
 }
 
 
-/* match_pseudoelts -- print pseudo-elements of node t that match the selector */
-static void match_pseudoelts(Tree t)
+/* print_pseudoelt -- print pseudo-element of t selected by sel, if any */
+static void print_pseudoelt(Tree t, Selector sel, int rule)
 {
   pairlist p;
 
-  assert(selector->pseudoelts);
-
   /* ::attr() is the only pseudo-element we can handle so far */
-  if (selector->pseudoelts->type == AttrNode) {
-    assert(selector->combinator == Child && selector->context);
+  if (sel->pseudoelts->type == AttrNode) {
+    assert(sel->combinator == Child && sel->context);
     p = t->attribs;
-    while (p && !same(p->name, selector->pseudoelts->s)) p = p->next;
-    if (p && matches_sel(t, selector->context)) {
-      if (!content_only) printf("%s=\"", p->name);
-      printf("%s", p->value);
-      if (!content_only) printf("\"");
+    while (p && !same(p->name, sel->pseudoelts->s)) p = p->next;
+    if (p) {
+      print_label(rule);
+      if (!content_only) outbuf_wrap(out, "", p->name, "=\"");
+      if (p->value) outbuf_puts(out, p->value);
+      if (!content_only) outbuf_puts(out, "\"");
       printsep(separator);
     }
   }
 }
 
 
-/* walk_tree -- find all nodes in the tree that match the selector */
+/* print_match -- print a match that was kept in pending */
+static void print_match(const Pending *p)
+{
+  if (p->sel) print_pseudoelt(p->t, p->sel, p->rule);
+  else print_tree(p->t, p->rule);
+}
+
+
+/* add_pending -- remember a match, to print when its element is complete */
+static void add_pending(Tree t, int rule, Selector sel)
+{
+  renewarray(pending, npending + 1);
+  pending[npending].t = t;
+  pending[npending].rule = rule;
+  pending[npending++].sel = sel;
+}
+
+
+/* match_element -- print or remember the matches of t, once per rule */
+static void match_element(Tree t)
+{
+  RuleMatch *m;
+  int i, n, last = -1;
+
+  /* When streaming, a match inside an element that is still pending
+     waits, too, so that the output is in the same order as without */
+  n = ruleset_match(rules, t, &m);
+  for (i = 0; i < n; i++)
+    if (m[i].sel->pseudoelts) {			/* Attribute */
+      if (!streaming || npending == 0) print_pseudoelt(t, m[i].sel, m[i].rule);
+      else add_pending(t, m[i].rule, m[i].sel);
+    } else if (m[i].rule != last) {		/* Element, if not yet */
+      last = m[i].rule;
+      if (!streaming) print_tree(t, last);
+      else add_pending(t, last, NULL);
+    }
+}
+
+
+/* walk_tree -- find all nodes in the tree that match the selectors */
 static void walk_tree(Tree t)
 {
-  if (!t) return;
-
-  switch (t->tp) {
-  case Element:
-    if (selector->pseudoelts) match_pseudoelts(t);
-    else if (matches_sel(t, selector)) print_tree(t);
-    walk_tree(t->children);
-    break;
-  case Text: break;
-  case Comment: break;
-  case Declaration: break;
-  case Procins: break;
-  case Root: walk_tree(t->children); break;
-  default: assert(!"Cannot happen");
+  Cursor c;
+
+  for (cursor_start(&c, t); c.node; cursor_next(&c)) {
+    t = c.node;
+    switch (t->tp) {
+    case Element:
+      if (c.leaving) {match_leave(); break;}
+      match_element(t);
+      match_enter(t);
+      break;
+    case Text: break;
+    case Comment: break;
+    case Declaration: break;
+    case Procins: break;
+    case Root: if (c.leaving) match_leave(); else match_enter(t); break;
+    default: assert(!"Cannot happen");
+    }
   }
+}
+
+
 
-  walk_tree(t->sister);
+/* start_element -- check a newly started element against the selectors */
+static void start_element(Tree t)
+{
+  match_element(t);
+  match_enter(t);
 }
 
 
+/* end_element -- print matches that are complete, discard old content */
+static void end_element(Tree t)
+{
+  int i;
+
+  match_leave();
+  if (npending) {
+    if (pending[0].t != t) return;	/* Inside a match, keep everything */
+    for (i = 0; i < npending; i++) print_match(&pending[i]);
+    npending = 0;			/* All others were inside pending[0] */
+  }
+  tree_delete_children(t);
+  if (!keep_sisters) tree_delete_before(t);
+}
+
 
 /*********************** Parser callback API ***********************/
 
@@ -211,6 +311,9 @@ static void handle_error(void *clientdata, const string s, int lineno)
 static void* handle_start(void)
 {
   tree = create();
+  npending = 0;
+  match_reset();
+  if (streaming) match_enter(tree);
   return NULL;
 }
 
@@ -218,15 +321,22 @@ static void* handle_start(void)
 /* handle_end -- called after the last event is reported */
 static void handle_end(void *clientdata)
 {
-  walk_tree(tree);	       /* Find all matches for the selector */
-  tree_delete(tree);	       /* Clean up */
+  int i;
+
+  if (!streaming) {
+    walk_tree(tree);		/* Find all matches for the selectors */
+  } else {
+    for (i = 0; i < npending; i++)	/* Elements that were not closed */
+      print_match(&pending[i]);
+    tree_delete(get_root(tree));
+  }
 }
 
 
 /* handle_comment -- called after a comment is parsed */
 static void handle_comment(void *clientdata, const string commenttext)
 {
-  free(commenttext);
+  heap_free(commenttext);
 }
 
 
@@ -241,16 +351,16 @@ static void handle_text(void *clientdata, const string text)
 static void handle_decl(void *clientdata, const string gi, const string fpi,
 			const string url)
 {
-  free(gi);
-  free(fpi);
-  free(url);
+  heap_free(gi);
+  heap_free(fpi);
+  heap_free(url);
 }
 
 
 /* handle_pi -- called after a Processing Instruction is parsed */
 static void handle_pi(void *clientdata, const string pi_text)
 {
-  free(pi_text);
+  heap_free(pi_text);
 }
 
 
@@ -259,7 +369,8 @@ static void handle_starttag(void *clientdata, const string name,
 			    pairlist attribs)
 {
   tree = tree_push(tree, name, attribs);	/* Add to tree */
-  free(name);
+  if (streaming) start_element(tree);
+  heap_free(name);
 }
 
 
@@ -267,17 +378,24 @@ static void handle_starttag(void *clientdata, const string name,
 static void handle_emptytag(void *clientdata, const string name,
 			    pairlist attribs)
 {
-  tree = tree_push(tree, name, attribs);	/* Add to tree */
+  Tree t;
+
+  t = tree = tree_push(tree, name, attribs);	/* Add to tree */
+  if (streaming) start_element(t);
   tree = tree_pop(tree, name);			/* Remove from tree again */
-  free(name);
+  if (streaming) end_element(t);
+  heap_free(name);
 }
 
 
 /* handle_endtag -- called after an endtag is parsed (name may be "") */
 static void handle_endtag(void *clientdata, const string name)
 {
+  Tree t = tree;
+
   tree = tree_pop(tree, name);
-  free(name);
+  if (streaming) end_element(t);
+  heap_free(name);
 }
 
 
@@ -287,23 +405,55 @@ static void handle_endtag(void *clientdata, const string name)
 /********************* End of parser callbacks *********************/
 
 
+/* process -- parse one document and print the matches, return status */
+static int process(void)
+{
+  Arena prev;
+  int r;
+
+  out = outbuf_stdout();
+  if (!streaming) {
+    r = yyparse() != 0 ? 3 : 0;
+  } else {
+    /* Discarded content must really be freed, so don't use an arena */
+    prev = arena_use(NULL);
+    r = yyparse() != 0 ? 3 : 0;
+    (void) arena_use(prev);
+  }
+  if (!outbuf_flush(out)) {perror("stdout"); return 2;}
+  return r;
+}
+
+
 /* usage -- print usage message and exit */
 static void usage(const conststring progname)
 {
-  errexit("Usage: %s [-v] [-i] [-c] [-l language] [-s separator] selector\n",
-	  progname);
+  errexit("Usage: %s [-v] [-i] [-c] [-l language] [-s separator] selector\n\
+       %s [-v] [-i] [-c] [-l language] [-s separator] -f file\n\
+       %s -B [-j jobs] [-i] [-c] [-l language] [-s separator] selector [input output...]\n\
+       %s -B [-j jobs] [-i] [-c] [-l language] [-s separator] -f file [input output...]\n",
+	  progname, progname, progname, progname);
 }
 
 
 int main(int argc, char *argv[])
 {
+  bool batch_mode = false;
+  string rulefile = NULL;
+  Selector selector;
+  int jobs = 1;
+  Arena arena;
   string s;
-  int c;
+  FILE *f;
+  int c, status;
 
   /* Command line options */
-  while ((c = getopt(argc, argv, "icl:s:v")) != -1) {
+  while ((c = getopt(argc, argv, "icf:l:s:vBj:")) != -1) {
     switch (c) {
+    case 'B': batch_mode = true; break;
+    case 'j': jobs = atoi(optarg); break;
     case 'c': content_only = true; break;
+    case 'f': rulefile = optarg; break;
     case 'l': init_language(optarg); break;
     case 's': separator = optarg; break;
     case 'i': set_case_insensitive();  break;
@@ -325,15 +475,33 @@ int main(int argc, char *argv[])
   set_emptytag_handler(handle_emptytag);
   set_endtag_handler(handle_endtag);
 
-  /* Parse the selector */
-  if (optind >= argc) usage(argv[0]);		/* Need at least 1 arg */
-  for (s = newstring(argv[optind++]); optind < argc; optind++)
-    strapp(&s, " ", argv[optind], NULL);
-  selector = parse_selector(s, &s);
-  if (*s) errexit("Syntax error at \"%c\"\n", *s);
+  /* Read the selectors from a file or parse the one on the command line */
+  rules = ruleset_create();
+  if (rulefile) {
+    if (!batch_mode && optind < argc) usage(argv[0]);
+    if (!(f = fopen(rulefile, "r"))) {perror(rulefile); exit(2);}
+    ruleset_read(rules, f, rulefile);
+    fclose(f);
+    labelled = true;
+  } else {
+    if (optind >= argc) usage(argv[0]);		/* Need at least 1 arg */
+    if (batch_mode) s = newstring(argv[optind++]); /* Files follow selector */
+    else for (s = newstring(argv[optind++]); optind < argc; optind++)
+      strapp(&s, " ", argv[optind], NULL);
+    selector = parse_selector(s, &s);
+    if (*s) errexit("Syntax error at \"%c\"\n", *s);
+    (void) ruleset_add(rules, selector, "");
+  }
+  streaming = !ruleset_looks_ahead(rules);
+  keep_sisters = ruleset_looks_behind(rules);
+
+  if (batch_mode) return batch(argc, argv, optind, jobs, process);
 
   /* Walk the tree */
+  arena = arena_new();				/* Holds the whole document */
+  (void) arena_use(arena);
   yyin = stdin;
-  if (yyparse() != 0) exit(3);
-  return 0;
+  status = process();
+  arena_delete(arena);
+  return status;
 }
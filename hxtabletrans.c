@@ -139,7 +139,7 @@ static void print_start(Tree t)
   for (p = t->attribs; p; p = p->next)
     if (p->value) printf(" %s=\"%s\"", p->name, p->value);
     else printf(" %s", p->name);
-  if (do_xml && is_empty(t->name)) printf("/>"); else printf(">");
+  if (do_xml && (elt_flags(t) & ELT_EMPTY)) printf("/>"); else printf(">");
 }
 
 
@@ -150,7 +150,7 @@ static void print_tree(Tree t)
     switch (t->tp) {
     case Element:
       print_start(t);
-      if (!is_empty(t->name)) {
+      if (!(elt_flags(t) & ELT_EMPTY)) {
 	print_tree(t->children);
 	printf("</%s>", t->name);
       }
@@ -282,13 +282,18 @@ static bool transpose_content(const Tree t, Tree *result)
   (*result)->parent = t->parent;
   (*result)->children = q;
   (*result)->sister = r;
+  (*result)->prev = (*result)->lastchild = NULL;
+  (*result)->index = t->index;
+  (*result)->type = t->type;
+  for (; q; q = q->sister) (*result)->lastchild = q;
+  if (r) r->prev = *result;
   if (t->tp == Comment || t->tp == Procins || t->tp == Declaration)
     (*result)->text = newstring(t->text);
   else
     (*result)->text = s;
   if (t->tp == Declaration) (*result)->url = newstring(t->url);
-  if (t->tp == Element || t->tp == Declaration)
-    (*result)->name = newstring(t->name);
+  if (t->tp == Element) (*result)->name = t->name; /* An atom */
+  if (t->tp == Declaration) (*result)->name = newstring(t->name);
   if (t->tp == Element) (*result)->attribs = pairlist_copy(t->attribs);
   return true;
 }
@@ -67,6 +67,7 @@
 #include "errexit.e"
 #include "genid.e"
 #include "class.e"
+#include "batch.e"
 
 #define BEGIN_TOC "begin-toc"			/* <!--begin-toc--> */
 #define END_TOC "end-toc"			/* <!--end-toc--> */
@@ -415,14 +416,14 @@ static void expand(Tree t, bool *write, bool exp, bool keep_anchors,
 		if (a->value != NULL) printf("=\"%s\"", a->value);
 	      }
 	    }
-	    if (is_empty(h->name)) {
+	    if (elt_flags(h) & ELT_EMPTY) {
 	      assert(h->children == NULL);
 	      printf(xml ? " />" : ">");
 	    } else {
 	      printf(">");
 	      /* Insert an <A NAME> if element has an ID and is not <A> */
-	      if (bctarget && is_mixed(h->name) && (val = get_attrib(h, "id"))
-		  && !eq(h->name, "a") && ! xml)
+	      if (bctarget && (elt_flags(h) & ELT_MIXED)
+		  && (val = get_attrib(h, "id")) && !eq(h->name, "a") && ! xml)
 		printf("<a class=\"%s\" name=\"%s\"></a>", TARGET, val);
 	      expand(h, write, exp, keep_anchors, div_depth, flatten);
 	      printf("</%s>", h->name);
@@ -439,21 +440,38 @@ static void expand(Tree t, bool *write, bool exp, bool keep_anchors,
   }
 }
 
+/* process -- parse one document and print it with a ToC, return status */
+static int process(void)
+{
+  bool write = true;
+
+  if (yyparse() != 0) return 3;
+  tree = get_root(tree);
+  expand(tree, &write, EXPAND, KEEP_ANCHORS, 1, DONT_FLATTEN);
+  reset_ids();
+  return 0;
+}
+
 /* usage -- print usage message and exit */
 static void usage(string name)
 {
-  errexit("Version %s\nUsage: %s [-l low] [-h high] [-x] [-t] [-d] [-c class] [html-file]\n",
-	  VERSION, name);
+  errexit("Version %s\nUsage: %s [-l low] [-h high] [-x] [-t] [-d] [-c class] [html-file]\n\
+       %s -B [-j jobs] [options] [input output...]\n",
+	  VERSION, name, name);
 }
 
 
 int main(int argc, char *argv[])
 {
   int c, status;
-  bool write = true;
+  Arena arena;
+  bool batch_mode = false;
+  int jobs = 1;
 
-  while ((c = getopt(argc, argv, "l:h:xtdc:f")) != -1) {
+  while ((c = getopt(argc, argv, "l:h:xtdc:fBj:")) != -1) {
     switch (c) {
+    case 'B': batch_mode = true; break;
+    case 'j': jobs = atoi(optarg); break;
     case 'l': toc_low = atoi(optarg); break;
     case 'h': toc_high = atoi(optarg); break;
     case 'x': xml = true; break;
@@ -466,16 +484,6 @@ int main(int argc, char *argv[])
   }
   if (toc_low < 1) toc_low = 1;
 
-  if (argc > optind + 1) {
-    usage(argv[0]);
-  } else if (optind >= argc || eq(argv[optind], "-")) {
-    yyin = stdin;
-  } else if (!(yyin = fopenurl(argv[optind], "r", &status))) {
-    perror(argv[optind]); exit(2);
-  } else if (status != 200) {
-    errexit("%s : %s\n", argv[optind], http_strerror(status));
-  }
-
   /* Bind the parser callback routines to our handlers */
   set_error_handler(handle_error);
   set_start_handler(start);
@@ -488,12 +496,21 @@ int main(int argc, char *argv[])
   set_emptytag_handler(handle_emptytag);
   set_endtag_handler(handle_endtag);
 
-  if (yyparse() != 0) exit(3);
+  if (batch_mode) return batch(argc, argv, optind, jobs, process);
 
-  tree = get_root(tree);
-  expand(tree, &write, EXPAND, KEEP_ANCHORS, 1, DONT_FLATTEN);
-#if 0
-  tree_delete(tree);				/* Just to test memory mgmt */
-#endif
+  if (argc > optind + 1) {
+    usage(argv[0]);
+  } else if (optind >= argc || eq(argv[optind], "-")) {
+    yyin = stdin;
+  } else if (!(yyin = fopenurl(argv[optind], "r", &status))) {
+    perror(argv[optind]); exit(2);
+  } else if (status != 200) {
+    errexit("%s : %s\n", argv[optind], http_strerror(status));
+  }
+
+  arena = arena_new();				/* Holds the whole document */
+  (void) arena_use(arena);
+  if (process() != 0) exit(3);
+  arena_delete(arena);				/* Frees the tree in one go */
   return 0;
 }
@@ -341,6 +341,7 @@ int main(int argc, char *argv[])
   if (yyin == NULL) {perror(argv[optind]); exit(1);}
   if (status != 200) errexit("%s : %s\n", argv[optind], http_strerror(status));
 
+  set_event_mask(EVENT_VALUE);			/* Only tags are needed */
   if (yyparse() != 0) exit(3);
 
   if (base) free(base);
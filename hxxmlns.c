@@ -285,6 +285,7 @@ int main(int argc, char *argv[])
   if (yyin == NULL) {perror(argv[i]); exit(1);}
   if (status != 200) errexit("%s : %s\n", argv[i], http_strerror(status));
 
+  if (!do_decls) set_event_mask(EVENT_TEXT | EVENT_VALUE);
   if (yyparse() != 0) exit(3);
 
   return has_error ? 1 : 0;
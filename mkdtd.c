@@ -0,0 +1,244 @@
+/* mkdtd.c -- write the element type tables of tree.c, from dtd.hash
+ *
+ * The element types in dtd.hash are numbered in the order in which
+ * they appear there, from 1. (Type 0 is that of all unknown
+ * elements.) The program writes, as C code, a table with the flags
+ * and the possible parents of each type, a hash table from element
+ * names to types and a table that says for each pair of types how an
+ * element of the one can be put into an element of the other,
+ * possibly by adding omitted start tags in between. tree.c includes
+ * the result, so that nothing has to be looked up or computed at run
+ * time.
+ *
+ * A parent that is not itself an element in dtd.hash is of type 0,
+ * except that the preferred (first) parent must be an element.
+ *
+ * The names are read from dtd.hash itself, the rest of the information
+ * comes from lookup_element() in dtd.c, which gperf made from the same
+ * file, so that the macros in the parent lists are already expanded.
+ *
+ * Usage: mkdtd dtd.hash > dtdtypes.h
+ *
+ * Part of HTML-XML-utils, see:
+ * http://www.w3.org/Tools/HTML-XML-utils/
+ *
+ * Copyright © 2026 World Wide Web Consortium
+ * See http://www.w3.org/Consortium/Legal/copyright-software
+ *
+ * Author: agent <agent@local>
+ * Created: 17 Oct 2026
+ **/
+#include "config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <ctype.h>
+#ifdef HAVE_STRING_H
+#  include <string.h>
+#elif HAVE_STRINGS_H
+#  include <strings.h>
+#endif
+#include "export.h"
+#include "types.e"
+#include "dtd.e"
+
+#define MAXTYPES 252		/* PATH_VIA + type must fit in an unsigned char */
+#define NHASH 256		/* Size of the hash table, a power of 2 */
+#define MAXLINE 1024
+#define NBITS ((MAXTYPES + 32)/32)
+
+/* How an element of type c can be added to an element of type p */
+#define PATH_NONE 1		/* Not even by adding omitted start tags */
+#define PATH_DIRECT 2		/* As a child */
+#define PATH_VIA 3		/* PATH_VIA + q: as child of an implied q */
+
+static const ElementType *info[MAXTYPES + 1]; /* Entry in dtd.hash per type */
+static int ntypes = 1;				/* Type 0 is unknown */
+static unsigned char hash[NHASH];		/* Type by hash of name */
+static uint32_t parents[MAXTYPES + 1][NBITS];	/* Bits for possible parents */
+static bool visiting[MAXTYPES + 1];		/* Types on find_path()'s path */
+
+
+/* name_hash -- compute a hash of an element name (FNV-1a), as tree.c does */
+static uint32_t name_hash(const char *s)
+{
+  const unsigned char *p;
+  uint32_t h = 2166136261U;
+
+  for (p = (const unsigned char *)s; *p; p++) h = (h ^ tolower(*p)) * 16777619U;
+  return h;
+}
+
+
+/* type_of -- return the type of element name, or 0 if there is none */
+static int type_of(const char *name)
+{
+  int i;
+
+  for (i = 1; i < ntypes; i++) if (strcmp(info[i]->name, name) == 0) return i;
+  return 0;
+}
+
+
+/* read_names -- read the element names from dtd.hash and number them */
+static void read_names(FILE *f, const char *file)
+{
+  char line[MAXLINE], *s, *e;
+  int section = 0;
+  uint32_t h;
+
+  while (section < 2 && fgets(line, sizeof(line), f)) {
+    if (strncmp(line, "%%", 2) == 0) {section++; continue;}
+    if (section == 0 || line[0] == '#' || line[0] == '\n') continue;
+    s = line + (line[0] == '"');		/* Name may be quoted */
+    e = s + strcspn(s, "\",");
+    *e = '\0';
+    if (ntypes > MAXTYPES) {
+      fprintf(stderr, "%s: more than %d elements\n", file, MAXTYPES);
+      exit(1);
+    }
+    if (!(info[ntypes] = lookup_element(s, strlen(s)))) {
+      fprintf(stderr, "%s: element \"%s\" not found by gperf\n", file, s);
+      exit(1);
+    }
+    for (h = name_hash(s) & (NHASH - 1); hash[h]; h = (h + 1) & (NHASH - 1)) ;
+    hash[h] = ntypes++;
+  }
+}
+
+
+/* find_parents -- set the bits of the possible parents of each type */
+static void find_parents(const char *file)
+{
+  int i, k, n;
+
+  for (i = 1; i < ntypes; i++)
+    for (n = 0; info[i]->parents[n]; n++)
+      if ((k = type_of(info[i]->parents[n])))
+	parents[i][k/32] |= (uint32_t)1 << (k % 32);
+      else if (n == 0) {			/* tree.c may have to create it */
+	fprintf(stderr, "%s: parent \"%s\" of \"%s\" is not an element\n",
+		file, info[i]->parents[n], info[i]->name);
+	exit(1);
+      }
+}
+
+
+/* find_path -- return how type c can be put under type p, see PATH_* */
+static int find_path(int c, int p)
+{
+  int n, q, result = PATH_NONE;
+
+  if ((parents[c][p/32] >> (p % 32)) & 1) return PATH_DIRECT;
+
+  /* Try recursively if any possible parent with an omissible start
+     tag can be put under p, the preferred parents first */
+  visiting[c] = true;
+  for (n = 0; result == PATH_NONE && info[c]->parents[n]; n++) {
+    q = type_of(info[c]->parents[n]);
+    if (q && !visiting[q] && !info[q]->stag && find_path(q, p) != PATH_NONE)
+      result = PATH_VIA + q;
+  }
+  visiting[c] = false;
+  return result;
+}
+
+
+/* write_types -- write the table of element types */
+static void write_types(const char *file)
+{
+  int i, j, n, maxparents = 1;
+  const ElementType *t;
+
+  for (i = 1; i < ntypes; i++) {
+    for (n = 0; info[i]->parents[n]; n++) ;
+    if (n > maxparents) maxparents = n;
+  }
+
+  printf("/* Element types. Generated by mkdtd from %s, don't edit */\n\n",
+	 file);
+  printf("#define NTYPES %d\t\t/* Number of types, including 0 */\n", ntypes);
+  printf("#define NHASH %d\t\t/* Size of type_hash[] */\n", NHASH);
+  printf("#define DATA_TYPE %d\t\t/* Type of \"%%data\" */\n\n",
+	 type_of("%data"));
+  printf("typedef struct {\n"
+	 "  const char *name;\t\t/* Name, in lowercase */\n"
+	 "  unsigned int flags;\t\t/* ELT_* */\n"
+	 "  uint32_t parents[%d];\t/* Bits for types that can be a parent */\n"
+	 "  unsigned char order[%d];\t/* Those types, preferred first */\n"
+	 "  int nparents;\t\t\t/* Length of order[] */\n"
+	 "} EltType;\n\n", (ntypes + 31)/32, maxparents);
+
+  printf("static const EltType types[NTYPES] = {\n");
+  printf("  {\"\", ELT_MIXED | ELT_STAG | ELT_ETAG, {0}, {0}, 0},\n");
+  for (i = 1; i < ntypes; i++) {
+    t = info[i];
+    printf("  {\"%s\", ELT_KNOWN", t->name);
+    if (t->mixed) printf(" | ELT_MIXED");
+    if (t->empty) printf(" | ELT_EMPTY");
+    if (t->cdata) printf(" | ELT_CDATA");
+    if (t->stag) printf(" | ELT_STAG");
+    if (t->etag) printf(" | ELT_ETAG");
+    if (t->pre) printf(" | ELT_PRE");
+    if (t->break_before) printf(" | ELT_BREAK_BEFORE");
+    if (t->break_after) printf(" | ELT_BREAK_AFTER");
+    if (!t->parents[0]) printf(" | ELT_ROOT");
+    printf(",\n   {");
+    for (j = 0; j < (ntypes + 31)/32; j++)
+      printf("%s0x%08lxU", j ? ", " : "", (unsigned long)parents[i][j]);
+    printf("},\n   {");
+    for (n = 0; t->parents[n]; n++)
+      printf("%s%d", n == 0 ? "" : n % 16 ? ", " : ",\n    ",
+	     type_of(t->parents[n]));
+    printf("%s}, %d},\n", n ? "" : "0", n);
+  }
+  printf("};\n\n");
+
+  printf("/* Types by hash of their name, see elt_type(); 0 = empty slot */\n");
+  printf("static const unsigned char type_hash[NHASH] = {");
+  for (i = 0; i < NHASH; i++)
+    printf("%s%s%d", i ? "," : "", i % 16 == 0 ? "\n  " : " ", hash[i]);
+  printf("};\n");
+}
+
+
+/* write_paths -- write the table of ways to put a type under another */
+static void write_paths(void)
+{
+  int c, p;
+
+  printf("\n/* How an element of type c can be added to one of type p, see\n"
+	 "   build_path(). The parent is never an unknown element. */\n");
+  printf("#define PATH_NONE %d\t\t/* Not even by adding omitted start tags */\n",
+	 PATH_NONE);
+  printf("#define PATH_DIRECT %d\t\t/* As a child */\n", PATH_DIRECT);
+  printf("#define PATH_VIA %d\t\t/* PATH_VIA + q: as child of an implied q */\n",
+	 PATH_VIA);
+  printf("static const unsigned char paths[NTYPES][NTYPES] = {\n");
+  for (c = 0; c < ntypes; c++) {
+    printf("  {");
+    for (p = 0; p < ntypes; p++)
+      printf("%s%d", p == 0 ? "" : p % 24 ? "," : ",\n   ",
+	     c == 0 || p == 0 ? PATH_NONE : find_path(c, p));
+    printf("}%s\n", c < ntypes - 1 ? "," : "");
+  }
+  printf("};\n");
+}
+
+
+/* main -- read dtd.hash and write the tables to stdout */
+int main(int argc, char *argv[])
+{
+  FILE *f;
+
+  if (argc != 2) {fprintf(stderr, "Usage: %s dtd.hash\n", argv[0]); exit(2);}
+  if (!(f = fopen(argv[1], "r"))) {perror(argv[1]); exit(1);}
+  read_names(f, argv[1]);
+  fclose(f);
+  find_parents(argv[1]);
+  write_types("dtd.hash");
+  write_paths();
+  if (fflush(stdout) != 0) {perror("stdout"); exit(1);}
+  return 0;
+}
@@ -0,0 +1,229 @@
+/*
+ * Buffered output for the serializers.
+ *
+ * An Outbuf collects output in a large buffer in user space and
+ * writes it to the file descriptor of a stream with a single system
+ * call when the buffer is full, instead of going through stdio for
+ * every tag and every character. The buffer belongs to one stream
+ * and isn't locked. Text that is larger than half the buffer is not
+ * copied, but written together with the buffer by writev().
+ *
+ * Output written to the same stream with stdio must be flushed
+ * (outbuf_flush) before and after, otherwise the order is lost. The
+ * tools therefore write all their output through one Outbuf and call
+ * outbuf_flush() at the end of each document.
+ *
+ * Part of HTML-XML-utils, see:
+ * http://www.w3.org/Tools/HTML-XML-utils/
+ *
+ * Copyright © 2026 World Wide Web Consortium
+ * See http://www.w3.org/Consortium/Legal/copyright-software
+ *
+ * Author: agent <agent@local>
+ * Created: 17 Oct 2026
+ **/
+#include "config.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <errno.h>
+#ifdef HAVE_STRING_H
+#  include <string.h>
+#elif HAVE_STRINGS_H
+#  include <strings.h>
+#endif
+#if HAVE_SYS_UIO_H && HAVE_WRITEV && HAVE_UNISTD_H
+#  include <sys/uio.h>
+#  include <unistd.h>
+#  define USE_WRITEV 1
+#endif
+#include "export.h"
+#include "types.e"
+#include "heap.e"
+
+EXPORT typedef struct _Outbuf *Outbuf;
+
+#define BUFSIZE 65536				/* Bytes buffered before a write */
+
+struct _Outbuf {
+  FILE *f;					/* The stream written to */
+  char *buf;					/* BUFSIZE bytes */
+  size_t len;					/* Bytes in buf */
+  bool error;					/* A write failed */
+};
+
+static Outbuf std_out = NULL;			/* See outbuf_stdout() */
+
+
+/* outbuf_new -- create a buffer for output to f */
+EXPORT Outbuf outbuf_new(FILE *f)
+{
+  Arena prev = arena_use(NULL);			/* May outlive a document */
+  Outbuf o;
+
+  new(o);
+  o->f = f;
+  newarray(o->buf, BUFSIZE);
+  o->len = 0;
+  o->error = false;
+  (void) arena_use(prev);
+  return o;
+}
+
+#if USE_WRITEV
+/* write_all -- write all of iov[0..n-1] to fd, false on error */
+static bool write_all(int fd, struct iovec *iov, int n)
+{
+  ssize_t r;
+
+  while (n > 0) {
+    if ((r = writev(fd, iov, n)) < 0) {
+      if (errno == EINTR) continue;
+      return false;
+    }
+    for (; n > 0 && (size_t)r >= iov->iov_len; n--, iov++) r -= iov->iov_len;
+    if (n > 0) {iov->iov_base = (char*)iov->iov_base + r; iov->iov_len -= r;}
+  }
+  return true;
+}
+#endif
+
+/* drain -- write the buffer, followed by n bytes at s, false on error */
+static bool drain(Outbuf o, const char *s, size_t n)
+{
+#if USE_WRITEV
+  struct iovec iov[2];
+  int fd;
+#endif
+  bool ok;
+
+  /* Anything the program wrote with stdio goes first */
+  if (fflush(o->f) != 0) {
+    ok = false;
+#if USE_WRITEV
+  } else if ((fd = fileno(o->f)) >= 0) {
+    iov[0].iov_base = o->buf;
+    iov[0].iov_len = o->len;
+    iov[1].iov_base = (char*)s;
+    iov[1].iov_len = n;
+    ok = write_all(fd, iov, 2);
+#endif
+  } else {				/* E.g., a stream from fopencookie() */
+    ok = fwrite(o->buf, 1, o->len, o->f) == o->len
+      && (n == 0 || fwrite(s, 1, n, o->f) == n) && fflush(o->f) == 0;
+  }
+  o->len = 0;
+  return ok;
+}
+
+/* outbuf_flush -- write all buffered output, false if writing failed */
+EXPORT bool outbuf_flush(Outbuf o)
+{
+  if (o->len != 0 && !drain(o, NULL, 0)) o->error = true;
+  return !o->error;
+}
+
+/* outbuf_delete -- flush and free a buffer, false if writing failed */
+EXPORT bool outbuf_delete(Outbuf o)
+{
+  bool ok = outbuf_flush(o);
+
+  if (o == std_out) std_out = NULL;
+  dispose(o->buf);
+  dispose(o);
+  return ok;
+}
+
+/* outbuf_write -- add n bytes at s to the output */
+EXPORT void outbuf_write(Outbuf o, const char *s, size_t n)
+{
+  if (n <= BUFSIZE - o->len) {			/* Fits in the buffer */
+    memcpy(o->buf + o->len, s, n);
+    o->len += n;
+  } else if (n >= BUFSIZE / 2) {		/* Large, don't copy it */
+    if (!drain(o, s, n)) o->error = true;
+  } else {					/* Fill, write, continue */
+    if (!drain(o, NULL, 0)) o->error = true;
+    memcpy(o->buf, s, n);
+    o->len = n;
+  }
+}
+
+/* outbuf_puts -- add a string to the output */
+EXPORT void outbuf_puts(Outbuf o, const conststring s)
+{
+  outbuf_write(o, s, strlen(s));
+}
+
+/* outbuf_putc -- add a character to the output */
+EXPORT void outbuf_putc(Outbuf o, char c)
+{
+  if (o->len == BUFSIZE && !drain(o, NULL, 0)) o->error = true;
+  o->buf[o->len++] = c;
+}
+
+/* outbuf_wrap -- add the string s between the strings before and after */
+EXPORT void outbuf_wrap(Outbuf o, const conststring before,
+			const conststring s, const conststring after)
+{
+  outbuf_puts(o, before);
+  outbuf_puts(o, s);
+  outbuf_puts(o, after);
+}
+
+/* outbuf_printf -- add formatted output, see printf(3) */
+EXPORT void outbuf_printf(Outbuf o, const conststring format, ...)
+{
+  va_list ap;
+  string s;
+  int n;
+
+  va_start(ap, format);
+  n = vsnprintf(o->buf + o->len, BUFSIZE - o->len, format, ap);
+  va_end(ap);
+  assert(n >= 0);
+  if ((size_t)n < BUFSIZE - o->len) {		/* It fitted */
+    o->len += n;
+  } else {					/* Format it again */
+    newarray(s, n + 1);
+    va_start(ap, format);
+    (void) vsnprintf(s, n + 1, format, ap);
+    va_end(ap);
+    outbuf_write(o, s, n);
+    dispose(s);
+  }
+}
+
+/* flush_stdout -- write what is left in the buffer for stdout */
+static void flush_stdout(void)
+{
+  if (std_out) (void) outbuf_flush(std_out);
+}
+
+/* outbuf_stdout -- the buffer for stdout, shared by all modules */
+EXPORT Outbuf outbuf_stdout(void)
+{
+  if (!std_out) {
+    std_out = outbuf_new(stdout);
+    atexit(flush_stdout);
+  }
+  return std_out;
+}
+
+/* outbuf_attribs -- add attributes as ' name="value"', or ' name' if no value */
+EXPORT void outbuf_attribs(Outbuf o, const pairlist attribs)
+{
+  pairlist p;
+
+  for (p = attribs; p; p = p->next) {
+    outbuf_putc(o, ' ');
+    outbuf_puts(o, p->name);
+    if (p->value) {
+      outbuf_write(o, "=\"", 2);
+      outbuf_puts(o, p->value);
+      outbuf_putc(o, '"');
+    }
+  }
+}
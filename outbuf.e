@@ -0,0 +1,14 @@
+typedef struct _Outbuf *Outbuf;
+extern Outbuf outbuf_new(FILE *f);
+extern _Bool 
+           outbuf_flush(Outbuf o);
+extern _Bool 
+           outbuf_delete(Outbuf o);
+extern void outbuf_write(Outbuf o, const char *s, size_t n);
+extern void outbuf_puts(Outbuf o, const conststring s);
+extern void outbuf_putc(Outbuf o, char c);
+extern void outbuf_wrap(Outbuf o, const conststring before,
+   const conststring s, const conststring after);
+extern void outbuf_printf(Outbuf o, const conststring format, ...);
+extern Outbuf outbuf_stdout(void);
+extern void outbuf_attribs(Outbuf o, const pairlist attribs);
@@ -1343,6 +1343,20 @@ char *yytext;
 #include <stdlib.h>
 #include <ctype.h>
 #include <stdbool.h>
+#include <errno.h>
+#include <stdint.h>
+#if defined(__GNUC__) && defined(__x86_64__)
+#  include <immintrin.h>
+#  define USE_SIMD 1			/* SSE2 always, AVX2 if the CPU has it */
+#endif
+#ifndef __has_feature
+#  define __has_feature(x) 0
+#endif
+#if defined(__SANITIZE_ADDRESS__) || __has_feature(address_sanitizer)
+#  define NO_ASAN __attribute__((no_sanitize_address))
+#else
+#  define NO_ASAN
+#endif
 #include "export.h"
 #include "types.e"
 #include "heap.e"
@@ -1350,28 +1364,248 @@ char *yytext;
 #include "html.e"
 #include "errexit.e"
 
+/* The parser is pure, it passes a pointer to where the token's value goes */
+#define YY_DECL static int next_token(HTML_STYPE *lvalp)
+#define yylval (*lvalp)
 
 EXPORT extern FILE *yyin;
 string yyin_name = NULL;
 
 string cur_cdata_element = NULL;
 
+/* Line numbers are not counted while scanning. Instead, the offsets
+   of the starts of lines are put in an index when a line number is
+   asked for. A stream's bytes are not kept, so for a stream they are
+   indexed as they are read, in large blocks. */
+typedef struct _Lines {
+  size_t *start;			/* Offsets of line starts, ascending */
+  size_t n, size;			/* Entries in start, allocated */
+  size_t dropped;			/* Lines dropped before start[0] */
+  size_t done;				/* Bytes before this are indexed */
+  size_t read;				/* Bytes read so far */
+  size_t last;				/* Result of the last line_of() */
+  bool cr;				/* Byte done-1 was a CR */
+} Lines;
+
+static Lines lines;			/* For the current buffer */
+
+/* A scanner that is fed (see scanner_feed()) reads the bytes it is
+   handed instead of yyin. If they run out before the end of the input,
+   the token that the DFA was matching is put back, to be matched again
+   from its start when more bytes arrive, and stall is called. Stall
+   must not return, but longjmp() out of the scanner. To keep the
+   rescanning linear, scanner_feed() holds on to new bytes until there
+   are at least as many as the token that was put back. */
+typedef struct _Feed {
+  const char *s;			/* Bytes not yet read */
+  size_t n;				/* Number of bytes at s */
+  bool eof;				/* No more bytes after these */
+  void (*stall)(void *);		/* NULL if not being fed */
+  void *arg;				/* Argument for stall */
+  size_t need;				/* Length of the token put back */
+  char *held;				/* Bytes fed while waiting for need */
+  size_t nheld, size;			/* Their number and room for them */
+} Feed;
+
+static Feed feed;
+
+/* With a chunk size (see set_chunk_size()), the prescanner passes texts
+   and comments that are longer than that in parts. Cut says if a
+   comment or a CDATA section was cut and the DFA must not see its rest. */
+typedef enum {CUT_NONE, CUT_COMMENT, CUT_SECTION} Cut;
+
+static size_t chunk_size = 0;		/* 0 = don't cut */
+static Cut cut = CUT_NONE;		/* In the middle of a cut token */
+
+/* A client that ignores some kinds of events can tell the scanner (see
+   set_event_mask()). The scanner still recognizes them, but doesn't copy
+   them and returns SKIP, which html_lex() doesn't pass on. Without
+   EVENT_VALUE, attributes have an empty string as value. Events that
+   were masked out may still be reported, e.g., from a snapshot. */
+EXPORT typedef enum {
+  EVENT_TEXT = 1,			/* Text, including CDATA sections */
+  EVENT_COMMENT = 2,
+  EVENT_PI = 4,				/* Processing instructions */
+  EVENT_VALUE = 8,			/* Values of attributes */
+  EVENT_ALL = 15
+} Event;
+
+#define SKIP (-1000)			/* Not a char, nor a bison token */
+#define unwanted(e) (!(events & (e)))
+
+static unsigned int events = EVENT_ALL;	/* What the client wants */
+
 typedef struct _Stack {
   YY_BUFFER_STATE buf;
   FILE *f;
   string name;
+  Lines lines;
   struct _Stack *next;
 } *Stack;
 
 static Stack stack = NULL;
 
+/* add_start -- add a line start at offset o to the index */
+static void add_start(size_t o)
+{
+  if (lines.n == lines.size) {
+    lines.size = lines.size ? 2 * lines.size : 1024;
+    lines.start = realloc(lines.start, lines.size * sizeof(*lines.start));
+    if (!lines.start) errexit("Out of memory\n");
+  }
+  lines.start[lines.n++] = o;
+}
+
+/* add_lines -- add the line starts in s[0..n-1], which is at offset done */
+static void add_lines(const char *s, size_t n)
+{
+  const char *e = s + n, *p;
+  size_t o = lines.done;
+
+  if (n == 0) return;
+  if (!memchr(s, '\r', n)) {			/* Only LF, the usual case */
+    for (p = s; (p = memchr(p, '\n', e - p)); p++)
+      if (p == s && lines.cr) lines.start[lines.n-1]++; /* CR LF */
+      else add_start(o + (p - s) + 1);
+    lines.cr = false;
+  } else {					/* CR, LF or CR LF */
+    for (p = s; p != e; p++)
+      if (*p == '\r') add_start(o + (p - s) + 1);
+      else if (*p != '\n') ;
+      else if (p == s ? lines.cr : p[-1] == '\r') lines.start[lines.n-1]++;
+      else add_start(o + (p - s) + 1);
+    lines.cr = e[-1] == '\r';
+  }
+  lines.done = o + n;
+}
+
+/* drop_lines -- forget line starts before the line that offset o is in */
+static void drop_lines(size_t o)
+{
+  size_t i;
+
+  for (i = 0; i + 1 < lines.n && lines.start[i + 1] <= o; i++) ;
+  if (i < lines.n / 2) return;			/* Not worth it yet */
+  memmove(lines.start, lines.start + i, (lines.n - i) * sizeof(*lines.start));
+  lines.n -= i;
+  lines.dropped += i;
+  lines.last = 0;
+}
+
+/* clear_lines -- free the line index and start at line 1 again */
+static void clear_lines(Lines *l)
+{
+  free(l->start);
+  memset(l, 0, sizeof(*l));
+}
+
+/* stall -- put back the partial token before buf, wait for more bytes */
+static void stall(char *buf)
+{
+  YY_BUFFER_STATE b = YY_CURRENT_BUFFER;
+  int n = buf - b->yy_ch_buf;		/* Flex moved the partial token there */
+
+  /* Make the buffer look as if the token had not been started yet */
+  b->yy_n_chars = yy_n_chars = n;
+  b->yy_ch_buf[n] = b->yy_ch_buf[n + 1] = YY_END_OF_BUFFER_CHAR;
+  yytext = yy_c_buf_p = b->yy_buf_pos = b->yy_ch_buf;
+  yy_hold_char = *yy_c_buf_p;
+  feed.need = n;
+  feed.stall(feed.arg);
+  assert(!"Cannot happen");
+}
+
+/* read_input -- read into buf, index the lines, return the number of bytes */
+static int read_input(char *buf, int max_size)
+{
+  size_t n;
+  int c = '*';
+
+  if (feed.stall && !stack) {		/* Bytes from scanner_feed() */
+    if (feed.n == 0 && !feed.eof) stall(buf);
+    n = feed.n < (size_t)max_size ? feed.n : (size_t)max_size;
+    memcpy(buf, feed.s, n);
+    feed.s += n;
+    feed.n -= n;
+  } else if (YY_CURRENT_BUFFER->yy_is_interactive) { /* Like flex's own */
+    for (n = 0; n < (size_t)max_size && (c = getc(yyin)) != EOF && c != '\n';)
+      buf[n++] = (char)c;
+    if (c == '\n') buf[n++] = (char)c;
+    if (c == EOF && ferror(yyin)) errexit("input in flex scanner failed\n");
+  } else {
+    errno = 0;
+    while ((n = fread(buf, 1, max_size, yyin)) == 0 && ferror(yyin)) {
+      if (errno != EINTR) errexit("input in flex scanner failed\n");
+      errno = 0;
+      clearerr(yyin);
+    }
+  }
+  /* The bytes before buf were moved there from the previous block */
+  drop_lines(lines.read - (buf - YY_CURRENT_BUFFER->yy_ch_buf));
+  add_lines(buf, n);
+  lines.read += n;
+  return n;
+}
+
+#define YY_INPUT(buf, result, max_size) (result) = read_input(buf, max_size)
+
+/* After each read, flex scans the partial token again from its start.
+   Reading at least as many bytes as that token has (number_to_move, in
+   flex's yy_get_next_buffer()) keeps a long token from being quadratic */
+#define YY_READ_BUF_SIZE (number_to_move > 8192 ? number_to_move : 8192)
+
+/* position -- the offset in the input of the end of the last token */
+static size_t position(void)
+{
+  YY_BUFFER_STATE b = YY_CURRENT_BUFFER;
+  size_t o;
+
+  if (!b || !yy_c_buf_p) return lines.read;
+  o = lines.read - yy_n_chars + (yy_c_buf_p - b->yy_ch_buf);
+  if (o > lines.read) o = lines.read;		/* At the end of the buffer */
+  return o;
+}
+
+/* line_of -- return the number of lines that start at or before offset o */
+static size_t line_of(size_t o)
+{
+  size_t lo = 0, hi = lines.n, m;
+
+  /* Usually o is on the same line as the previous time, or just after */
+  if (lines.last == 0 || lines.start[lines.last - 1] <= o) {
+    for (m = lines.last; m < lines.n && m < lines.last + 4; m++)
+      if (lines.start[m] > o) return lines.last = m;
+    lo = m;
+  }
+  while (lo < hi)
+    if (lines.start[m = (lo + hi) / 2] <= o) lo = m + 1; else hi = m;
+  return lines.last = lo;
+}
+
+/* scan_lineno -- the line number of the end of the last token, from 1 */
+EXPORT int scan_lineno(void)
+{
+  return 1 + lines.dropped + line_of(position());
+}
+
+/* unread_input -- return the input if nothing has been read from it yet */
+EXPORT FILE *unread_input(void)
+{
+  YY_BUFFER_STATE b = YY_CURRENT_BUFFER;
+
+  if (stack) return NULL;			/* In an included file */
+  if (b && (b->yy_buffer_status != YY_BUFFER_NEW || b->yy_n_chars != 0
+	    || !b->yy_fill_buffer))
+    return NULL;
+  return yyin ? yyin : stdin;			/* Like flex, default to stdin */
+}
 
 /* set_yyin -- routine to set yyin and store its file name */
 EXPORT void set_yyin(FILE *f, const conststring name)
 {
   yyin = f;
   free(yyin_name);
-  yyin_name = newstring(name);
+  yyin_name = name ? strdup(name) : NULL; /* Must outlive any arena */
 }
 
 /* get_yyin_name -- return the name of the current input, if known */
@@ -1389,10 +1623,12 @@ EXPORT void include_file(FILE *f, const conststring name)
   h->buf = YY_CURRENT_BUFFER;
   h->f = f;
   h->name = yyin_name;
+  h->lines = lines;
   h->next = stack;
   stack = h;
-  yyin_name = newstring(name);
-  yy_switch_to_buffer(yy_create_buffer(f,YY_BUF_SIZE));
+  yyin_name = name ? strdup(name) : NULL;
+  memset(&lines, 0, sizeof(lines));		/* Its own line numbers */
+  yy_switch_to_buffer(yy_create_buffer(f, YY_BUF_SIZE));
 }
 
 /* pop_file -- back to previous input file */
@@ -1408,6 +1644,8 @@ static bool pop_file(void)
     fclose(h->f);
     free(yyin_name);
     yyin_name = h->name;
+    clear_lines(&lines);
+    lines = h->lines;
     yy_switch_to_buffer(h->buf);
     stack = h->next;
     dispose(h);
@@ -1415,7 +1653,197 @@ static bool pop_file(void)
   }
 }
 
-/* esc -- remove outer quotes, escape ", remove \n, return malloc'ed string */
+/* A scanner is the state of the (non-reentrant) flex scanner plus our
+   own. The state of the active scanner is in flex's global variables,
+   the others keep theirs here until scanner_switch() swaps them in.
+   That allows interleaving documents in one thread, but it is not
+   thread-safe. A reentrant scanner would need "%option reentrant",
+   which changes the interface of all of flex's routines and macros
+   used below, and a scan.c generated anew by flex. */
+EXPORT typedef struct _scanner *Scanner;
+
+struct _scanner {
+  size_t buffer_stack_top, buffer_stack_max;
+  YY_BUFFER_STATE *buffer_stack;
+  char hold_char, *c_buf_p, *text, *last_accepting_cpos;
+  int n_chars, leng, init, start, did_buffer_switch_on_eof;
+  yy_state_type last_accepting_state;
+  FILE *in;
+  string in_name, cdata_element;
+  Stack stack;
+  Lines lines;
+  Feed feed;
+  Cut cut;
+};
+
+int yylex_destroy(void);		/* Defined by flex further down */
+
+static struct _scanner default_scanner;	/* Used by yyparse() */
+static Scanner active = &default_scanner; /* Whose state is in the globals */
+
+/* save_state -- copy the global scanner state to s */
+static void save_state(Scanner s)
+{
+  s->buffer_stack_top = yy_buffer_stack_top;
+  s->buffer_stack_max = yy_buffer_stack_max;
+  s->buffer_stack = yy_buffer_stack;
+  s->hold_char = yy_hold_char;
+  s->c_buf_p = yy_c_buf_p;
+  s->text = yytext;
+  s->last_accepting_cpos = yy_last_accepting_cpos;
+  s->n_chars = yy_n_chars;
+  s->leng = yyleng;
+  s->init = yy_init;
+  s->start = yy_start;
+  s->did_buffer_switch_on_eof = yy_did_buffer_switch_on_eof;
+  s->last_accepting_state = yy_last_accepting_state;
+  s->in = yyin;
+  s->in_name = yyin_name;
+  s->cdata_element = cur_cdata_element;
+  s->stack = stack;
+  s->lines = lines;
+  s->feed = feed;
+  s->cut = cut;
+}
+
+/* load_state -- make s's state the global scanner state */
+static void load_state(const Scanner s)
+{
+  yy_buffer_stack_top = s->buffer_stack_top;
+  yy_buffer_stack_max = s->buffer_stack_max;
+  yy_buffer_stack = s->buffer_stack;
+  yy_hold_char = s->hold_char;
+  yy_c_buf_p = s->c_buf_p;
+  yytext = s->text;
+  yy_last_accepting_cpos = s->last_accepting_cpos;
+  yy_n_chars = s->n_chars;
+  yyleng = s->leng;
+  yy_init = s->init;
+  yy_start = s->start;
+  yy_did_buffer_switch_on_eof = s->did_buffer_switch_on_eof;
+  yy_last_accepting_state = s->last_accepting_state;
+  yyin = s->in;
+  yyin_name = s->in_name;
+  cur_cdata_element = s->cdata_element;
+  stack = s->stack;
+  lines = s->lines;
+  feed = s->feed;
+  cut = s->cut;
+}
+
+/* scanner_switch -- make s (NULL = default scanner) active, return previous */
+EXPORT Scanner scanner_switch(Scanner s)
+{
+  Scanner prev = active;
+
+  if (!s) s = &default_scanner;
+  if (s != active) {
+    save_state(active);
+    load_state(s);
+    active = s;
+  }
+  return prev == &default_scanner ? NULL : prev;
+}
+
+/* scanner_create -- create a scanner that has not read anything yet */
+EXPORT Scanner scanner_create(void)
+{
+  Scanner s;
+
+  if (!(s = calloc(1, sizeof(*s)))) errexit("Out of memory\n");
+  return s;
+}
+
+/* scanner_set_input -- set the file that s reads from and its name */
+EXPORT void scanner_set_input(Scanner s, FILE *f, const conststring name)
+{
+  Scanner prev = scanner_switch(s);
+
+  set_yyin(f, name);
+  (void) scanner_switch(prev);
+}
+
+/* scanner_reset -- forget s's input, buffers and included files */
+EXPORT void scanner_reset(Scanner s)
+{
+  Scanner prev = scanner_switch(s);
+
+  while (pop_file()) ;
+  if (YY_CURRENT_BUFFER) {
+    yy_delete_buffer(YY_CURRENT_BUFFER);
+    YY_CURRENT_BUFFER_LVALUE = NULL;
+  }
+  yylex_destroy();				/* Also sets yyin to NULL */
+  free(cur_cdata_element);
+  cur_cdata_element = NULL;
+  clear_lines(&lines);
+  free(feed.held);
+  memset(&feed, 0, sizeof(feed));
+  cut = CUT_NONE;
+  (void) scanner_switch(prev);
+}
+
+/* hold -- keep a copy of buf[0..len-1] after the bytes already held */
+static void hold(const char *buf, size_t len)
+{
+  if (feed.nheld + len > feed.size) {
+    feed.size = feed.nheld + len > 2 * feed.size ? feed.nheld + len
+      : 2 * feed.size;
+    feed.held = realloc(feed.held, feed.size);
+    if (!feed.held) errexit("Out of memory\n");
+  }
+  if (len) memcpy(feed.held + feed.nheld, buf, len);
+  feed.nheld += len;
+}
+
+/* scanner_feed -- make s read buf[0..len-1] next; eof = nothing follows
+ *
+ * Returns false if s should not be run yet, because the bytes are
+ * fewer than those of the token that stalled. It keeps a copy of them
+ * and passes them on, after the bytes of a later call.
+ */
+EXPORT bool scanner_feed(Scanner s, const char *buf, size_t len, bool eof,
+			 void (*stall)(void *), void *arg)
+{
+  Scanner prev = scanner_switch(s);
+  bool result = true;
+
+  /* A buffer without a file, so that flex doesn't look at stdin */
+  if (!YY_CURRENT_BUFFER)
+    yy_switch_to_buffer(yy_create_buffer(NULL, YY_BUF_SIZE));
+  if (!eof && feed.nheld + len < feed.need) { /* Not worth a rescan yet */
+    hold(buf, len);
+    feed.s = NULL;
+    feed.n = 0;
+    result = false;
+  } else if (feed.nheld) {			/* Held bytes first */
+    hold(buf, len);
+    feed.s = feed.held;
+    feed.n = feed.nheld;
+    feed.nheld = feed.need = 0;
+  } else {
+    feed.s = buf;
+    feed.n = len;
+    feed.need = 0;
+  }
+  feed.eof = eof;
+  feed.stall = stall;
+  feed.arg = arg;
+  (void) scanner_switch(prev);
+  return result;
+}
+
+/* scanner_delete -- free a scanner, its buffers and any included files */
+EXPORT void scanner_delete(Scanner s)
+{
+  assert(s && s != &default_scanner);
+  if (s == active) (void) scanner_switch(NULL);
+  scanner_reset(s);
+  free(s->in_name);
+  free(s);
+}
+
+/* esc -- remove outer quotes, escape ", remove \n, return new string */
 static string esc(string s)
 {
   int i, j;
@@ -1426,8 +1854,7 @@ static string esc(string s)
     if (s[j] == '"' || s[j] == '<' || s[j] == '>') i+= 4;
   }
   /* Copy and expand */
-  u = malloc(i + 1);
-  if (!u) errexit("Out of memory\n");
+  newarray(u, i + 1);
   for (i = 0, j = 1; s[j] != s[0]; i++, j++) {
     if (s[j] == '"')  {strcpy(u + i, "&#34;"); i += 4;}
     else if (s[j] == '<')  {strcpy(u + i, "&#60;"); i += 4;}
@@ -1440,48 +1867,146 @@ static string esc(string s)
   u[i] = '\0';
   return u;
 }
- 
-#ifndef HAVE_STRNDUP
 
-/* strndup -- allocate a string, copy n characters into it and add \0 */
-static string strndup(const string s, size_t n)
+/* The prescanner finds the end of long runs of text, quoted attribute
+   values, comments and CDATA content many bytes at a time, instead of
+   letting the DFA look at each byte. It only takes a token if it can
+   see the whole of it in the buffer and would match the same as the
+   DFA; otherwise, and for all other tokens, the DFA runs as usual. */
+EXPORT typedef enum {
+  PRESCAN_NONE, PRESCAN_SCALAR, PRESCAN_SSE2, PRESCAN_AVX2
+} Prescan;
+
+typedef const char *(*Skipper)(const char *s, char a, char b, char c);
+
+static Skipper skip_to = NULL;		/* Set by set_prescan() */
+static bool prescan_chosen = false;	/* Whether set_prescan() was called */
+
+static int prescan(HTML_STYPE *lvalp);	/* Defined at the end */
+
+/* skip_scalar -- return pointer to the first a, b, c or NUL in s */
+static const char *skip_scalar(const char *s, char a, char b, char c)
 {
-  string t = malloc(n + 1);
-  if (!t) errexit("Out of memory\n");
-  strncpy(t, s, n);
-  t[n] = '\0';
-  return t;
+  while (*s && *s != a && *s != b && *s != c) s++;
+  return s;
 }
 
-#else
-# ifndef strndup
+#if USE_SIMD
+/* The SIMD versions read aligned blocks, which never cross a page
+   boundary, and may thus read a few bytes beyond the final NUL, but
+   never beyond the memory page that it is in. Most tokens are short,
+   so they first look at a few bytes one by one. */
+
+#define SHORT 16				/* Bytes tried one by one */
 
-/* We know strndup() exists (HAVE_STRNDUP) and it is not defined as a
-macro (!strndup), but older versions of string.h do not provide the
-declaration, so let's declare it here to be sure. */
+/* skip_short -- return the first a, b, c or NUL in s[0..SHORT-1], or NULL */
+static inline const char *skip_short(const char *s, char a, char b, char c)
+{
+  const char *e = s + SHORT;
+
+  for (; s != e; s++) if (!*s || *s == a || *s == b || *s == c) return s;
+  return NULL;
+}
 
-extern char *strndup(const char *s, size_t n);
+/* skip_sse2 -- return pointer to the first a, b, c or NUL in s */
+NO_ASAN static const char *skip_sse2(const char *s, char a, char b, char c)
+{
+  const __m128i va = _mm_set1_epi8(a), vb = _mm_set1_epi8(b);
+  const __m128i vc = _mm_set1_epi8(c), zero = _mm_setzero_si128();
+  const __m128i *q;
+  unsigned mask, m;
+  __m128i x;
+
+  if ((q = (const __m128i*)skip_short(s, a, b, c))) return (const char*)q;
+  s += SHORT;
+  q = (const __m128i*)((uintptr_t)s & ~(uintptr_t)15);
+  mask = ~0u << ((uintptr_t)s & 15);
+  for (;; q++, mask = ~0u) {
+    x = _mm_load_si128(q);
+    m = _mm_movemask_epi8(_mm_or_si128(
+	  _mm_or_si128(_mm_cmpeq_epi8(x, va), _mm_cmpeq_epi8(x, vb)),
+	  _mm_or_si128(_mm_cmpeq_epi8(x, vc), _mm_cmpeq_epi8(x, zero))));
+    if ((m &= mask)) return (const char*)q + __builtin_ctz(m);
+  }
+}
+
+/* skip_avx2 -- return pointer to the first a, b, c or NUL in s */
+NO_ASAN __attribute__((target("avx2")))
+static const char *skip_avx2(const char *s, char a, char b, char c)
+{
+  const __m256i va = _mm256_set1_epi8(a), vb = _mm256_set1_epi8(b);
+  const __m256i vc = _mm256_set1_epi8(c), zero = _mm256_setzero_si256();
+  const __m256i *q;
+  unsigned mask, m;
+  __m256i x;
+
+  if ((q = (const __m256i*)skip_short(s, a, b, c))) return (const char*)q;
+  s += SHORT;
+  q = (const __m256i*)((uintptr_t)s & ~(uintptr_t)31);
+  mask = ~0u << ((uintptr_t)s & 31);
+  for (;; q++, mask = ~0u) {
+    x = _mm256_load_si256(q);
+    m = (unsigned)_mm256_movemask_epi8(_mm256_or_si256(
+	  _mm256_or_si256(_mm256_cmpeq_epi8(x, va), _mm256_cmpeq_epi8(x, vb)),
+	  _mm256_or_si256(_mm256_cmpeq_epi8(x, vc),
+			  _mm256_cmpeq_epi8(x, zero))));
+    if ((m &= mask)) return (const char*)q + __builtin_ctz(m);
+  }
+}
+#endif
 
-# endif
+/* set_prescan -- use prescanner p, or the best below it, return the one used */
+EXPORT Prescan set_prescan(Prescan p)
+{
+#if USE_SIMD
+  __builtin_cpu_init();
+  if (p == PRESCAN_AVX2 && !__builtin_cpu_supports("avx2")) p = PRESCAN_SSE2;
+#else
+  if (p > PRESCAN_SCALAR) p = PRESCAN_SCALAR;
+#endif
+  switch (p) {
+    case PRESCAN_NONE: skip_to = NULL; break;
+    case PRESCAN_SCALAR: skip_to = skip_scalar; break;
+#if USE_SIMD
+    case PRESCAN_SSE2: skip_to = skip_sse2; break;
+    case PRESCAN_AVX2: skip_to = skip_avx2; break;
 #endif
+  }
+  prescan_chosen = true;
+  return p;
+}
 
-/* lns -- count newlines */
-static void lns(const string t)
+/* end_comment -- return end of comment whose "<!--" ends at s, or NULL */
+static char *end_comment(char *s)
 {
-  string s = t;
+  /* Same as ([^-]|-[^-]|--[^>])*"-->", NULL if the buffer ends first */
+  for (;;) {
+    s = (char*)skip_to(s, '-', '-', '-');
+    if (!*s || !s[1]) return NULL;
+    if (s[1] != '-') s += 2;
+    else if (!s[2]) return NULL;
+    else if (s[2] == '>') return s + 3;
+    else s += 3;
+  }
+}
 
-  while (*s) {
-    if (*s == '\n') lineno++;
-    else if (*s != '\r') ;
-    else if (*(s+1) == '\n') {lineno++; s++;}
-    else lineno++;
-    s++;
+/* end_cdata -- return end of the text at s in a CDATA element, or NULL */
+static char *end_cdata(char *s)
+{
+  /* Same as ([^<]|\<[^/]|\<\/[^{a-z:._-])*, NULL if the buffer ends first */
+  for (;;) {
+    s = (char*)skip_to(s, '<', '<', '<');
+    if (!*s || !s[1]) return NULL;
+    if (s[1] != '/') s += 2;
+    else if (!s[2]) return NULL;
+    else if (strchr("{:._-", s[2]) || (s[2] >= 'a' && s[2] <= 'z')) return s;
+    else s += 3;
   }
 }
 
 /* thing is rather too permissive, but it will accept <img src=/path>... */
 
-#line 1485 "scan.c"
+#line 2010 "scan.c"
 
 #define INITIAL 0
 #define MARKUP 1
@@ -1702,11 +2227,14 @@ YY_DECL
 		}
 
 	{
-#line 177 "scan.l"
+#line 702 "scan.l"
 
+			int token;
 
+			if ((token = prescan(lvalp))) return token;
 
-#line 1710 "scan.c"
+
+#line 2238 "scan.c"
 
 	while ( /*CONSTCOND*/1 )		/* loops until end-of-file is reached */
 		{
@@ -1753,173 +2281,178 @@ do_action:	/* This label is used only to access EOF actions. */
 
 case 1:
 YY_RULE_SETUP
-#line 180 "scan.l"
+#line 708 "scan.l"
 {BEGIN(INIT); /* Byte Order Mark is ignored */}
 	YY_BREAK
 case 2:
 YY_RULE_SETUP
-#line 182 "scan.l"
-{BEGIN(MARKUP); yylval.s=strdup(yytext+1); return START;}
+#line 710 "scan.l"
+{BEGIN(MARKUP); yylval.s=newstring(yytext+1); return START;}
 	YY_BREAK
 case 3:
 YY_RULE_SETUP
-#line 183 "scan.l"
-{BEGIN(MARKUP); yylval.s=strdup(yytext+2); return END;}
+#line 711 "scan.l"
+{BEGIN(MARKUP); yylval.s=newstring(yytext+2); return END;}
 	YY_BREAK
 case 4:
-YY_RULE_SETUP
-#line 184 "scan.l"
-{yylval.s=strdup(yytext); return TEXT;}
-	YY_BREAK
+#line 714 "scan.l"
 case 5:
 /* rule 5 can match eol */
-YY_RULE_SETUP
-#line 185 "scan.l"
-{yylval.s=strdup(yytext); lns(yytext); return TEXT;}
-	YY_BREAK
+#line 714 "scan.l"
 case 6:
 /* rule 6 can match eol */
 YY_RULE_SETUP
-#line 186 "scan.l"
-{yylval.s=strdup(yytext); lineno++; return TEXT;}
+#line 714 "scan.l"
+{if (unwanted(EVENT_TEXT)) return SKIP;
+				 yylval.s=newstring(yytext); return TEXT;}
 	YY_BREAK
 case 7:
 /* rule 7 can match eol */
 YY_RULE_SETUP
-#line 187 "scan.l"
-{yylval.s=strndup(yytext+4,yyleng-7); lns(yytext); return COMMENT;}
+#line 716 "scan.l"
+{if (unwanted(EVENT_COMMENT)) return SKIP;
+			 yylval.s=newnstring(yytext+4,yyleng-7); return COMMENT;}
 	YY_BREAK
 case 8:
 /* rule 8 can match eol */
 YY_RULE_SETUP
-#line 188 "scan.l"
-{BEGIN(DECL); lns(yytext+9); return DOCTYPE;}
+#line 718 "scan.l"
+{BEGIN(DECL); return DOCTYPE;}
 	YY_BREAK
 case 9:
 /* rule 9 can match eol */
 YY_RULE_SETUP
-#line 189 "scan.l"
-{yylval.s=strndup(yytext+2,yyleng-3); lns(yytext); return PROCINS;}
+#line 719 "scan.l"
+{if (unwanted(EVENT_PI)) return SKIP;
+			 yylval.s=newnstring(yytext+2,yyleng-3); return PROCINS;}
 	YY_BREAK
 case 10:
 YY_RULE_SETUP
-#line 190 "scan.l"
-{yylval.s=strdup("&lt;"); return TEXT;}
+#line 721 "scan.l"
+{if (unwanted(EVENT_TEXT)) return SKIP;
+				 yylval.s=newstring("&lt;"); return TEXT;}
 	YY_BREAK
 case 11:
 YY_RULE_SETUP
-#line 192 "scan.l"
-{yylval.s = strdup(yytext); return NAME;}
+#line 724 "scan.l"
+{yylval.s = newstring(yytext); return NAME;}
 	YY_BREAK
 case 12:
 YY_RULE_SETUP
-#line 193 "scan.l"
+#line 725 "scan.l"
 {BEGIN(VALUE); return '=';}
 	YY_BREAK
 case 13:
 YY_RULE_SETUP
-#line 194 "scan.l"
+#line 726 "scan.l"
 {; /* skip */}
 	YY_BREAK
 case 14:
 /* rule 14 can match eol */
 YY_RULE_SETUP
-#line 195 "scan.l"
-{lineno++; /* skip */}
+#line 727 "scan.l"
+{; /* skip */}
 	YY_BREAK
 case 15:
 YY_RULE_SETUP
-#line 196 "scan.l"
+#line 728 "scan.l"
 {BEGIN(INIT); return '>';}
 	YY_BREAK
 case 16:
 YY_RULE_SETUP
-#line 197 "scan.l"
+#line 729 "scan.l"
 {BEGIN(INIT); return EMPTYEND;}
 	YY_BREAK
 case 17:
 YY_RULE_SETUP
-#line 198 "scan.l"
+#line 730 "scan.l"
 {BEGIN(INIT); yyless(0); return '>'; /* Implicit ">" */} 
 	YY_BREAK
 case 18:
 YY_RULE_SETUP
-#line 200 "scan.l"
+#line 732 "scan.l"
 {; /* skip */}
 	YY_BREAK
 case 19:
 /* rule 19 can match eol */
 YY_RULE_SETUP
-#line 201 "scan.l"
-{lineno++; /* skip */}
+#line 733 "scan.l"
+{; /* skip */}
 	YY_BREAK
 case 20:
 YY_RULE_SETUP
-#line 202 "scan.l"
-{BEGIN(MARKUP); yylval.s=strdup(yytext); return NAME;}
+#line 734 "scan.l"
+{BEGIN(MARKUP);
+			 yylval.s=newstring(unwanted(EVENT_VALUE) ? "" : yytext);
+			 return NAME;}
 	YY_BREAK
 case 21:
 /* rule 21 can match eol */
-#line 204 "scan.l"
+#line 738 "scan.l"
 case 22:
 /* rule 22 can match eol */
 YY_RULE_SETUP
-#line 204 "scan.l"
-{BEGIN(MARKUP); yylval.s=esc(yytext); lns(yytext); return STRING;}
+#line 738 "scan.l"
+{BEGIN(MARKUP);
+			 yylval.s=unwanted(EVENT_VALUE) ? newstring("") : esc(yytext);
+			 return STRING;}
 	YY_BREAK
 case 23:
 YY_RULE_SETUP
-#line 206 "scan.l"
-{yylval.s = strdup(yytext); return NAME;}
+#line 742 "scan.l"
+{yylval.s = newstring(yytext); return NAME;}
 	YY_BREAK
 case 24:
 YY_RULE_SETUP
-#line 207 "scan.l"
+#line 743 "scan.l"
 {; /* skip */}
 	YY_BREAK
 case 25:
 /* rule 25 can match eol */
 YY_RULE_SETUP
-#line 208 "scan.l"
-{lineno++; /* skip */}
+#line 744 "scan.l"
+{; /* skip */}
 	YY_BREAK
 case 26:
 /* rule 26 can match eol */
-#line 210 "scan.l"
+#line 746 "scan.l"
 case 27:
 /* rule 27 can match eol */
 YY_RULE_SETUP
-#line 210 "scan.l"
-{lns(yytext); yylval.s = esc(yytext); return STRING;}
+#line 746 "scan.l"
+{yylval.s = esc(yytext); return STRING;}
 	YY_BREAK
 case 28:
 YY_RULE_SETUP
-#line 211 "scan.l"
+#line 747 "scan.l"
 {BEGIN(INIT); return '>';}
 	YY_BREAK
 case 29:
 /* rule 29 can match eol */
 YY_RULE_SETUP
-#line 213 "scan.l"
-{lns(yytext); yylval.s = strdup(yytext); return TEXT;}
+#line 749 "scan.l"
+{if (unwanted(EVENT_TEXT)) return SKIP;
+			 yylval.s = newstring(yytext); return TEXT;}
 	YY_BREAK
 case 30:
 YY_RULE_SETUP
-#line 214 "scan.l"
-{lns(yytext);
+#line 751 "scan.l"
+{
 			 if (strcasecmp(yytext+2, cur_cdata_element) == 0) {
 			   BEGIN(MARKUP);
-			   yylval.s = strdup(yytext+2);
+			   yylval.s = newstring(yytext+2);
 			   return END;
+			 } else if (unwanted(EVENT_TEXT)) {
+			   return SKIP;
 			 } else {
-			   yylval.s = strdup(yytext);
+			   yylval.s = newstring(yytext);
 			   return TEXT;
 			 }
 			}
 	YY_BREAK
 case 31:
 YY_RULE_SETUP
-#line 225 "scan.l"
+#line 764 "scan.l"
 {return *yytext; /* illegal char, in fact */}
 	YY_BREAK
 case YY_STATE_EOF(INITIAL):
@@ -1928,15 +2461,16 @@ case YY_STATE_EOF(VALUE):
 case YY_STATE_EOF(DECL):
 case YY_STATE_EOF(INIT):
 case YY_STATE_EOF(CDATA):
-#line 227 "scan.l"
-{if (pop_file()) return ENDINCL; else yyterminate();}
+#line 766 "scan.l"
+{if (pop_file()) return ENDINCL;
+			 yyterminate();}
 	YY_BREAK
 case 32:
 YY_RULE_SETUP
-#line 229 "scan.l"
+#line 769 "scan.l"
 YY_FATAL_ERROR( "flex scanner jammed" );
 	YY_BREAK
-#line 1940 "scan.c"
+#line 2474 "scan.c"
 
 	case YY_END_OF_BUFFER:
 		{
@@ -2888,21 +3422,299 @@ void yyfree (void * ptr )
 
 #define YYTABLES_NAME "yytables"
 
-#line 229 "scan.l"
-
-
+#line 769 "scan.l"
 
 /* set_cdata_element -- set parsing rule for an element with CDATA content */
 EXPORT void set_cdata_element(const conststring e)
 {
-  dispose(cur_cdata_element);
-  cur_cdata_element = newstring(e);
+  free(cur_cdata_element);
+  cur_cdata_element = strdup(e);	/* Must outlive any arena */
   BEGIN(CDATA);
 }
 
+/* take -- make yytext the n bytes at yy_c_buf_p, as if the DFA matched them */
+static void take(int n)
+{
+  yytext = yy_c_buf_p;
+  yyleng = n;
+  yy_c_buf_p += n;
+  yy_hold_char = *yy_c_buf_p;
+  *yy_c_buf_p = '\0';
+}
+
+/* set_chunk_size -- pass texts and comments longer than n bytes in parts */
+EXPORT void set_chunk_size(size_t n)
+{
+  chunk_size = n;
+}
+
+/* buffer_end -- the end of the bytes that are in flex's buffer now */
+static char *buffer_end(void)
+{
+  return YY_CURRENT_BUFFER->yy_ch_buf + yy_n_chars;
+}
+
+/* refill -- move the bytes from s on to the start of the buffer, read more */
+static bool refill(char *s)
+{
+  YY_BUFFER_STATE b = YY_CURRENT_BUFFER;
+  int r;
+
+  /* Do what the DFA does when it reaches the end of the buffer in a
+     token that starts at s. The buffer only grows if s is near its
+     start. A buffer that doesn't read from a file has nothing more. */
+  if (!b->yy_fill_buffer) return false;
+  yytext = s;
+  yy_c_buf_p = b->yy_ch_buf + yy_n_chars + 1;
+  r = yy_get_next_buffer();
+  yy_c_buf_p = yytext;
+  yy_hold_char = *yy_c_buf_p;
+  return r == EOB_ACT_CONTINUE_SCAN;
+}
+
+/* end_run -- end of ([^c]|c[^c]|cc[^>])*cc> at s, NULL if not before end */
+static char *end_run(char *s, const char *end, char c)
+{
+  /* As end_comment(), but also for "]]>", and a NUL is not the end */
+  while ((s = memchr(s, c, end - s))) {
+    if (s + 2 >= end) return NULL;
+    if (s[1] != c) s += 2;
+    else if (s[2] == '>') return s + 3;
+    else s += 3;
+  }
+  return NULL;
+}
+
+/* end_text -- end of ([^<]|\<[^/]|\<\/[^{a-z:._-])* at s, NULL if at end */
+static char *end_text(char *s, const char *end)
+{
+  /* As end_cdata(), but a NUL is not the end */
+  while ((s = memchr(s, '<', end - s))) {
+    if (s + 2 >= end) return NULL;
+    if (s[1] != '/') s += 2;
+    else if (s[2] && (strchr("{:._-", s[2]) || (s[2] >= 'a' && s[2] <= 'z')))
+      return s;
+    else s += 3;
+  }
+  return NULL;
+}
+
+/* cut_point -- a place near n to cut the m bytes at s, 0 if there is none */
+static size_t cut_point(const char *s, size_t n, size_t m, const char *avoid)
+{
+  size_t i;
+
+  /* Not after a byte in avoid, nor inside a UTF-8 character. Avoid
+     always has "&", because "&#" in a text means something to some tools */
+#define can_cut(i) (!strchr(avoid, s[(i)-1]) && (s[i] & 0xC0) != 0x80)
+  if (n > m) n = m;
+  for (i = n; i > 0; i--) if (can_cut(i)) return i;
+  for (i = n + 1; i < m; i++) if (can_cut(i)) return i;
+  return 0;
+#undef can_cut
+}
+
+/* window -- the first n bytes at s, or fewer if the buffer ends before */
+static char *window(char *s, size_t n)
+{
+  char *end = buffer_end();
+
+  return (size_t)(end - s) > n ? s + n : end;
+}
+
+/* cut_rest -- return the next part of a comment or CDATA section that was cut */
+static int cut_rest(HTML_STYPE *lvalp)
+{
+  bool comment = cut == CUT_COMMENT, closed = true;
+  const char *avoid = comment ? "-&" : "]&";
+  char c = comment ? '-' : ']', *s, *e, *w;
+  size_t n;
+
+  /* Only look as far as the next part can go, lest a long token that
+     is all in the buffer already is searched once per part */
+  for (;;) {
+    s = yy_c_buf_p;
+    w = window(s, chunk_size + 3);
+    if ((e = end_run(s, w, c))) break;		/* The last part */
+    if (w != buffer_end()) {
+      if ((n = cut_point(s, chunk_size, w - s, avoid))) {
+	take(n);
+	if (unwanted(comment ? EVENT_COMMENT : EVENT_TEXT)) return SKIP;
+	yylval.s = newnstring(yytext, yyleng);
+	return comment ? COMMENTPART : TEXTPART;
+      }
+      if ((e = end_run(s, buffer_end(), c))) break; /* Cannot cut, take all */
+    }
+    if (!refill(s)) {				/* Not closed after all */
+      s = yy_c_buf_p;
+      e = buffer_end();
+      closed = false;
+      break;
+    }
+  }
+  take(e - s);
+  cut = CUT_NONE;
+  if (unwanted(comment ? EVENT_COMMENT : EVENT_TEXT)) return SKIP;
+  yylval.s = newnstring(yytext, yyleng - (comment && closed ? 3 : 0));
+  return comment ? COMMENT : TEXT;
+}
+
+/* cut_token -- return a long text or comment or a part of it, else 0 */
+static int cut_token(HTML_STYPE *lvalp)
+{
+  char *s, *t, *e, *w, *end, c;
+  size_t n, skip;
+
+  if (cut != CUT_NONE) return cut_rest(lvalp);
+
+  /* The DFA would read a long token whole, so read ahead for it here */
+  for (;;) {
+    s = yy_c_buf_p;
+    end = buffer_end();
+    if (s == end) return 0;			/* Let the DFA read more */
+    switch (YY_START) {
+      case INITIAL:
+      case INIT:
+	if (end - s < 9 && refill(s)) continue;	/* E.g., "<![CDATA[" */
+	s = yy_c_buf_p;
+	end = buffer_end();
+	if (YY_START == INITIAL && *s == '\357') return 0;
+	if (*s != '<') {				/* {data} */
+	  w = window(s, chunk_size + 1);
+	  c = *w;
+	  *w = '\0';				/* Stop skip_to() there */
+	  for (e = s; (e = (char*)skip_to(e, '<', '\r', '\n')) != w && !*e;)
+	    e++;				/* Skip NULs inside the buffer */
+	  *w = c;
+	  if (e == s) return 0;
+	  if (e != w) {
+	    take(e - s);
+	    if (unwanted(EVENT_TEXT)) return SKIP;
+	    yylval.s = newstring(yytext);
+	    return TEXT;
+	  }
+	  if (w != end) {
+	    if (!(n = cut_point(s, chunk_size, w - s, "&"))) return 0;
+	    BEGIN(INIT);			/* The rest is no Byte Order Mark */
+	    take(n);
+	    if (unwanted(EVENT_TEXT)) return SKIP;
+	    yylval.s = newstring(yytext);
+	    return TEXTPART;
+	  }
+	  if (refill(s)) continue;
+	  return 0;
+	}
+	if (s[1] != '!') {
+	  return 0;
+	} else if (s[2] == '-' && s[3] == '-') {	/* {comment} */
+	  skip = 4;
+	  c = '-';
+	} else if (s[2] == '[' && strncasecmp(s + 3, "CDATA[", 6) == 0) {
+	  skip = 9;				/* {cdata} */
+	  c = ']';
+	} else {
+	  return 0;
+	}
+	/* Only cut it if it is closed: if not, the DFA makes it text
+	   starting with "&lt;", which the parts would not add up to */
+	t = s + skip;
+	if (!(e = end_run(t, end, c))) {
+	  if (refill(s)) continue;
+	  return 0;
+	}
+	w = window(t, chunk_size + 3);
+	if (e <= w) return 0;			/* Short enough */
+	if (!(n = cut_point(t, chunk_size, w - t, c == '-' ? "-&" : "]&")))
+	  return 0;
+	take(skip + n);
+	cut = c == '-' ? CUT_COMMENT : CUT_SECTION;
+	if (unwanted(c == '-' ? EVENT_COMMENT : EVENT_TEXT)) return SKIP;
+	yylval.s = c == '-' ? newnstring(yytext + 4, n) : newstring(yytext);
+	return c == '-' ? COMMENTPART : TEXTPART;
+      case CDATA:
+	w = window(s, chunk_size + 3);
+	if (end_text(s, w)) return 0;		/* Short enough */
+	if (w == end) {
+	  if (refill(s)) continue;
+	  return 0;
+	}
+	if (!(n = cut_point(s, chunk_size, w - s, "</&"))) return 0;
+	take(n);
+	if (unwanted(EVENT_TEXT)) return SKIP;
+	yylval.s = newstring(yytext);
+	return TEXTPART;
+      default:
+	return 0;
+    }
+  }
+}
+
+/* set_event_mask -- only report the kinds of events in mask, see Event */
+EXPORT void set_event_mask(unsigned int mask)
+{
+  events = mask;
+}
+
+/* html_lex -- return the next token, skipping those the client doesn't want */
+int html_lex(HTML_STYPE *lvalp)
+{
+  int token;
+
+  while ((token = next_token(lvalp)) == SKIP) ;
+  return token;
+}
+
+/* prescan -- return the next token if the prescanner can find it, else 0 */
+static int prescan(HTML_STYPE *lvalp)
+{
+  char *s, *e;
+  int token;
+
+  if (!prescan_chosen) (void) set_prescan(PRESCAN_AVX2);
+  if (!skip_to) return 0;
+  *yy_c_buf_p = yy_hold_char;		/* Undo the NUL after the last token */
+  if (chunk_size && (token = cut_token(lvalp))) return token;
+  s = yy_c_buf_p;
+
+  switch (YY_START) {
+    case INITIAL:
+      if (*s == '\357') return 0;		/* Maybe a Byte Order Mark */
+      /* fall through */
+    case INIT:
+      if (*s != '<') {				/* {data} */
+	e = (char*)skip_to(s, '<', '\r', '\n');
+	if (e == s || !*e) return 0;
+	take(e - s);
+	if (unwanted(EVENT_TEXT)) return SKIP;
+	yylval.s = newstring(yytext);
+	return TEXT;
+      }
+      if (s[1] != '!' || s[2] != '-' || s[3] != '-') return 0;
+      if (!(e = end_comment(s + 4))) return 0;	/* {comment} */
+      take(e - s);
+      if (unwanted(EVENT_COMMENT)) return SKIP;
+      yylval.s = newnstring(yytext + 4, yyleng - 7);
+      return COMMENT;
+    case VALUE:
+      if (*s != '"' && *s != '\'') return 0;
+      e = (char*)skip_to(s + 1, *s, *s, *s);	/* \"[^"]*\" or \'[^']*\' */
+      if (!*e) return 0;
+      take(e + 1 - s);
+      BEGIN(MARKUP);
+      yylval.s = unwanted(EVENT_VALUE) ? newstring("") : esc(yytext);
+      return STRING;
+    case CDATA:
+      if (!(e = end_cdata(s)) || e == s) return 0;
+      take(e - s);
+      if (unwanted(EVENT_TEXT)) return SKIP;
+      yylval.s = newstring(yytext);
+      return TEXT;
+  }
+  return 0;
+}
+
 /*
  * Local variables:
  * mode: indented-text
  * End:
  */
-
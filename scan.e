@@ -1,5 +1,31 @@
 extern FILE *yyin;
+typedef enum {
+  EVENT_TEXT = 1,
+  EVENT_COMMENT = 2,
+  EVENT_PI = 4,
+  EVENT_VALUE = 8,
+  EVENT_ALL = 15
+} Event;
+extern int scan_lineno(void);
+extern FILE *unread_input(void);
 extern void set_yyin(FILE *f, const conststring name);
 extern conststring get_yyin_name(void);
 extern void include_file(FILE *f, const conststring name);
+typedef struct _scanner *Scanner;
+extern Scanner scanner_switch(Scanner s);
+extern Scanner scanner_create(void);
+extern void scanner_set_input(Scanner s, FILE *f, const conststring name);
+extern void scanner_reset(Scanner s);
+extern _Bool 
+           scanner_feed(Scanner s, const char *buf, size_t len, 
+                                                                _Bool 
+                                                                     eof,
+    void (*stall)(void *), void *arg);
+extern void scanner_delete(Scanner s);
+typedef enum {
+  PRESCAN_NONE, PRESCAN_SCALAR, PRESCAN_SSE2, PRESCAN_AVX2
+} Prescan;
+extern Prescan set_prescan(Prescan p);
 extern void set_cdata_element(const conststring e);
+extern void set_chunk_size(size_t n);
+extern void set_event_mask(unsigned int mask);
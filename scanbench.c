@@ -0,0 +1,119 @@
+/*
+ * Measure how fast the scanner reads documents, with and without the
+ * prescanner.
+ *
+ * Usage: scanbench [-n repeat] [-m mask] file...
+ *
+ * Each file is scanned repeat times (default 10) with each of the
+ * prescanners that the processor supports and once more with only
+ * the DFA. The parser is not run, but, as in the tools, the content
+ * of script and style elements is scanned as CDATA. Prints the speed
+ * in MB/s (of CPU time) and the number of tokens, which should be the
+ * same for all. With -m, only the events in mask (a sum of Event
+ * values, see scan.l) are asked for, e.g., 0 for only the tags.
+ *
+ * Not installed; build with "make scanbench".
+ *
+ * Part of HTML-XML-utils, see:
+ * http://www.w3.org/Tools/HTML-XML-utils/
+ *
+ * Copyright © 2026 World Wide Web Consortium
+ * See http://www.w3.org/Consortium/Legal/copyright-software
+ *
+ * Author: agent <agent@local>
+ * Created: 17 Oct 2026
+ **/
+#include "config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <time.h>
+#include <unistd.h>
+#ifdef HAVE_STRING_H
+#  include <string.h>
+#elif HAVE_STRINGS_H
+#  include <strings.h>
+#endif
+#include "export.h"
+#include "types.e"
+#include "heap.e"
+#include "html.h"
+#include "html.e"
+#include "scan.e"
+
+extern int html_lex(HTML_STYPE *lvalp);
+
+static const conststring names[] = {"DFA only", "scalar", "SSE2", "AVX2"};
+static Arena arena;				/* For the tokens */
+
+
+/* scan -- scan file repeat times, return number of tokens in one pass */
+static long scan(const conststring file, int repeat)
+{
+  char elt[16] = "";
+  HTML_STYPE val;
+  long n = 0;
+  int i, token;
+  FILE *f;
+
+  for (i = 0; i < repeat; i++) {
+    if (!(f = fopen(file, "r"))) {perror(file); exit(2);}
+    set_yyin(f, file);
+    for (n = 0; (token = html_lex(&val)); n++) {
+      /* Do what the tools' start tag handlers do for script and style */
+      if (token == START && strlen(val.s) < sizeof(elt)) strcpy(elt, val.s);
+      else if (token == START) elt[0] = '\0';
+      else if (token == '>' && (!strcasecmp(elt, "script") ||
+				!strcasecmp(elt, "style"))) {
+	set_cdata_element(elt);
+	elt[0] = '\0';
+      }
+    }
+    scanner_reset(NULL);
+    fclose(f);
+    arena_reset(arena);
+  }
+  return n;
+}
+
+/* usage -- print usage message and exit */
+static void usage(const conststring prog)
+{
+  fprintf(stderr, "Usage: %s [-n repeat] [-m mask] file...\n", prog);
+  exit(1);
+}
+
+/* main -- scan each file with each prescanner and print the speed */
+int main(int argc, char *argv[])
+{
+  int c, p, repeat = 10;
+  clock_t t;
+  double mb;
+  FILE *f;
+  long n;
+
+  while ((c = getopt(argc, argv, "n:m:")) != -1)
+    switch (c) {
+      case 'm': set_event_mask(strtoul(optarg, NULL, 0)); break;
+      case 'n': if ((repeat = atoi(optarg)) > 0) break; /* else fall through */
+      default: usage(argv[0]);
+    }
+  if (optind == argc) usage(argv[0]);
+
+  (void) arena_use(arena = arena_new());
+  for (; optind < argc; optind++) {
+    if (!(f = fopen(argv[optind], "r"))) {perror(argv[optind]); exit(2);}
+    fseek(f, 0, SEEK_END);
+    mb = (double)ftell(f) * repeat / 1e6;
+    fclose(f);
+    for (p = PRESCAN_AVX2; p >= PRESCAN_NONE; p--) {
+      if ((int)set_prescan(p) != p) continue;	/* Not supported */
+      t = clock();
+      n = scan(argv[optind], repeat);
+      t = clock() - t;
+      printf("%s: %-8s %8.1f MB/s %10ld tokens\n", argv[optind], names[p],
+	     mb / ((double)(t ? t : 1) / CLOCKS_PER_SEC), n);
+    }
+  }
+  return 0;
+}
@@ -31,6 +31,7 @@
 #include "heap.e"
 #include "types.e"
 #include "errexit.e"
+#include "atom.e"
 
 EXPORT typedef enum {				/* Pseudo-classes & -elements */
   AttrNode,					/* ::attr() */
@@ -65,13 +66,15 @@ EXPORT typedef enum {
 } Combinator;
 
 EXPORT typedef struct _SimpleSelector {
-  string name;					/* NULL is "*" */
+  string name;					/* An atom, NULL is "*" */
   AttribCond *attribs;
   PseudoCond *pseudos;
   PseudoCond *pseudoelts;			/* E.g., ::attr(foo) */
   Combinator combinator;			/* If context not NULL */
   struct _SimpleSelector *context;
   struct _SimpleSelector *next;			/* Comma-separated selectors */
+  unsigned int *keys;				/* Required of ancestors */
+  int nkeys;					/* -1 if not computed yet */
 } SimpleSelector, *Selector;
 
 typedef enum {
@@ -108,9 +111,19 @@ static void push_sel(Selector *selector, Combinator combinator)
   h->context = *selector;
   h->combinator = combinator;
   h->next = NULL;
+  h->keys = NULL;
+  h->nkeys = -1;
   *selector = h;
 }
 
+
+/* append_sel -- add alternative s after the alternatives in list h */
+static void append_sel(Selector h, Selector s)
+{
+  while (h->next) h = h->next;
+  h->next = s;
+}
+
 /* isnmstart -- check if a character can start an identifier */
 static bool isnmstart(unsigned int c)
 {
@@ -247,7 +260,7 @@ EXPORT Selector parse_selector(const string selector, string *rest)
       else if (*s == '+') {s++; push_sel(&sel, Adjacent); state = INIT;}
       else if (*s == '>') {s++; push_sel(&sel, Child); state = INIT;}
       else if (*s == '~') {s++; push_sel(&sel, Sibling); state = INIT;}
-      else if (*s == ',') {h = parse_selector(s+1, &s); h->next = sel; sel = h;}
+      else if (*s == ',') {h = parse_selector(s+1, &s); append_sel(h, sel); sel = h;}
       else if (*s == ')') {*rest = s; return sel;}
       else {push_sel(&sel, Descendant); state = INIT;}
       break;
@@ -257,7 +270,8 @@ EXPORT Selector parse_selector(const string selector, string *rest)
       else if (*s == '#') {s++; state = ID;}
       else if (*s == '[') {s++; state = ATTR;}
       else if (*s == ':') {s++; state = PSEUDO;}
-      else if (isnmstart(*s)) {sel->name = parse_ident(&s); state = AFTER_TYPE;}
+      else if (isnmstart(*s)) {name = parse_ident(&s);
+	sel->name = (string)atom(name); dispose(name); state = AFTER_TYPE;}
       else errexit("Unexpected \"%c\"\n", *s);
       break;
     case AFTER_TYPE:				/* After a type sel */
@@ -618,3 +632,38 @@ EXPORT void dump_selector(FILE *f, const Selector s)
   }
   dump_simple_selector(f, s);
  }
+
+/* looks_ahead -- true if s needs to see what follows an element's start tag */
+EXPORT bool looks_ahead(const Selector s)
+{
+  PseudoCond *p;
+
+  if (!s) return false;
+  for (p = s->pseudos; p; p = p->next)
+    switch (p->type) {
+    case NthLastChild: case NthLastOfType: case LastChild: case LastOfType:
+    case OnlyChild: case OnlyOfType: case Empty: return true;
+    case Not: if (looks_ahead(p->sel)) return true; break;
+    default: break;
+    }
+  return looks_ahead(s->context) || looks_ahead(s->next);
+}
+
+/* looks_behind -- true if s needs more sisters than the previous element */
+EXPORT bool looks_behind(const Selector s)
+{
+  PseudoCond *p;
+
+  if (!s) return false;
+  if (s->context && s->combinator == Sibling) return true;
+  if (s->context && s->combinator == Adjacent && s->context->context
+      && s->context->combinator == Adjacent) return true; /* "a + b + c" */
+  for (p = s->pseudos; p; p = p->next)
+    switch (p->type) {
+    case NthOfType: case FirstOfType: case NthLastOfType: case LastOfType:
+    case OnlyOfType: return true;
+    case Not: if (looks_behind(p->sel)) return true; break;
+    default: break;
+    }
+  return looks_behind(s->context) || looks_behind(s->next);
+}
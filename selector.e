@@ -33,7 +33,13 @@ typedef struct _SimpleSelector {
   Combinator combinator;
   struct _SimpleSelector *context;
   struct _SimpleSelector *next;
+  unsigned int *keys;
+  int nkeys;
 } SimpleSelector, *Selector;
 extern Selector parse_selector(const string selector, string *rest);
 extern void dump_simple_selector(FILE *f, const SimpleSelector *s);
 extern void dump_selector(FILE *f, const Selector s);
+extern _Bool 
+           looks_ahead(const Selector s);
+extern _Bool 
+           looks_behind(const Selector s);
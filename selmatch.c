@@ -1,6 +1,27 @@
 /*
  * Match a selector against a element in a document tree.
  *
+ * Selectors are matched right to left: the subject first, then its
+ * context. Callers that walk the tree can tell which element they
+ * enter and leave (match_enter(), match_leave()). That allows two
+ * shortcuts:
+ *
+ * A counting Bloom filter holds the tag names, classes and IDs of all
+ * entered elements. If an element is matched whose parent is the
+ * innermost entered element, the filter holds exactly its ancestors,
+ * and a selector that requires an ancestor with a name, class or ID
+ * that is not in the filter fails without walking up the tree.
+ *
+ * For "a ~ b", each entered element remembers, for a few selectors,
+ * how far its children have been scanned for a match of "a" and
+ * whether one was found, so later sisters don't rescan the earlier
+ * ones.
+ *
+ * A set of rules (ruleset_create(), ruleset_add()) matches many
+ * selectors in one pass over the document: each element is only
+ * tested against the rules that could apply to its ID, classes and
+ * tag name.
+ *
  * Part of HTML-XML-utils, see:
  * http://www.w3.org/Tools/HTML-XML-utils/
  *
@@ -28,10 +49,29 @@
 #include "export.h"
 #include "heap.e"
 #include "errexit.e"
+#include "atom.e"
+
 
+#define BLOOM_SIZE 4096				/* Must be a power of 2 */
+#define NMEMO 4					/* Memos per entered element */
+
+typedef struct {
+  const SimpleSelector *sel;			/* A selector "a ~ b" */
+  const Node *upto;				/* Last child tested for "a" */
+  bool found;					/* Whether one matched */
+} SisterMemo;
+
+typedef struct {
+  const Node *node;				/* An entered element */
+  SisterMemo memo[NMEMO];
+  int nmemo;
+} Frame;
 
 static conststring language = "";		/* Initial language */
 static bool case_insensitive = false;		/* How to match elems/attrs */
+static unsigned char bloom[BLOOM_SIZE];		/* Keys of entered elements */
+static Frame *stack = NULL;			/* Entered elements */
+static int depth = 0, stacksize = 0;		/* Used and allocated */
 
 
 bool matches_sel(const Tree t, const Selector s);
@@ -72,20 +112,166 @@ EXPORT bool same(const string a, const string b)
 }
 
 
+/* same_name -- compare two element names that are atoms */
+static bool same_name(const conststring a, const conststring b)
+{
+  return a == b || (case_insensitive && strcasecmp(a, b) == 0);
+}
+
+
+/* key -- hash a name of type kind ('t', 'c' or 'i'), ignoring case */
+static unsigned int key(char kind, const char *s, size_t n)
+{
+  unsigned int h = 2166136261U ^ (unsigned char)kind;
+
+  while (n--) h = (h ^ tolower((unsigned char)*(s++))) * 16777619U;
+  return h;
+}
+
+
+/* bloom_add -- add (delta = 1) or remove (delta = -1) a key */
+static void bloom_add(unsigned int h, int delta)
+{
+  unsigned char *c1 = &bloom[h & (BLOOM_SIZE - 1)];
+  unsigned char *c2 = &bloom[(h >> 12) & (BLOOM_SIZE - 1)];
+
+  /* A counter that overflowed stays at the maximum, which is safe */
+  if (*c1 != 255) *c1 += delta;
+  if (*c2 != 255) *c2 += delta;
+}
+
+
+/* bloom_has -- check if a key may be in the filter */
+static bool bloom_has(unsigned int h)
+{
+  return bloom[h & (BLOOM_SIZE - 1)] && bloom[(h >> 12) & (BLOOM_SIZE - 1)];
+}
+
+
+/* bloom_node -- add or remove the tag name, classes and ID of n */
+static void bloom_node(const Node *n, int delta)
+{
+  pairlist p;
+  string s;
+  size_t len;
+
+  if (n->tp != Element) return;
+  bloom_add(key('t', n->name, strlen(n->name)), delta);
+  for (p = n->attribs; p; p = p->next)
+    if (same(p->name, (string)"id")) {
+      bloom_add(key('i', p->value, strlen(p->value)), delta);
+    } else if (same(p->name, (string)"class")) {
+      for (s = p->value; *s; s += len) {
+	while (isspace(*s)) s++;
+	for (len = 0; s[len] && !isspace(s[len]); len++) ;
+	if (len) bloom_add(key('c', s, len), delta);
+      }
+    }
+}
+
+
+/* match_enter -- tell the matcher that the children of n will be matched */
+EXPORT void match_enter(const Node *n)
+{
+  Arena prev;
+
+  if (depth == stacksize) {
+    prev = arena_use(NULL);			/* Outlives any document */
+    renewarray(stack, stacksize += 32);
+    (void) arena_use(prev);
+  }
+  stack[depth].node = n;
+  stack[depth].nmemo = 0;
+  depth++;
+  bloom_node(n, 1);
+}
+
+
+/* match_leave -- undo the last match_enter() */
+EXPORT void match_leave(void)
+{
+  assert(depth > 0);
+  bloom_node(stack[--depth].node, -1);
+}
+
+
+/* match_reset -- leave all entered elements, e.g., before a new document */
+EXPORT void match_reset(void)
+{
+  depth = 0;
+  memset(bloom, 0, sizeof(bloom));
+}
+
+
+/* add_keys -- add the names, classes and IDs required by s to keys */
+static void add_keys(Selector s, unsigned int **keys, int *nkeys)
+{
+  AttribCond *a;
+
+  if (s->name) {
+    renewarray(*keys, *nkeys + 1);
+    (*keys)[(*nkeys)++] = key('t', s->name, strlen(s->name));
+  }
+  for (a = s->attribs; a; a = a->next)
+    if (a->op == HasClass || a->op == HasID) {
+      renewarray(*keys, *nkeys + 1);
+      (*keys)[(*nkeys)++] = key(a->op == HasID ? 'i' : 'c', a->value,
+				strlen(a->value));
+    }
+}
+
+
+/* compile -- compute the keys that the ancestors of s's subject must have */
+static void compile(Selector s)
+{
+  Arena prev = arena_use(NULL);			/* Selectors outlive documents */
+  Selector h;
+
+  /* After "a b" or "a > b", a is an ancestor; after "a + b" or "a ~
+     b", a is not, but the ancestors of a are ancestors of b */
+  s->nkeys = 0;
+  for (h = s; h->context; h = h->context)
+    if (h->combinator == Descendant || h->combinator == Child)
+      add_keys(h->context, &s->keys, &s->nkeys);
+  (void) arena_use(prev);
+}
+
+
+/* find_frame -- return the frame of entered element n, or NULL */
+static Frame *find_frame(const Node *n)
+{
+  int i;
+
+  for (i = depth - 1; i >= 0; i--) if (stack[i].node == n) return &stack[i];
+  return NULL;
+}
+
+
 /* count_siblings - compute own index and total number of siblings of t */
 static void count_siblings(const Node *n,
 			   int *index,     /* Index of n among its siblings */
-			   int *typeindex, /* Index among those of same type */
-			   int *total,     /* Total # of siblings, including n */
-			   int *typetotal) /* Total # of siblings of same type */
+			   int *total)     /* Total # of siblings, including n */
 {
   Node *h;
 
-  for (*total = *typetotal = 0, h = n->parent->children; h; h = h->sister)
-    if (h->tp == Element) {
-      (*total)++;
-      if (same(h->name, n->name)) (*typetotal)++;
-      if (h == n) {*index = *total; *typeindex = *typetotal;}
+  /* The tree keeps the index of each element among its sisters */
+  for (h = n->parent->lastchild; h->tp != Element; h = h->prev) ;
+  *index = n->index;
+  *total = h->index;
+}
+
+
+/* count_type_siblings - compute index and number of siblings of same type */
+static void count_type_siblings(const Node *n,
+				int *typeindex, /* Index among those of same type */
+				int *typetotal) /* Total # of same type, incl. n */
+{
+  Node *h;
+
+  for (*typetotal = 0, h = n->parent->children; h; h = h->sister)
+    if (h->tp == Element && same_name(h->name, n->name)) {
+      (*typetotal)++;
+      if (h == n) *typeindex = *typetotal;
     }
 }
 
@@ -170,7 +356,7 @@ static bool simple_match(const Tree n, const SimpleSelector *s)
   if (s->pseudoelts) return false;
 
   /* Match the type selector */
-  if (s->name && !same(s->name, n->name)) return false;
+  if (s->name && !same_name(s->name, n->name)) return false;
 
   /* Match the attribute selectors, including class and ID */
   for (p = s->attribs; p; p = p->next) {
@@ -198,49 +384,49 @@ static bool simple_match(const Tree n, const SimpleSelector *s)
       if (n->parent->tp != Root) return false;
       break;
     case NthChild:
-      if (index == 0) count_siblings(n, &index, &tpindex, &total, &tptotal);
+      if (index == 0) count_siblings(n, &index, &total);
       if (q->a == 0) return index == q->b;
       else return (index - q->b) % q->a == 0 && (index - q->b) / q->a >= 0;
       break;
     case NthLastChild:
-      if (index == 0) count_siblings(n, &index, &tpindex, &total, &tptotal);
-      if (q->a == 0) return total - tpindex + 1 == q->b;
-      else return (total - tpindex + 1 - q->b) % q->a == 0
-	     && (total - tpindex + 1 - q->b) / q->a >= 0;
+      if (index == 0) count_siblings(n, &index, &total);
+      if (q->a == 0) return total - index + 1 == q->b;
+      else return (total - index + 1 - q->b) % q->a == 0
+	     && (total - index + 1 - q->b) / q->a >= 0;
       break;
     case NthOfType:
-      if (index == 0) count_siblings(n, &index, &tpindex, &total, &tptotal);
+      if (tpindex == 0) count_type_siblings(n, &tpindex, &tptotal);
       if (q->a == 0) return tpindex == q->b;
       else return (tpindex - q->b) % q->a == 0 && (tpindex - q->b) / q->a >= 0;
       break;
     case NthLastOfType:
-      if (tpindex == 0) count_siblings(n, &index, &tpindex, &total, &tptotal);
+      if (tpindex == 0) count_type_siblings(n, &tpindex, &tptotal);
       if (q->a == 0) return tptotal - tpindex + 1 == q->b;
       else return (tptotal - tpindex + 1 - q->b) % q->a == 0
 	     && (tptotal - tpindex + 1 - q->b) / q->a >= 0;
       break;
     case FirstChild:
-      if (index == 0) count_siblings(n, &index, &tpindex, &total, &tptotal);
+      if (index == 0) count_siblings(n, &index, &total);
       return index == 1;
       break;
     case LastChild:
-      if (index == 0) count_siblings(n, &index, &tpindex, &total, &tptotal);
+      if (index == 0) count_siblings(n, &index, &total);
       return index == total;
       break;
     case FirstOfType:
-      if (tpindex == 0) count_siblings(n, &index, &tpindex, &total, &tptotal);
+      if (tpindex == 0) count_type_siblings(n, &tpindex, &tptotal);
       return tpindex == 1;
       break;
     case LastOfType:
-      if (tpindex == 0) count_siblings(n, &index, &tpindex, &total, &tptotal);
+      if (tpindex == 0) count_type_siblings(n, &tpindex, &tptotal);
       return tpindex == tptotal;
       break;
     case OnlyChild:
-      if (index == 0) count_siblings(n, &index, &tpindex, &total, &tptotal);
+      if (index == 0) count_siblings(n, &index, &total);
       return total == 1;
       break;
     case OnlyOfType:
-      if (tpindex == 0) count_siblings(n, &index, &tpindex, &total, &tptotal);
+      if (tpindex == 0) count_type_siblings(n, &tpindex, &tptotal);
       return tptotal == 1;
       break;
     case Empty:
@@ -262,16 +448,56 @@ static bool simple_match(const Tree n, const SimpleSelector *s)
 }
 
 
-/* matches_sel -- check if an element t matches the selector s */
-EXPORT bool matches_sel(const Tree t, const Selector s)
+/* sister_matches -- check if an earlier sister of t matches s->context */
+static bool sister_matches(const Tree t, const Selector s)
 {
-  Tree g, h;
+  SisterMemo *m = NULL;
+  Frame *f;
+  Tree h;
+  int i;
+
+  /* Continue where the scan for an earlier sister of t stopped */
+  if ((f = find_frame(t->parent))) {
+    for (i = 0; i < f->nmemo && f->memo[i].sel != s; i++) ;
+    if (i < f->nmemo) {
+      m = &f->memo[i];
+    } else {
+      if (f->nmemo < NMEMO) m = &f->memo[f->nmemo++];
+      else m = &f->memo[((size_t)s >> 4) % NMEMO]; /* Replace one */
+      m->sel = s; m->upto = NULL; m->found = false;
+    }
+    if (m->upto && m->upto->index >= t->index) {	/* t is before upto */
+      m->upto = NULL; m->found = false;
+    }
+    if (m->found) return true;
+  }
+  for (h = m && m->upto ? m->upto->sister : t->parent->children; h != t;
+       h = h->sister)
+    if (h->tp == Element) {
+      if (m) m->upto = h;
+      if (matches_sel(h, s->context)) {
+	if (m) m->found = true;
+	return true;
+      }
+    }
+  return false;
+}
 
-  assert(s);
-  if (!t || t->tp == Root) return false;
-  assert(t->tp == Element);
-  if (!simple_match(t, s)) return s->next && matches_sel(t, s->next);
+
+/* matches_one -- check if t matches s, ignoring s's comma-separated list */
+static bool matches_one(const Tree t, const Selector s)
+{
+  Tree h;
+  int i;
+
+  if (!simple_match(t, s)) return false;
   if (!s->context) return true;
+
+  /* If all ancestors are entered, check the filter for required ones */
+  if (s->nkeys < 0) compile(s);
+  if (depth > 0 && stack[depth-1].node == t->parent)
+    for (i = 0; i < s->nkeys; i++) if (!bloom_has(s->keys[i])) return false;
+
   switch (s->combinator) {
   case Descendant:
     for (h = t->parent; h->tp != Root && !matches_sel(h, s->context);
@@ -280,15 +506,277 @@ EXPORT bool matches_sel(const Tree t, const Selector s)
   case Child:
     return matches_sel(t->parent, s->context);
   case Adjacent:
-    for (g = NULL, h = t->parent->children; h != t; h = h->sister)
-      if (h->tp == Element) g = h;
-    return g && matches_sel(g, s->context);
+    for (h = t->prev; h && h->tp != Element; h = h->prev) ;
+    return h && matches_sel(h, s->context);
   case Sibling:
-    for (h = t->parent->children; h != t; h = h->sister)
-      if (matches_sel(h, s->context)) return true;
-    return false;
+    return sister_matches(t, s);
   default:
     assert(!"Cannot happen");
     return false;
   }
 }
+
+
+/* matches_sel -- check if an element t matches the selector s */
+EXPORT bool matches_sel(const Tree t, const Selector s)
+{
+  Selector h;
+
+  assert(s);
+  if (!t || t->tp == Root) return false;
+  assert(t->tp == Element);
+  for (h = s; h; h = h->next) if (matches_one(t, h)) return true;
+  return false;
+}
+
+
+
+/************************** Sets of rules **************************/
+
+/* A rule set holds many selectors (rules), each with a label. Every
+   alternative of a comma-separated selector is put in a bucket by the
+   ID, the class or the tag name of its subject, in that order of
+   preference, or in the universal list if it has none of them. An
+   element is only tested against the alternatives in the buckets of
+   its own ID, classes and tag name, and those in the universal list. */
+
+EXPORT typedef struct {
+  int rule;					/* Index of the matched rule */
+  Selector sel;					/* The alternative that matched */
+} RuleMatch;
+
+typedef struct {
+  Selector sel;					/* One alternative */
+  int rule;					/* Index of its rule */
+  bool keyed;					/* False if in universal list */
+  unsigned int key;				/* Else its bucket key */
+  int next;					/* Next in same list, or -1 */
+  unsigned int stamp;				/* To avoid testing twice */
+} Alternative;
+
+EXPORT typedef struct _RuleSet *RuleSet;
+
+struct _RuleSet {
+  Alternative *alts;				/* In order of the rules */
+  int nalts;
+  int *buckets;					/* Heads of lists, or -1 */
+  int nbuckets;					/* A power of 2 */
+  int universal;				/* Head of list, or -1 */
+  bool dirty;					/* Buckets need rebuilding? */
+  string *labels;				/* Label of each rule */
+  Selector *rules;				/* Selector of each rule */
+  int nrules;
+  int *found;					/* Alternatives that matched */
+  RuleMatch *matches;				/* Result of ruleset_match() */
+  unsigned int stamp;
+};
+
+
+/* ruleset_create -- create an empty set of rules */
+EXPORT RuleSet ruleset_create(void)
+{
+  RuleSet rs;
+
+  new(rs);
+  rs->alts = NULL;
+  rs->nalts = 0;
+  rs->buckets = NULL;
+  rs->nbuckets = 0;
+  rs->universal = -1;
+  rs->dirty = false;
+  rs->labels = NULL;
+  rs->rules = NULL;
+  rs->nrules = 0;
+  rs->found = NULL;
+  rs->matches = NULL;
+  rs->stamp = 0;
+  return rs;
+}
+
+
+/* bucket_key -- compute the key of an alternative, false if it has none */
+static bool bucket_key(Selector s, unsigned int *k)
+{
+  AttribCond *a;
+
+  if (s->pseudoelts) s = s->context;		/* "e::attr(x)" is keyed on e */
+  for (a = s->attribs; a; a = a->next)
+    if (a->op == HasID) {*k = key('i', a->value, strlen(a->value)); return true;}
+  for (a = s->attribs; a; a = a->next)
+    if (a->op == HasClass) {*k = key('c', a->value, strlen(a->value)); return true;}
+  if (s->name) {*k = key('t', s->name, strlen(s->name)); return true;}
+  return false;
+}
+
+
+/* ruleset_add -- add selector s as a new rule, return the rule's index */
+EXPORT int ruleset_add(RuleSet rs, Selector s, const conststring label)
+{
+  Arena prev = arena_use(NULL);			/* Rules outlive documents */
+  Alternative *alt;
+  Selector h;
+  int i;
+
+  renewarray(rs->labels, rs->nrules + 1);
+  renewarray(rs->rules, rs->nrules + 1);
+  rs->labels[rs->nrules] = newstring(label);
+  rs->rules[rs->nrules] = s;
+
+  /* The alternatives are linked in reverse; store them in source order */
+  for (h = s; h; h = h->next) rs->nalts++;
+  renewarray(rs->alts, rs->nalts);
+  renewarray(rs->found, rs->nalts);
+  renewarray(rs->matches, rs->nalts);
+  for (h = s, i = rs->nalts - 1; h; h = h->next, i--) {
+    alt = &rs->alts[i];
+    alt->sel = h;
+    alt->rule = rs->nrules;
+    alt->keyed = bucket_key(h, &alt->key);
+    alt->stamp = 0;
+  }
+  rs->dirty = true;
+  (void) arena_use(prev);
+  return rs->nrules++;
+}
+
+
+/* build -- distribute the alternatives over the buckets */
+static void build(RuleSet rs)
+{
+  Arena prev = arena_use(NULL);
+  int i, *head;
+
+  for (rs->nbuckets = 64; rs->nbuckets < 2 * rs->nalts; rs->nbuckets *= 2) ;
+  renewarray(rs->buckets, rs->nbuckets);
+  for (i = 0; i < rs->nbuckets; i++) rs->buckets[i] = -1;
+  rs->universal = -1;
+  for (i = rs->nalts - 1; i >= 0; i--) {	/* Lists end up in order */
+    head = rs->alts[i].keyed
+      ? &rs->buckets[rs->alts[i].key & (rs->nbuckets - 1)] : &rs->universal;
+    rs->alts[i].next = *head;
+    *head = i;
+  }
+  rs->dirty = false;
+  (void) arena_use(prev);
+}
+
+
+/* try_list -- test t against the alternatives in a list, collect matches */
+static void try_list(RuleSet rs, const Tree t, int i, int *n)
+{
+  Alternative *alt;
+  bool ok;
+
+  for (; i >= 0; i = alt->next) {
+    alt = &rs->alts[i];
+    if (alt->stamp == rs->stamp) continue;	/* Already tested */
+    alt->stamp = rs->stamp;
+    if (alt->sel->pseudoelts) ok = matches_one(t, alt->sel->context);
+    else ok = matches_one(t, alt->sel);
+    if (ok) rs->found[(*n)++] = i;
+  }
+}
+
+
+/* compare_ints -- compare two integers, for qsort() */
+static int compare_ints(const void *a, const void *b)
+{
+  return *(const int*)a - *(const int*)b;
+}
+
+
+/* ruleset_match -- find the rules that t matches, return their number */
+EXPORT int ruleset_match(RuleSet rs, const Tree t, RuleMatch **matches)
+{
+  pairlist p;
+  string s;
+  size_t len;
+  int i, n = 0;
+
+  assert(t && t->tp == Element);
+  if (rs->dirty) build(rs);
+  rs->stamp++;
+#define TRY(k) try_list(rs, t, rs->buckets[(k) & (rs->nbuckets - 1)], &n)
+  for (p = t->attribs; p; p = p->next)
+    if (same(p->name, (string)"id")) {
+      TRY(key('i', p->value, strlen(p->value)));
+    } else if (same(p->name, (string)"class")) {
+      for (s = p->value; *s; s += len) {
+	while (isspace(*s)) s++;
+	for (len = 0; s[len] && !isspace(s[len]); len++) ;
+	if (len) TRY(key('c', s, len));
+      }
+    }
+  TRY(key('t', t->name, strlen(t->name)));
+#undef TRY
+  try_list(rs, t, rs->universal, &n);
+
+  /* Report in the order of the rules, whatever bucket they came from */
+  if (n > 1) qsort(rs->found, n, sizeof(*rs->found), compare_ints);
+  for (i = 0; i < n; i++) {
+    rs->matches[i].rule = rs->alts[rs->found[i]].rule;
+    rs->matches[i].sel = rs->alts[rs->found[i]].sel;
+  }
+  *matches = rs->matches;
+  return n;
+}
+
+
+/* ruleset_label -- return the label of a rule */
+EXPORT conststring ruleset_label(const RuleSet rs, int rule)
+{
+  assert(rule >= 0 && rule < rs->nrules);
+  return rs->labels[rule];
+}
+
+
+/* ruleset_looks_ahead -- true if any rule needs what follows a start tag */
+EXPORT bool ruleset_looks_ahead(const RuleSet rs)
+{
+  int i;
+
+  for (i = 0; i < rs->nrules; i++) if (looks_ahead(rs->rules[i])) return true;
+  return false;
+}
+
+
+/* ruleset_looks_behind -- true if any rule needs more than one sister */
+EXPORT bool ruleset_looks_behind(const RuleSet rs)
+{
+  int i;
+
+  for (i = 0; i < rs->nrules; i++) if (looks_behind(rs->rules[i])) return true;
+  return false;
+}
+
+
+/* ruleset_read -- add rules from a file, one "[label TAB] selector" a line */
+EXPORT void ruleset_read(RuleSet rs, FILE *f, const conststring name)
+{
+  string line = NULL, sel, rest;
+  char label[20];
+  size_t size = 0;
+  ssize_t len;
+  Selector s;
+  int lineno = 0;
+
+  while ((len = getline(&line, &size, f)) != -1) {
+    lineno++;
+    if (len > 0 && line[len-1] == '\n') line[--len] = '\0';
+    for (sel = line; isspace(*sel) || (sel[0] == '/' && sel[1] == '*');)
+      if (!isspace(*sel) && (rest = strstr(sel + 2, "*/"))) sel = rest + 2;
+      else if (!isspace(*sel)) break;		/* Unclosed comment */
+      else sel++;
+    if (*sel == '\0') continue;		/* Empty or only a comment */
+    if ((sel = strchr(line, '\t'))) {		/* Label and selector */
+      *(sel++) = '\0';
+    } else {					/* Line number is label */
+      sprintf(label, "%d", lineno);
+      sel = line;
+    }
+    s = parse_selector(sel, &rest);
+    if (*rest) errexit("%s:%d: syntax error at \"%c\"\n", name, lineno, *rest);
+    (void) ruleset_add(rs, s, sel == line ? label : line);
+  }
+  free(line);
+}
@@ -2,5 +2,22 @@ extern void init_language(const conststring lang);
 extern void set_case_insensitive(void);
 extern _Bool 
            same(const string a, const string b);
+extern void match_enter(const Node *n);
+extern void match_leave(void);
+extern void match_reset(void);
 extern _Bool 
            matches_sel(const Tree t, const Selector s);
+typedef struct {
+  int rule;
+  Selector sel;
+} RuleMatch;
+typedef struct _RuleSet *RuleSet;
+extern RuleSet ruleset_create(void);
+extern int ruleset_add(RuleSet rs, Selector s, const conststring label);
+extern int ruleset_match(RuleSet rs, const Tree t, RuleMatch **matches);
+extern conststring ruleset_label(const RuleSet rs, int rule);
+extern _Bool 
+           ruleset_looks_ahead(const RuleSet rs);
+extern _Bool 
+           ruleset_looks_behind(const RuleSet rs);
+extern void ruleset_read(RuleSet rs, FILE *f, const conststring name);
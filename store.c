@@ -0,0 +1,576 @@
+/*
+ * A compact, read-only copy of a document tree, and its file format.
+ *
+ * A Store holds the nodes of a tree in parallel arrays, indexed by
+ * 32-bit node numbers in document order (pre-order), instead of as
+ * linked Node structs. Node 1 is the root and 0 means "no node". The
+ * first child of a node, if any, is always the next node, so only the
+ * parent and the next sister are stored. All strings are in one pool
+ * and are referred to by their offset; element and attribute names and
+ * attribute values are stored only once. The attributes of an element
+ * are consecutive entries in a separate table, ended by an entry with
+ * a name of 0. A declaration uses one such entry for its public and
+ * system identifier.
+ *
+ * A node costs 17 bytes plus its text, against 88 bytes plus its text
+ * and the overhead of several allocations for a Node.
+ *
+ * A store is built by adding nodes in document order, see
+ * tree_to_store() in tree.c. It can be written to a file, a
+ * "snapshot," which holds the same arrays after a header. Reading a
+ * snapshot maps the file into memory if possible, so it costs little
+ * more than checking that the arrays are consistent. The parser
+ * replays a snapshot as if it was parsing the document, see
+ * html_parser_run().
+ *
+ * Part of HTML-XML-utils, see:
+ * http://www.w3.org/Tools/HTML-XML-utils/
+ *
+ * Copyright © 2026 World Wide Web Consortium
+ * See http://www.w3.org/Consortium/Legal/copyright-software
+ *
+ * Author: agent <agent@local>
+ * Created: 17 Oct 2026
+ **/
+#include "config.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#ifdef HAVE_STRING_H
+#  include <string.h>
+#elif HAVE_STRINGS_H
+#  include <strings.h>
+#endif
+#if HAVE_SYS_MMAN_H && HAVE_MMAP
+#  include <sys/types.h>
+#  include <sys/stat.h>
+#  include <sys/mman.h>
+#  define USE_MMAP 1
+#endif
+#include "export.h"
+#include "types.e"
+#include "heap.e"
+#include "tree.e"
+#include "errexit.e"
+
+EXPORT typedef uint32_t NodeId;		/* A node in a Store, 0 = none */
+EXPORT typedef struct _Store *Store;
+
+#define EMPTY 0x80			/* Flag in tp[]: element has no end tag */
+
+struct _Store {
+  NodeId nnodes, nodes_size;		/* # of nodes + 1, # allocated */
+  unsigned char *tp;			/* Nodetype (+ EMPTY) of each node */
+  NodeId *parent;			/* Parent of each node */
+  NodeId *sister;			/* Next sister of each node */
+  uint32_t *data;			/* Name or text of each node */
+  uint32_t *extra;			/* First attribute of each node */
+  uint32_t nattrs, attrs_size;		/* # of attributes + 1, # allocated */
+  uint32_t *attr_name;			/* Name of each attribute */
+  uint32_t *attr_value;			/* Value of each attribute */
+  char *pool;				/* All strings, offset 0 is NULL */
+  uint32_t pool_len, pool_size;		/* Used and allocated bytes */
+  uint32_t *dict;			/* Hash table of shared strings */
+  uint32_t dict_size, dict_count;	/* # of slots, # used */
+  char *image;				/* Snapshot the arrays are in, or NULL */
+  size_t image_size;			/* Size of the snapshot */
+  bool mapped;				/* Image is mmap'ed rather than read? */
+};
+
+/* The header of a snapshot, followed by tp[] (padded to a multiple of
+   4 bytes), parent[], sister[], data[], extra[], attr_name[],
+   attr_value[] and pool[]. Numbers are in the byte order of the
+   machine that wrote it. */
+#define MAGIC "\177hxsnap"			/* 7 bytes and a NUL */
+#define FORMAT_VERSION 1
+#define BYTE_ORDER_MARK 0x01020304
+typedef struct {
+  char magic[8];
+  uint32_t version, order, nnodes, nattrs, pool_len, reserved;
+} Header;
+
+
+/* hash -- compute a hash of s (FNV-1a) */
+static uint32_t hash(const conststring s)
+{
+  const unsigned char *p;
+  uint32_t h = 2166136261U;
+
+  for (p = (const unsigned char *)s; *p; p++) h = (h ^ *p) * 16777619U;
+  return h;
+}
+
+
+/* add_string -- copy s to the pool, return its offset */
+static uint32_t add_string(Store st, const conststring s)
+{
+  size_t n;
+  uint32_t offset;
+
+  if (!s) return 0;
+  n = strlen(s) + 1;
+  if (st->pool_len + n > UINT32_MAX) errexit("Document too large to store\n");
+  if (st->pool_len + n > st->pool_size) {
+    st->pool_size = st->pool_len + n > UINT32_MAX / 2 ? UINT32_MAX
+      : 2 * (st->pool_len + n);
+    renewarray(st->pool, st->pool_size);
+  }
+  offset = st->pool_len;
+  memcpy(st->pool + offset, s, n);
+  st->pool_len += n;
+  return offset;
+}
+
+
+/* share_string -- return the offset of s, adding it to the pool if needed */
+static uint32_t share_string(Store st, const conststring s)
+{
+  uint32_t i, *old, oldsize;
+
+  if (!s) return 0;
+  if (2 * (st->dict_count + 1) > st->dict_size) {
+    old = st->dict;
+    oldsize = st->dict_size;
+    st->dict_size = oldsize ? 2 * oldsize : 256;
+    newarray(st->dict, st->dict_size);
+    for (i = 0; i < st->dict_size; i++) st->dict[i] = 0;
+    while (oldsize--)
+      if (old[oldsize]) {
+	for (i = hash(st->pool + old[oldsize]) & (st->dict_size - 1);
+	     st->dict[i]; i = (i + 1) & (st->dict_size - 1)) ;
+	st->dict[i] = old[oldsize];
+      }
+    dispose(old);
+  }
+  for (i = hash(s) & (st->dict_size - 1); st->dict[i];
+       i = (i + 1) & (st->dict_size - 1))
+    if (eq(st->pool + st->dict[i], s)) return st->dict[i];
+  st->dict_count++;
+  return st->dict[i] = add_string(st, s);
+}
+
+
+/* add_attr -- add an entry to the attribute table, return its index */
+static uint32_t add_attr(Store st, uint32_t name, uint32_t value)
+{
+  if (st->nattrs == st->attrs_size) {
+    if (st->attrs_size > UINT32_MAX / 2) errexit("Too many attributes\n");
+    st->attrs_size *= 2;
+    renewarray(st->attr_name, st->attrs_size);
+    renewarray(st->attr_value, st->attrs_size);
+  }
+  st->attr_name[st->nattrs] = name;
+  st->attr_value[st->nattrs] = value;
+  return st->nattrs++;
+}
+
+
+/* add_node -- add a child of parent as the next node in document order */
+static NodeId add_node(Store st, unsigned char tp, NodeId parent,
+		       uint32_t data, uint32_t extra)
+{
+  NodeId n, id = st->nnodes;
+
+  assert(!st->image);				/* Snapshots are read-only */
+  assert(parent > 0 && parent < id);
+  if (id == st->nodes_size) {
+    if (st->nodes_size > UINT32_MAX / 2) errexit("Too many nodes\n");
+    st->nodes_size *= 2;
+    renewarray(st->tp, st->nodes_size);
+    renewarray(st->parent, st->nodes_size);
+    renewarray(st->sister, st->nodes_size);
+    renewarray(st->data, st->nodes_size);
+    renewarray(st->extra, st->nodes_size);
+  }
+  st->tp[id] = tp;
+  st->parent[id] = parent;
+  st->sister[id] = 0;
+  st->data[id] = data;
+  st->extra[id] = extra;
+  st->nnodes++;
+
+  /* The previous sister, if any, is the ancestor-or-self of the
+     previous node that is a child of parent. Each node is passed over
+     only once, after its last descendant has been added. */
+  for (n = id - 1; n != parent && st->parent[n] != parent; n = st->parent[n])
+    assert(n > parent);
+  if (n != parent) st->sister[n] = id;
+  return id;
+}
+
+
+/* store_create -- create a store with only a root node */
+EXPORT Store store_create(void)
+{
+  Store st;
+
+  new(st);
+  st->nodes_size = 1024;
+  newarray(st->tp, st->nodes_size);
+  newarray(st->parent, st->nodes_size);
+  newarray(st->sister, st->nodes_size);
+  newarray(st->data, st->nodes_size);
+  newarray(st->extra, st->nodes_size);
+  st->tp[0] = st->tp[1] = Root;			/* Node 0 is not used */
+  st->parent[0] = st->sister[0] = st->data[0] = st->extra[0] = 0;
+  st->parent[1] = st->sister[1] = st->data[1] = st->extra[1] = 0;
+  st->nnodes = 2;
+  st->attrs_size = 256;
+  newarray(st->attr_name, st->attrs_size);
+  newarray(st->attr_value, st->attrs_size);
+  st->attr_name[0] = st->attr_value[0] = 0;	/* Attribute 0 is not used */
+  st->nattrs = 1;
+  st->pool = NULL;
+  st->pool_len = st->pool_size = 0;
+  (void) add_string(st, "");			/* Offset 0 stands for NULL */
+  st->dict = NULL;
+  st->dict_size = st->dict_count = 0;
+  st->image = NULL;
+  st->mapped = false;
+  return st;
+}
+
+
+/* store_add_element -- add an element as the last child of parent */
+EXPORT NodeId store_add_element(Store st, NodeId parent,
+				const conststring name, const pairlist attribs,
+				bool empty)
+{
+  uint32_t first = 0, a;
+  pairlist p;
+
+  for (p = attribs; p; p = p->next) {
+    a = add_attr(st, share_string(st, p->name), share_string(st, p->value));
+    if (!first) first = a;
+  }
+  if (first) (void) add_attr(st, 0, 0);		/* End of the list */
+  return add_node(st, Element | (empty ? EMPTY : 0), parent,
+		  share_string(st, name), first);
+}
+
+
+/* store_add_text -- add a Text, Comment or Procins as last child of parent */
+EXPORT NodeId store_add_text(Store st, NodeId parent, Nodetype tp,
+			     const conststring text)
+{
+  assert(tp == Text || tp == Comment || tp == Procins);
+  return add_node(st, tp, parent, add_string(st, text), 0);
+}
+
+
+/* store_add_declaration -- add a declaration as the last child of parent */
+EXPORT NodeId store_add_declaration(Store st, NodeId parent,
+				    const conststring name,
+				    const conststring fpi,
+				    const conststring url)
+{
+  uint32_t a = add_attr(st, add_string(st, fpi), add_string(st, url));
+
+  return add_node(st, Declaration, parent, share_string(st, name), a);
+}
+
+
+/* store_delete -- free the memory occupied by a store */
+EXPORT void store_delete(Store st)
+{
+  if (!st->image) {
+    dispose(st->tp);
+    dispose(st->parent);
+    dispose(st->sister);
+    dispose(st->data);
+    dispose(st->extra);
+    dispose(st->attr_name);
+    dispose(st->attr_value);
+    dispose(st->pool);
+#if USE_MMAP
+  } else if (st->mapped) {
+    munmap(st->image, st->image_size);
+#endif
+  } else {
+    dispose(st->image);
+  }
+  dispose(st->dict);
+  dispose(st);
+}
+
+
+/* store_root -- return the root node of a store */
+EXPORT NodeId store_root(const Store st)
+{
+  return 1;
+}
+
+
+/* store_count -- return the number of nodes in a store, the root included */
+EXPORT NodeId store_count(const Store st)
+{
+  return st->nnodes - 1;
+}
+
+
+/* store_type -- return the type of node n */
+EXPORT Nodetype store_type(const Store st, NodeId n)
+{
+  assert(n > 0 && n < st->nnodes);
+  return st->tp[n] & ~EMPTY;
+}
+
+
+/* store_is_empty -- true if n is an element that has no end tag */
+EXPORT bool store_is_empty(const Store st, NodeId n)
+{
+  assert(n > 0 && n < st->nnodes);
+  return (st->tp[n] & EMPTY) != 0;
+}
+
+
+/* store_parent -- return the parent of node n, or 0 for the root */
+EXPORT NodeId store_parent(const Store st, NodeId n)
+{
+  assert(n > 0 && n < st->nnodes);
+  return st->parent[n];
+}
+
+
+/* store_children -- return the first child of node n, or 0 */
+EXPORT NodeId store_children(const Store st, NodeId n)
+{
+  assert(n > 0 && n < st->nnodes);
+  return n + 1 < st->nnodes && st->parent[n + 1] == n ? n + 1 : 0;
+}
+
+
+/* store_sister -- return the next sister of node n, or 0 */
+EXPORT NodeId store_sister(const Store st, NodeId n)
+{
+  assert(n > 0 && n < st->nnodes);
+  return st->sister[n];
+}
+
+
+/* store_name -- return the name of an element or declaration */
+EXPORT conststring store_name(const Store st, NodeId n)
+{
+  assert(store_type(st, n) == Element || store_type(st, n) == Declaration);
+  return st->pool + st->data[n];
+}
+
+
+/* store_text -- return the text of a node, or a declaration's public id */
+EXPORT conststring store_text(const Store st, NodeId n)
+{
+  uint32_t s;
+
+  assert(store_type(st, n) != Element && store_type(st, n) != Root);
+  s = st->tp[n] == Declaration ? st->attr_name[st->extra[n]] : st->data[n];
+  return s ? st->pool + s : NULL;
+}
+
+
+/* store_url -- return the system identifier of a declaration, or NULL */
+EXPORT conststring store_url(const Store st, NodeId n)
+{
+  uint32_t s;
+
+  assert(store_type(st, n) == Declaration);
+  s = st->attr_value[st->extra[n]];
+  return s ? st->pool + s : NULL;
+}
+
+
+/* store_attribs -- return the first attribute of element n, or 0 */
+EXPORT uint32_t store_attribs(const Store st, NodeId n)
+{
+  assert(store_type(st, n) == Element);
+  return st->extra[n];
+}
+
+
+/* store_attr_next -- return the attribute after a, or 0 */
+EXPORT uint32_t store_attr_next(const Store st, uint32_t a)
+{
+  assert(a > 0 && a < st->nattrs && st->attr_name[a]);
+  return st->attr_name[a + 1] ? a + 1 : 0;
+}
+
+
+/* store_attr_name -- return the name of attribute a */
+EXPORT conststring store_attr_name(const Store st, uint32_t a)
+{
+  assert(a > 0 && a < st->nattrs);
+  return st->pool + st->attr_name[a];
+}
+
+
+/* store_attr_value -- return the value of attribute a, or NULL if none */
+EXPORT conststring store_attr_value(const Store st, uint32_t a)
+{
+  assert(a > 0 && a < st->nattrs);
+  return st->attr_value[a] ? st->pool + st->attr_value[a] : NULL;
+}
+
+
+/* store_attrib -- return the value of a named attribute of n, or NULL */
+EXPORT conststring store_attrib(const Store st, NodeId n,
+				const conststring name)
+{
+  uint32_t a;
+
+  for (a = store_attribs(st, n); a; a = store_attr_next(st, a))
+    if (eq(store_attr_name(st, a), name)) return store_attr_value(st, a);
+  return NULL;
+}
+
+
+/* padding -- return the number of bytes to add to n to make it a multiple of 4 */
+static size_t padding(size_t n)
+{
+  return (4 - n % 4) % 4;
+}
+
+
+/* store_write -- write a snapshot of a store to f, false on error */
+EXPORT bool store_write(const Store st, FILE *f)
+{
+  static const char zeros[4] = {0, 0, 0, 0};
+  size_t n = st->nnodes, m = st->nattrs;
+  Header h;
+
+  memset(&h, 0, sizeof(h));
+  memcpy(h.magic, MAGIC, sizeof(h.magic));
+  h.version = FORMAT_VERSION;
+  h.order = BYTE_ORDER_MARK;
+  h.nnodes = st->nnodes;
+  h.nattrs = st->nattrs;
+  h.pool_len = st->pool_len;
+  return fwrite(&h, sizeof(h), 1, f) == 1
+    && fwrite(st->tp, 1, n, f) == n
+    && fwrite(zeros, 1, padding(n), f) == padding(n)
+    && fwrite(st->parent, sizeof(*st->parent), n, f) == n
+    && fwrite(st->sister, sizeof(*st->sister), n, f) == n
+    && fwrite(st->data, sizeof(*st->data), n, f) == n
+    && fwrite(st->extra, sizeof(*st->extra), n, f) == n
+    && fwrite(st->attr_name, sizeof(*st->attr_name), m, f) == m
+    && fwrite(st->attr_value, sizeof(*st->attr_value), m, f) == m
+    && fwrite(st->pool, 1, st->pool_len, f) == st->pool_len
+    && !ferror(f);
+}
+
+
+/* consistent -- check that the arrays of a snapshot can be trusted */
+static bool consistent(const Store st)
+{
+  NodeId n, k;
+  uint32_t a;
+
+  if (st->nnodes < 2 || st->nattrs < 1 || st->pool_len < 1) return false;
+  if (st->pool[0] || st->pool[st->pool_len - 1]) return false;
+  if (st->tp[1] != Root || st->parent[1] || st->sister[1]) return false;
+  for (a = 1; a < st->nattrs; a++)
+    if (st->attr_name[a] >= st->pool_len || st->attr_value[a] >= st->pool_len)
+      return false;
+  for (n = 2; n < st->nnodes; n++) {
+    /* The parent must be the previous node or one of its ancestors.
+       As in add_node(), each node is passed over only once */
+    for (k = n - 1; k && k != st->parent[n]; k = st->parent[k]) ;
+    if (!k) return false;
+    if (st->tp[k] != Root && st->tp[k] != Element) return false; /* Leaf */
+    if (st->sister[n] && (st->sister[n] <= n || st->sister[n] >= st->nnodes
+			  || st->parent[st->sister[n]] != st->parent[n]))
+      return false;
+    if (st->data[n] >= st->pool_len || st->extra[n] >= st->nattrs)
+      return false;
+    switch (st->tp[n]) {
+    case Element | EMPTY: case Element:	/* List must end in the table */
+      for (a = st->extra[n]; a && st->attr_name[a]; a++)
+	if (a + 1 == st->nattrs) return false;
+      break;
+    case Declaration:
+      if (!st->extra[n]) return false;
+      break;
+    case Text: case Comment: case Procins:
+      break;
+    default:
+      return false;
+    }
+  }
+  return true;
+}
+
+
+/* read_image -- read the rest of f into memory, return it and its size */
+static char *read_image(FILE *f, size_t *size)
+{
+  size_t n = 0, k, alloc = 65536;
+  char *buf;
+
+  newarray(buf, alloc);
+  while ((k = fread(buf + n, 1, alloc - n, f)) > 0)
+    if ((n += k) == alloc) {alloc *= 2; renewarray(buf, alloc);}
+  if (ferror(f)) errexit("Error while reading a snapshot\n");
+  *size = n;
+  return buf;
+}
+
+
+/* store_read -- read a snapshot from f, or return NULL if f holds none */
+EXPORT Store store_read(FILE *f)
+{
+  const Header *h;
+  uint64_t n, m;
+  Store st;
+  int c;
+#if USE_MMAP
+  struct stat s;
+  int fd;
+#endif
+
+  /* No HTML or XML document starts with a DEL character */
+  if ((c = getc(f)) == EOF) return NULL;
+  (void) ungetc(c, f);
+  if (c != MAGIC[0]) return NULL;
+
+  new(st);
+  st->dict = NULL;
+  st->dict_size = st->dict_count = 0;
+  st->mapped = false;
+#if USE_MMAP
+  if ((fd = fileno(f)) >= 0 && fstat(fd, &s) == 0 && S_ISREG(s.st_mode)
+      && ftello(f) == 0 && s.st_size >= (off_t)sizeof(Header)
+      && (st->image = mmap(NULL, s.st_size, PROT_READ, MAP_PRIVATE, fd, 0))
+      != MAP_FAILED) {
+    st->image_size = s.st_size;
+    st->mapped = true;
+  }
+#endif
+  if (!st->mapped) st->image = read_image(f, &st->image_size);
+
+  h = (const Header *)st->image;
+  if (st->image_size < sizeof(*h) || memcmp(h->magic, MAGIC, sizeof(h->magic)))
+    errexit("Input is neither HTML, XML nor a snapshot\n");
+  if (h->order != BYTE_ORDER_MARK)
+    errexit("Snapshot was made on a machine with another byte order\n");
+  if (h->version != FORMAT_VERSION)
+    errexit("Snapshot has version %u, expected %u\n", h->version, FORMAT_VERSION);
+  n = h->nnodes;
+  m = h->nattrs;
+  if (st->image_size != sizeof(*h) + n + padding(n) + 4 * n * sizeof(NodeId)
+      + 2 * m * sizeof(uint32_t) + h->pool_len)
+    errexit("Snapshot is truncated or corrupt\n");
+
+  st->tp = (unsigned char *)st->image + sizeof(*h);
+  st->parent = (NodeId *)(st->tp + n + padding(n));
+  st->sister = st->parent + n;
+  st->data = st->sister + n;
+  st->extra = st->data + n;
+  st->attr_name = st->extra + n;
+  st->attr_value = st->attr_name + m;
+  st->pool = (char *)(st->attr_value + m);
+  st->nnodes = st->nodes_size = n;
+  st->nattrs = st->attrs_size = m;
+  st->pool_len = st->pool_size = h->pool_len;
+  if (!consistent(st)) errexit("Snapshot is corrupt\n");
+  return st;
+}
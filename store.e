@@ -0,0 +1,35 @@
+typedef uint32_t NodeId;
+typedef struct _Store *Store;
+extern Store store_create(void);
+extern NodeId store_add_element(Store st, NodeId parent,
+    const conststring name, const pairlist attribs,
+    
+   _Bool 
+        empty);
+extern NodeId store_add_text(Store st, NodeId parent, Nodetype tp,
+        const conststring text);
+extern NodeId store_add_declaration(Store st, NodeId parent,
+        const conststring name,
+        const conststring fpi,
+        const conststring url);
+extern void store_delete(Store st);
+extern NodeId store_root(const Store st);
+extern NodeId store_count(const Store st);
+extern Nodetype store_type(const Store st, NodeId n);
+extern _Bool 
+           store_is_empty(const Store st, NodeId n);
+extern NodeId store_parent(const Store st, NodeId n);
+extern NodeId store_children(const Store st, NodeId n);
+extern NodeId store_sister(const Store st, NodeId n);
+extern conststring store_name(const Store st, NodeId n);
+extern conststring store_text(const Store st, NodeId n);
+extern conststring store_url(const Store st, NodeId n);
+extern uint32_t store_attribs(const Store st, NodeId n);
+extern uint32_t store_attr_next(const Store st, uint32_t a);
+extern conststring store_attr_name(const Store st, uint32_t a);
+extern conststring store_attr_value(const Store st, uint32_t a);
+extern conststring store_attrib(const Store st, NodeId n,
+    const conststring name);
+extern _Bool 
+           store_write(const Store st, FILE *f);
+extern Store store_read(FILE *f);
@@ -0,0 +1,42 @@
+:
+# Batch mode: two documents in one run must come out the same as when
+# each is treated by a separate run.
+
+trap 'rm -r $TMP' 0
+TMP=`mktemp -d /tmp/batchXXXXXXXX` || exit 1
+
+cat >$TMP/in1 <<-EOF
+	<!DOCTYPE html>
+	<title>One</title>
+	<h1>Intro</h1>
+	<h2>Sub</h2>
+	<p>Text
+EOF
+cat >$TMP/in2 <<-EOF
+	<!DOCTYPE html>
+	<title>Two</title>
+	<h1>Other</h1>
+EOF
+
+# Input and output files on the command line
+./hxnum -B $TMP/in1 $TMP/out1 $TMP/in2 $TMP/out2 || exit 1
+./hxnum $TMP/in1 >$TMP/exp1 || exit 1
+./hxnum $TMP/in2 >$TMP/exp2 || exit 1
+diff -u $TMP/exp1 $TMP/out1 || exit 1
+diff -u $TMP/exp2 $TMP/out2 || exit 1
+
+# Input and output files as a NUL-separated list on stdin
+printf '%s\0%s\0%s\0%s\0' $TMP/in1 $TMP/out1 $TMP/in2 $TMP/out2 |
+  ./hxnormalize -B -x || exit 1
+./hxnormalize -x $TMP/in1 >$TMP/exp1 || exit 1
+./hxnormalize -x $TMP/in2 >$TMP/exp2 || exit 1
+diff -u $TMP/exp1 $TMP/out1 || exit 1
+diff -u $TMP/exp2 $TMP/out2 || exit 1
+
+# The selector comes first, the files after it
+./hxnormalize -x $TMP/in1 >$TMP/in1.xml || exit 1
+./hxnormalize -x $TMP/in2 >$TMP/in2.xml || exit 1
+./hxselect -B -s '\n' h1 $TMP/in1.xml $TMP/out1 $TMP/in2.xml $TMP/out2 ||
+  exit 1
+printf '<h1>Intro</h1>\n' | diff -u - $TMP/out1 || exit 1
+printf '<h1>Other</h1>\n' | diff -u - $TMP/out2
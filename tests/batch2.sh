@@ -0,0 +1,19 @@
+:
+# Batch mode with several jobs: every document must be written to its
+# own output file, the same as when it is treated alone.
+
+trap 'rm -r $TMP' 0
+TMP=`mktemp -d /tmp/batchXXXXXXXX` || exit 1
+
+for i in 1 2 3 4 5 6 7; do
+  printf '<!DOCTYPE html>\n<title>Doc %s</title>\n' $i >$TMP/in$i
+  for j in `seq $i`; do printf '<h1>Part %s</h1>\n<h2>Sub</h2>\n' $j; done \
+    >>$TMP/in$i
+  set -- "$@" $TMP/in$i $TMP/out$i
+done
+
+./hxnum -B -j 3 "$@" || exit 1
+
+for i in 1 2 3 4 5 6 7; do
+  ./hxnum $TMP/in$i | diff -u - $TMP/out$i || exit 1
+done
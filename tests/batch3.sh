@@ -0,0 +1,22 @@
+:
+# Batch mode: a document with a mismatched end tag fails on its own,
+# the documents after it are still treated and the exit status is 1.
+# An output file that cannot be created doesn't close stdout either.
+
+trap 'rm -r $TMP' 0
+TMP=`mktemp -d /tmp/batchXXXXXXXX` || exit 1
+
+printf '<a><b>1</b></a>\n' >$TMP/g1
+printf '<a><b>2</c></a>\n' >$TMP/bad
+printf '<a><b>3</b></a>\n' >$TMP/g2
+
+./hxselect -B b $TMP/g1 $TMP/o1 $TMP/bad $TMP/o2 $TMP/g2 $TMP/o3 \
+  2>$TMP/err
+test $? = 1 || exit 1
+grep -q 'doesn.t match' $TMP/err || exit 1
+test "`cat $TMP/o1`" = '<b>1</b>' || exit 1
+test "`cat $TMP/o3`" = '<b>3</b>' || exit 1
+
+./hxselect -B b $TMP/g1 $TMP/nodir/o1 $TMP/g2 $TMP/o4 2>/dev/null
+test $? = 2 || exit 1
+test "`cat $TMP/o4`" = '<b>3</b>' || exit 1
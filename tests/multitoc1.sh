@@ -0,0 +1,26 @@
+:
+# Only the text in headings ends up in the table of contents
+
+trap 'rm $TMP1 $TMP2 $TMP3' 0
+TMP1=`mktemp /tmp/tmp.XXXXXXXXXX` || exit 1
+TMP2=`mktemp /tmp/tmp.XXXXXXXXXX` || exit 1
+TMP3=`mktemp /tmp/tmp.XXXXXXXXXX` || exit 1
+
+cat >$TMP1 <<-EOF
+	<p>Intro <!-- note --> text<?pi x?></p>
+	<h1 id="a">First <em class="x">head</em></h1>
+	<p>Body &amp; more</p>
+	<h2 id="b" class="no-toc">Skipped</h2>
+	<h2 id="c">Second<a href="#z">!</a> &amp; last</h2>
+	<p>The end</p>
+EOF
+cat >$TMP2 <<-EOF
+	<ul class="toc">
+	<li><a href="doc.html#a">First <em class="x">head</em></a>
+	<ul class="toc">
+	<li><a href="doc.html#c">Second! &amp; last</a>
+	</ul>
+	</ul>
+EOF
+./hxmultitoc -b doc.html $TMP1 >$TMP3 || exit 1
+cmp -s $TMP2 $TMP3
@@ -0,0 +1,24 @@
+:
+trap 'rm $TMP1 $TMP2 $TMP3' 0
+TMP1=`mktemp /tmp/tmp.XXXXXXXXXX` || exit 1
+TMP2=`mktemp /tmp/tmp.XXXXXXXXXX` || exit 1
+TMP3=`mktemp /tmp/tmp.XXXXXXXXXX` || exit 1
+
+# Output that is larger than the output buffer, with a text that is
+# written without copying it
+
+awk 'BEGIN {
+  for (i = 0; i < 5000; i++) printf "<b>x</b>";
+  printf "<p>";
+  for (i = 0; i < 20000; i++) printf "word ";
+  printf "</p>"}' >$TMP1
+
+./hxpipe <$TMP1 >$TMP2
+
+awk 'BEGIN {
+  for (i = 0; i < 5000; i++) print "(b\n-x\n)b";
+  print "(p"; printf "-";
+  for (i = 0; i < 20000; i++) printf "word ";
+  print "\n)p"}' >$TMP3
+
+cmp -s $TMP2 $TMP3
@@ -0,0 +1,63 @@
+:
+# Long runs of text, attribute values, comments and CDATA, which the
+# scanner finds without its DFA, must give the same tokens as before,
+# both from a file and from a stream, where they cross buffers.
+
+trap 'rm $TMP1 $TMP2 $TMP3' 0
+TMP1=`mktemp /tmp/tmp.XXXXXXXXXX` || exit 1
+TMP2=`mktemp /tmp/tmp.XXXXXXXXXX` || exit 1
+TMP3=`mktemp /tmp/tmp.XXXXXXXXXX` || exit 1
+
+cat >$TMP1 <<-EOF
+	<p title="one
+	two" id='three'>Text <!-- a --> and <!-- b ---> c --> d<!---->
+EOF
+./hxpipe -l $TMP1 >$TMP2 || exit 1
+cat >$TMP3 <<-EOF
+	Atitle CDATA one two
+	Aid CDATA three
+	L2
+	(p
+	L2
+	-Text 
+	L2
+	* a 
+	L2
+	- and 
+	L2
+	* b ---> c 
+	L2
+	- d
+	L2
+	*
+	L3
+	-\n
+EOF
+diff -u $TMP3 $TMP2 || exit 1
+
+cat >$TMP1 <<-EOF
+	<title>t</title>
+	<script>if (a<b && c</S) x="<</p>"; </script>
+	<style>p {}</style>
+EOF
+./hxnormalize -i 0 -l 200 $TMP1 >$TMP2 || exit 1
+cat >$TMP3 <<-EOF
+
+	<html>
+	<head>
+	<title>t</title>
+
+	<script>if (a<b && c</S) x="<</p>"; </script>
+	<style>p {}</style>
+EOF
+diff -u $TMP3 $TMP2 || exit 1
+
+# A document with runs longer than the scanner's buffer
+awk 'BEGIN {
+  for (i = 0; i < 3000; i++) s = s "word" i " ";
+  printf "<p title=\"%s\">%s<!--%s--><script>%s</script>\n", s, s, s, s
+}' >$TMP1
+./hxnormalize -x $TMP1 >$TMP2 || exit 1
+./hxnormalize -x <$TMP1 >$TMP3 || exit 1
+cmp -s $TMP2 $TMP3 || exit 1
+test `wc -c <$TMP2` -gt 100000
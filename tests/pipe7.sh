@@ -0,0 +1,38 @@
+:
+# Line numbers with LF, CR and CR LF, in a file and in a stream
+# that is read in several blocks.
+
+trap 'rm $TMP1 $TMP2 $TMP3' 0
+TMP1=`mktemp /tmp/tmp.XXXXXXXXXX` || exit 1
+TMP2=`mktemp /tmp/tmp.XXXXXXXXXX` || exit 1
+TMP3=`mktemp /tmp/tmp.XXXXXXXXXX` || exit 1
+
+printf 'a\r\nb\rc\n<p\r\ntitle="1\r\n2">\r<!--\n\n-->x</p>\n' >$TMP1
+./hxpipe -l $TMP1 >$TMP2 || exit 1
+cat >$TMP3 <<-EOF
+	L1
+	-a\r\nb\rc\n
+	Atitle CDATA 1 2
+	L6
+	(p
+	L7
+	-\r
+	L9
+	*\n\n
+	L9
+	-x
+	L9
+	)p
+	L10
+	-\n
+EOF
+diff -u $TMP3 $TMP2 || exit 1
+
+awk 'BEGIN {
+  for (i = 1; i <= 20000; i++) printf "<p title=\"%d\n%d\">line %d<!--\n-->\n", i, i, i
+  printf "<x>\n"
+}' >$TMP1
+./hxpipe -l $TMP1 >$TMP2 || exit 1
+./hxpipe -l <$TMP1 >$TMP3 || exit 1
+cmp -s $TMP2 $TMP3 || exit 1
+test "`grep '^L' $TMP2 | tail -1`" = L60002
@@ -0,0 +1,30 @@
+:
+# A pipe is parsed in pieces as they arrive, with the same result as a
+# file, even if a piece ends in the middle of a token.
+
+trap 'rm $TMP1 $TMP2 $TMP3 $TMP4' 0
+TMP1=`mktemp /tmp/tmp.XXXXXXXXXX` || exit 1
+TMP2=`mktemp /tmp/tmp.XXXXXXXXXX` || exit 1
+TMP3=`mktemp /tmp/tmp.XXXXXXXXXX` || exit 1
+TMP4=`mktemp /tmp/tmp.XXXXXXXXXX` || exit 1
+
+A='<!DOCTYPE html PUBLIC "-//W3C//DTD HTML 4.01//EN">\r'
+B='\n<p class="a b">text<!-- a -'
+C='- b -->more <img src="x.png" alt="y'
+D='">\r\n<?pi x?></p>\n'
+
+printf '%b' "$A$B$C$D" >$TMP1
+./hxpipe -l $TMP1 >$TMP2 || exit 1
+(printf '%b' "$A"; sleep 1; printf '%b' "$B"; sleep 1;
+ printf '%b' "$C"; sleep 1; printf '%b' "$D") | ./hxpipe -l >$TMP3 || exit 1
+cmp -s $TMP2 $TMP3 || exit 1
+
+# An empty pipe is an empty document
+printf '' | ./hxpipe >$TMP3 || exit 1
+test ! -s $TMP3 || exit 1
+
+# A snapshot is still recognized when it comes from a pipe
+./hxnormalize -x -S $TMP1 >$TMP4 || exit 1
+./hxpipe $TMP4 >$TMP2 || exit 1
+cat $TMP4 | ./hxpipe >$TMP3 || exit 1
+cmp -s $TMP2 $TMP3
@@ -0,0 +1,37 @@
+:
+# Texts, comments and CDATA sections that are longer than hxpipe's
+# chunk size come in parts, but the output is the same.
+
+trap 'rm $TMP1 $TMP2 $TMP3' 0
+TMP1=`mktemp /tmp/tmp.XXXXXXXXXX` || exit 1
+TMP2=`mktemp /tmp/tmp.XXXXXXXXXX` || exit 1
+TMP3=`mktemp /tmp/tmp.XXXXXXXXXX` || exit 1
+
+awk 'BEGIN {
+  printf "<p>"; for (i = 0; i < 20000; i++) printf "ab é&#233; "
+  printf "<!--"; for (i = 0; i < 20000; i++) printf "a-b-é&#233; "
+  printf "--><![CDATA["; for (i = 0; i < 20000; i++) printf "a]b]é "
+  printf "]]></p>\n"}' >$TMP1
+
+awk 'BEGIN {
+  printf "(p\n-"; for (i = 0; i < 20000; i++) printf "ab é\\#233; "
+  printf "\n*"; for (i = 0; i < 20000; i++) printf "a-b-é\\#233; "
+  printf "\n-<![CDATA["; for (i = 0; i < 20000; i++) printf "a]b]é "
+  printf "]]>\n)p\n-\\n\n"}' >$TMP2
+
+./hxpipe $TMP1 >$TMP3 || exit 1
+cmp -s $TMP2 $TMP3 || exit 1
+cat $TMP1 | ./hxpipe >$TMP3 || exit 1
+cmp -s $TMP2 $TMP3 || exit 1
+
+# A long comment passes through hxincl unchanged
+./hxincl $TMP1 >$TMP3 || exit 1
+cmp -s $TMP1 $TMP3 || exit 1
+
+# A long comment or CDATA section that is not closed is text
+for s in '<!--' '<![CDATA['; do
+  awk -v s="$s" 'BEGIN {
+    printf "<p>%s", s; for (i = 0; i < 20000; i++) printf "a-b]é "}' >$TMP1
+  ./hxincl $TMP1 >$TMP3 || exit 1
+  sed 's/^<p></<p>\&lt;/' $TMP1 | cmp -s - $TMP3 || exit 1
+done
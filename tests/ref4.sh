@@ -0,0 +1,27 @@
+:
+trap 'rm $TMP1 $TMP2 $TMP3' 0
+TMP1=`mktemp /tmp/tmp.XXXXXXXXXX` || exit 1
+TMP2=`mktemp /tmp/tmp.XXXXXXXXXX` || exit 1
+TMP3=`mktemp /tmp/tmp.XXXXXXXXXX` || exit 1
+
+# Terms that are sisters of each other, inside an <a>, and in an
+# element that gets wrapped in an <a>
+
+cat >$TMP1 <<-EOF
+	<p>A <dfn>widget</dfn> and a <dfn>thing</dfn>.
+	<p>Use a <span>widget</span>, <em>widget</em>, <a>widget</a>,
+	<em>thing</em><em>thing</em> and <b>things</b>.
+	EOF
+
+# The echo adds a newline at the end of the file
+#
+(./hxref $TMP1; echo) >$TMP2
+
+cat >$TMP3 <<-EOF
+	<html><body><p>A <dfn id="widget">widget</dfn> and a <dfn id="thing">thing</dfn>.
+	</p><p>Use a <a href="#widget">widget</a>, <a href="#widget"><em>widget</em></a>, <a>widget</a>,
+	<a href="#thing"><em>thing</em></a><a href="#thing"><em>thing</em></a> and <b>things</b>.
+	</p></body></html>
+	EOF
+
+cmp -s $TMP2 $TMP3
@@ -0,0 +1,22 @@
+:
+
+trap 'rm $TMP1 $TMP2' 0
+TMP1=`mktemp /tmp/addidXXXXXXXX` || exit 1
+TMP2=`mktemp /tmp/addidXXXXXXXX` || exit 1
+
+./hxselect -s '\n' 'div > :nth-last-child(2), div > em:last-of-type, div > b:last-child' >$TMP1 <<-EOF
+	<div>
+	<em>One</em>
+	<b>Two</b>
+	<!-- Comments don't count -->
+	<em>Three</em>
+	text
+	<b>Four</b>
+	</div>
+EOF
+cat >$TMP2 <<-EOF
+	<em>Three</em>
+	<b>Four</b>
+EOF
+
+diff -u $TMP1 $TMP2
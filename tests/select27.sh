@@ -0,0 +1,24 @@
+:
+# Matches are printed when they end, but still in document order, also
+# when one match is inside another.
+
+trap 'rm $TMP1 $TMP2' 0
+TMP1=`mktemp /tmp/addidXXXXXXXX` || exit 1
+TMP2=`mktemp /tmp/addidXXXXXXXX` || exit 1
+
+./hxselect -s '\n' 'div, b + i' >$TMP1 <<-EOF
+	<doc>
+	<div id="a"><b>1</b><i>2</i><div id="b">3</div></div>
+	<b>4</b> <i>5</i>
+	<div id="c"/>
+	</doc>
+EOF
+cat >$TMP2 <<-EOF
+	<div id="a"><b>1</b><i>2</i><div id="b">3</div></div>
+	<i>2</i>
+	<div id="b">3</div>
+	<i>5</i>
+	<div id="c"></div>
+EOF
+
+diff -u $TMP1 $TMP2
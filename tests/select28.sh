@@ -0,0 +1,24 @@
+:
+# "~" with text between the sisters, and a later selector in a list
+# that matches when an earlier one only fails on its context.
+
+trap 'rm $TMP1 $TMP2' 0
+TMP1=`mktemp /tmp/addidXXXXXXXX` || exit 1
+TMP2=`mktemp /tmp/addidXXXXXXXX` || exit 1
+
+./hxselect -s '\n' 'p ~ div, section em, em.x' >$TMP1 <<-EOF
+	<doc>
+	<div>1</div>
+	<p>2</p> text
+	<div>3 <em class="x">4</em></div>
+	<section><div>5</div></section>
+	<div>6</div>
+	</doc>
+EOF
+cat >$TMP2 <<-EOF
+	<div>3 <em class="x">4</em></div>
+	<em class="x">4</em>
+	<div>6</div>
+EOF
+
+diff -u $TMP1 $TMP2
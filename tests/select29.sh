@@ -0,0 +1,38 @@
+:
+# Many selectors from a file, matched in one pass and labeled.
+
+trap 'rm $TMP1 $TMP2 $TMP3' 0
+TMP1=`mktemp /tmp/addidXXXXXXXX` || exit 1
+TMP2=`mktemp /tmp/addidXXXXXXXX` || exit 1
+TMP3=`mktemp /tmp/addidXXXXXXXX` || exit 1
+
+cat >$TMP3 <<-EOF
+	/* Rules with and without labels */
+	emph	em.x
+	div > p
+
+	#main, a, b
+	links	a::attr(href)
+	p:first-child
+EOF
+
+./hxselect -s '\n' -f $TMP3 >$TMP1 <<-EOF
+	<doc>
+	<div id="main"><p>1 <em class="x">2</em></p>
+	<p>3 <a href="u">4</a></p></div>
+	<b>5</b>
+	</doc>
+EOF
+cat >$TMP2 <<-EOF
+	5	<div id="main"><p>1 <em class="x">2</em></p>
+	<p>3 <a href="u">4</a></p></div>
+	3	<p>1 <em class="x">2</em></p>
+	7	<p>1 <em class="x">2</em></p>
+	emph	<em class="x">2</em>
+	3	<p>3 <a href="u">4</a></p>
+	5	<a href="u">4</a>
+	links	href="u"
+	5	<b>5</b>
+EOF
+
+diff -u $TMP1 $TMP2
@@ -0,0 +1,22 @@
+:
+# An attribute inside a match that is not yet printed waits for it, so
+# the order is the same with and without streaming (":empty" needs to
+# look ahead, which turns streaming off).
+
+trap 'rm $TMP1 $TMP2 $TMP3' 0
+TMP1=`mktemp /tmp/addidXXXXXXXX` || exit 1
+TMP2=`mktemp /tmp/addidXXXXXXXX` || exit 1
+TMP3=`mktemp /tmp/addidXXXXXXXX` || exit 1
+
+cat >$TMP3 <<-EOF
+	<div><p id=x><a href="u1">t</a></p><a href="u2">s</a></div>
+EOF
+cat >$TMP2 <<-EOF
+	<p id="x"><a href="u1">t</a></p>
+	href="u1"
+	href="u2"
+EOF
+./hxselect -s '\n' 'p, a::attr(href)' <$TMP3 >$TMP1 || exit 1
+diff -u $TMP2 $TMP1 || exit 1
+./hxselect -s '\n' 'p, a::attr(href), zz:empty' <$TMP3 >$TMP1 || exit 1
+diff -u $TMP2 $TMP1
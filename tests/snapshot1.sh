@@ -0,0 +1,31 @@
+:
+trap 'rm $TMP1 $TMP2 $TMP3 $TMP4' 0
+TMP1=`mktemp /tmp/tmp.XXXXXXXXXX` || exit 1
+TMP2=`mktemp /tmp/tmp.XXXXXXXXXX` || exit 1
+TMP3=`mktemp /tmp/tmp.XXXXXXXXXX` || exit 1
+TMP4=`mktemp /tmp/tmp.XXXXXXXXXX` || exit 1
+
+# A snapshot gives the same result as the text it was made from, both
+# when read from a file and when read from a pipe
+
+cat >$TMP1 <<-EOF
+	<!DOCTYPE html PUBLIC "-//W3C//DTD HTML 4.01//EN"
+	  "http://www.w3.org/TR/html4/strict.dtd">
+	<title>Test</title>
+	<!-- comment --><?pi x?>
+	<h1 id=top>One &amp; two</h1>
+	<p class="a b" title=x>Text<br>more <img src="a.png" alt="">
+	<h2>Three</h2>
+	<ul><li>a<li>b</ul>
+	EOF
+
+./hxnormalize -S $TMP1 >$TMP2 || exit 1
+./hxnormalize <$TMP1 >$TMP3
+./hxnormalize <$TMP2 >$TMP4
+cmp -s $TMP3 $TMP4 || exit 1
+./hxtoc <$TMP1 >$TMP3
+cat $TMP2 | ./hxtoc >$TMP4
+cmp -s $TMP3 $TMP4 || exit 1
+./hxnormalize -x <$TMP1 >$TMP3
+./hxclean -S <$TMP1 | ./hxnormalize -x >$TMP4
+cmp -s $TMP3 $TMP4
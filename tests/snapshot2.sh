@@ -0,0 +1,20 @@
+:
+trap 'rm $TMP1 $TMP2' 0
+TMP1=`mktemp /tmp/tmp.XXXXXXXXXX` || exit 1
+TMP2=`mktemp /tmp/tmp.XXXXXXXXXX` || exit 1
+
+# A snapshot in which a node has an empty element or a text as its
+# parent is rejected as corrupt. The type of node 2 (the div) is at
+# offset 32 + 2.
+
+printf '<div><p>x</p></div>\n' | ./hxnormalize -x -S >$TMP1 || exit 1
+
+for t in '\200' '\001' '\002'; do
+  cp $TMP1 $TMP2
+  printf "$t" | dd of=$TMP2 bs=1 seek=34 conv=notrunc 2>/dev/null || exit 1
+  ./hxnormalize -x <$TMP2 >/dev/null 2>&1
+  test $? -eq 1 || exit 1
+  ./hxpipe <$TMP2 >/dev/null 2>&1
+  test $? -eq 1 || exit 1
+done
+exit 0
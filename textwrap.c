@@ -1,6 +1,10 @@
 /*
  * Routines to wrap lines and indent them.
  *
+ * All state is in a Textwrap, which writes its lines to an Outbuf.
+ * Independent formatters can thus be used side by side, e.g., one per
+ * document, or one per subtree, each writing into its own buffer.
+ *
  * Copyright © 1998-2016 World Wide Web Consortium
  * See http://www.w3.org/Consortium/Legal/copyright-software
  *
@@ -28,77 +32,157 @@
 #include "types.e"
 #include "errexit.e"
 #include "heap.e"
+#include "outbuf.e"
 
 /* To do: XML 1.1 allows &#1;, so the following isn't safe anymore */
 #define NBSP 1					/* Marks non-break-space */
 #define BREAKOP 2		/* '\002' marks a line break opportunity */
 
-static unsigned char *buf = NULL;
-static int buflen = 0;				/* Size of buf */
-static int len = 0;				/* Length of buf */
-static int bufchars = 0;			/* Ditto in chars, not bytes */
-static int linelen = 0;				/* Length of printed line */
-static int level = 0;				/* Indentation level */
-static int indent = 2;				/* # of spaces per indent */
-static int maxlinelen = 72;			/* Desired line length */
-static unsigned char prev = NBSP;      		/* Previously added char */
+EXPORT typedef struct _Textwrap *Textwrap;
+
+struct _Textwrap {
+  Outbuf o;					/* Where lines are written */
+  unsigned char *buf;				/* Text not yet printed */
+  int buflen;					/* Size of buf */
+  int len;					/* Length of buf */
+  int bufchars;					/* Ditto in chars, not bytes */
+  int linelen;					/* Length of printed line */
+  int level;					/* Indentation level */
+  int indent;					/* # of spaces per indent */
+  int maxlinelen;				/* Desired line length */
+  unsigned char prev;				/* Previously added char */
+};
+
+
+/* textwrap_new -- create a formatter that writes its lines to o */
+EXPORT Textwrap textwrap_new(Outbuf o)
+{
+  Arena prev = arena_use(NULL);			/* May outlive a document */
+  Textwrap w;
+
+  new(w);
+  w->o = o;
+  w->buf = NULL;
+  w->buflen = w->len = w->bufchars = w->linelen = w->level = 0;
+  w->indent = 2;
+  w->maxlinelen = 72;
+  w->prev = NBSP;
+  (void) arena_use(prev);
+  return w;
+}
+
+/* textwrap_delete -- free a formatter, without printing unprinted text */
+EXPORT void textwrap_delete(Textwrap w)
+{
+  Arena prev = arena_use(NULL);
+
+  dispose(w->buf);
+  dispose(w);
+  (void) arena_use(prev);
+}
 
 /* set_indent -- set the amount of indent per level */
-EXPORT void set_indent(int n) {indent = n;}
+EXPORT void set_indent(Textwrap w, int n) {w->indent = n;}
 
 /* set_linelen -- set the maximum length of a line */
-EXPORT void set_linelen(int n) {maxlinelen = n;}
+EXPORT void set_linelen(Textwrap w, int n) {w->maxlinelen = n;}
+
+/* reset_textwrap -- forget any unprinted text, start a new output */
+EXPORT void reset_textwrap(Textwrap w)
+{
+  w->len = w->bufchars = w->linelen = w->level = 0; /* Keep buf for reuse */
+  w->prev = NBSP;
+}
+
+/* room -- make sure buf has space for n more bytes */
+static void room(Textwrap w, int n)
+{
+  Arena prev;				/* buf outlives documents, see above */
+
+  if (w->len + n < w->buflen) return;
+  if (w->buflen == 0) w->buflen = 1024;
+  while (w->len + n >= w->buflen) w->buflen *= 2;
+  prev = arena_use(NULL);
+  renewarray(w->buf, w->buflen);
+  (void) arena_use(prev);
+}
+
+/* put -- print buf[from..to-1], removing break and non-break-space markers */
+static void put(Textwrap w, int from, int to)
+{
+  unsigned char *buf = w->buf;
+  int i, j;
+
+  for (i = from; i < to; i = j + 1) {
+    for (j = i; j < to && buf[j] != BREAKOP && buf[j] != NBSP; j++) ;
+    outbuf_write(w->o, (char*)buf + i, j - i);
+    if (j < to && buf[j] == NBSP) outbuf_putc(w->o, ' ');
+  }
+}
 
 /* flush -- print word in buf */
-EXPORT void flush()
+EXPORT void flush(Textwrap w)
 {
-  int i, j, k;
+  int i, j, k, n, start = 0;
 
-  assert(len <= buflen);
-  while (len != 0 && linelen + bufchars >= maxlinelen) { /* Need break */
-    /* Find last breakpoint i before maxlinelen, or first after it */
-    for (i = -1, j = 0, k = 0; j < len && (k < maxlinelen || i == -1); j++)
-      if (buf[j] == ' ') {i = j; k++;}
-      else if (buf[j] == BREAKOP) i = j; /* Breakpoint but no character */
-      else if ((buf[j] & 0xC0) != 0x80) k++; /* Start of a UTF-8 sequence */
+  /* The text still to print is buf[start..len-1]. Instead of moving
+   * it to the front after every line break, only start moves. */
+  assert(w->len <= w->buflen);
+  while (w->len != start && w->linelen + w->bufchars >= w->maxlinelen) {
+    /* Need break. Find last breakpoint i before maxlinelen, or first after */
+    for (i = -1, j = start, k = 0;
+	 j < w->len && (k < w->maxlinelen || i == -1); j++)
+      if (w->buf[j] == ' ') {i = j; k++;}
+      else if (w->buf[j] == BREAKOP) i = j; /* Breakpoint but no character */
+      else if ((w->buf[j] & 0xC0) != 0x80) k++; /* Start of a UTF-8 sequence */
     if (i < 0) break;				/* No breakpoint */
-    assert(i >= 0);				/* Found a breakpoint at i */
-    assert(buf[i] == ' ' || buf[i] == BREAKOP);
+    assert(i >= start);				/* Found a breakpoint at i */
+    assert(w->buf[i] == ' ' || w->buf[i] == BREAKOP);
     /* Print up to breakpoint (removing non-break-space markers) */
-    for (j = 0; j < i; j++)
-      if (buf[j] != BREAKOP) {
-	putchar(buf[j] == NBSP ? ' ' : buf[j]);
-	if ((buf[j] & 0xC0) != 0x80) bufchars--;
+    for (j = start; j < i; j++)
+      if (w->buf[j] != BREAKOP && (w->buf[j] & 0xC0) != 0x80) w->bufchars--;
+    put(w, start, i);
+    outbuf_putc(w->o, '\n');			/* Break line */
+    w->linelen = 0;
+    assert(w->level >= 0);
+    start = i + 1;				/* Skip the breakpoint */
+    if (start != w->len) {	/* If anything left, insert the indent */
+      n = w->level * w->indent;
+      if (start < n) {				/* No room before it */
+	room(w, n - start);
+	memmove(w->buf + n, w->buf + start, w->len - start);
+	w->len += n - start;
+	start = n;
       }
-    putchar('\n');				/* Break line */
-    linelen = 0;
-    assert(level >= 0);
-    assert(len >= 0);
-    assert(i <= len);
-    i++;					/* Skip the breakpoint */
-    len -= i;
-    if (len != 0) {		/* If anything left, insert the indent */
-      memmove(buf + level * indent, buf + i, len);
-      for (j = 0; j < level * indent; j++) buf[j] = NBSP; /* Indent */
-      len += level * indent;
-      bufchars += level * indent;
+      start -= n;
+      for (j = start; j < start + n; j++) w->buf[j] = NBSP; /* Indent */
+      w->bufchars += n;
     }
   }
   /* Print rest, if any (removing non-break-space markers) */
   /* First remove spaces at end of line */
-  while (len > 0 && buf[len-1] == ' ') {len--; bufchars--;}
-  for (j = 0; j < len; j++)
-    if (buf[j] == BREAKOP) /* skip */;
-    else if (buf[j] == '\n' || buf[j] == '\r') {putchar(buf[j]); linelen = 0;}
-    else if (buf[j] == NBSP) {putchar(' '); linelen++;}
-    else if ((buf[j] & 0xC0) != 0x80) {putchar(buf[j]); linelen++;}
-    else putchar(buf[j]);
-  bufchars = 0;
-  len = 0;
+  while (w->len > start && w->buf[w->len-1] == ' ') {w->len--; w->bufchars--;}
+  for (j = start; j < w->len; j++)
+    if (w->buf[j] == BREAKOP) /* skip */;
+    else if (w->buf[j] == '\n' || w->buf[j] == '\r') w->linelen = 0;
+    else if ((w->buf[j] & 0xC0) != 0x80) w->linelen++;
+  put(w, start, w->len);
+  w->bufchars = 0;
+  w->len = 0;
+}
+
+/* bol_indent -- if at the start of a line, insert the indent */
+static void bol_indent(Textwrap w)
+{
+  if (w->linelen + w->len == 0)
+    while (w->len < w->level * w->indent) {
+      w->buf[w->len++] = NBSP;
+      w->bufchars++;
+    }
 }
 
 /* outc -- add one character to output buffer */
-EXPORT void outc(char c, bool preformatted, bool with_space)
+EXPORT void outc(Textwrap w, char c, bool preformatted, bool with_space)
 {
   if (c == '\n' || c == '\r' || c == '\f') {
     if (preformatted) ;		  /* Keep unchanged */
@@ -110,75 +194,105 @@ EXPORT void outc(char c, bool preformatted, bool with_space)
   }
   if (c == ' ') {
     if (preformatted) c = NBSP;	  /* Non-break-space marker */
-    else if (prev == ' ') return; /* Don't add another space */
-    else if (prev == BREAKOP) return; /* Don't add a space after \n or similar */
+    else if (w->prev == ' ') return; /* Don't add another space */
+    else if (w->prev == BREAKOP) return; /* No space after \n or similar */
   }
-  if ((c == ' ' || c == BREAKOP) && linelen + bufchars >= maxlinelen) flush();
-  if (c == '\n' || c == '\r' || c == '\f') flush(); /* Empty the buf */
-  if (c == ' ' && linelen + len == 0) return;	/* No insert at BOL */
-  while (level * indent >= buflen) {buflen += 1024; renewarray(buf, buflen);}
-  if (linelen + len == 0 && !preformatted)
-    while (len < level * indent) {buf[len++] = NBSP; bufchars++;}
-  if (c == ' ' && len && buf[len-1] == ' ') return; /* Skip multiple spaces */
-  while (len >= buflen) {buflen += 1024; renewarray(buf, buflen);}
-    if ((c & 0xC0) != 0x80) bufchars++; /* Character */
-  buf[len++] = c;				/* Finally, insert c */
-  prev = c;					/* Remember for next round */
+  if ((c == ' ' || c == BREAKOP) && w->linelen + w->bufchars >= w->maxlinelen)
+    flush(w);
+  if (c == '\n' || c == '\r' || c == '\f') flush(w); /* Empty the buf */
+  if (c == ' ' && w->linelen + w->len == 0) return; /* No insert at BOL */
+  room(w, w->level * w->indent + 1);
+  if (!preformatted) bol_indent(w);
+  if (c == ' ' && w->len && w->buf[w->len-1] == ' ') return; /* Skip spaces */
+  if ((c & 0xC0) != 0x80) w->bufchars++;	/* Character */
+  w->buf[w->len++] = c;				/* Finally, insert c */
+  w->prev = c;					/* Remember for next round */
 }
 
-/* out -- add text to current output line, print line if getting too long */
-EXPORT void out(string s, bool preformatted, bool with_space)
+/* plain -- length of the prefix of s[0..n-1] that outc() only copies */
+static size_t plain(const char *s, size_t n, bool preformatted)
 {
-  if (s) for (; *s; s++) outc(*s, preformatted, with_space);
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    switch (s[i]) {
+      case ' ': case '\t': if (!preformatted) return i; break;
+      case '\n': case '\r': case '\f': case BREAKOP: return i;
+    }
+  return n;
 }
 
 /* outn -- add n chars to current output, print line if getting too long */
-EXPORT void outn(string s, size_t n, bool preformatted, bool with_space)
+EXPORT void outn(Textwrap w, string s, size_t n, bool preformatted,
+		 bool with_space)
 {
-  size_t i;
-  for (i = 0; i < n; i++) outc(s[i], preformatted, with_space);
+  size_t i, m;
+
+  /* Runs of ordinary characters are copied as a whole, with the same
+   * effect as calling outc() for each. Other characters use outc(). */
+  while (n != 0) {
+    if ((m = plain(s, n, preformatted)) == 0) {
+      outc(w, *s, preformatted, with_space);
+      s++; n--;
+      continue;
+    }
+    room(w, w->level * w->indent + m);
+    if (!preformatted) bol_indent(w);
+    for (i = 0; i < m; i++) {
+      if ((s[i] & 0xC0) != 0x80) w->bufchars++;
+      w->buf[w->len++] = s[i] == ' ' ? NBSP : s[i]; /* Only if preformatted */
+    }
+    w->prev = w->buf[w->len-1];
+    s += m; n -= m;
+  }
+}
+
+/* out -- add text to current output line, print line if getting too long */
+EXPORT void out(Textwrap w, string s, bool preformatted, bool with_space)
+{
+  if (s) outn(w, s, strlen(s), preformatted, with_space);
 }
 
 /* outln -- add string to output buffer, followed by '\n' */
-EXPORT void outln(char *s, bool preformatted, bool with_space)
+EXPORT void outln(Textwrap w, char *s, bool preformatted, bool with_space)
 {
-  out(s, preformatted, with_space);
-  flush();
-  assert(len == 0);
-  assert(bufchars == 0);
-  putchar('\n');
-  linelen = 0;
+  out(w, s, preformatted, with_space);
+  flush(w);
+  assert(w->len == 0);
+  assert(w->bufchars == 0);
+  outbuf_putc(w->o, '\n');
+  w->linelen = 0;
 }
 
 /* outbreak -- conditional new line; make sure next text starts on new line */
-EXPORT void outbreak(void)
-{
-  flush();
-  assert(len == 0);
-  assert(bufchars == 0);
-  if (linelen != 0) {
-    putchar('\n');
-    linelen = 0;
+EXPORT void outbreak(Textwrap w)
+{
+  flush(w);
+  assert(w->len == 0);
+  assert(w->bufchars == 0);
+  if (w->linelen != 0) {
+    outbuf_putc(w->o, '\n');
+    w->linelen = 0;
   }
 }
 
 /* outbreakpoint -- mark a possible line break point */
-EXPORT void outbreakpoint(void)
+EXPORT void outbreakpoint(Textwrap w)
 {
-  outc(BREAKOP, false, true);
+  outc(w, BREAKOP, false, true);
 }
 
 
 /* inc_indent -- increase indentation level by 1 */
-EXPORT void inc_indent(void)
+EXPORT void inc_indent(Textwrap w)
 {
-  flush();
-  level++;
+  flush(w);
+  w->level++;
 }
 
 /* dec_indent -- decrease indentation level by 1 */
-EXPORT void dec_indent(void)
+EXPORT void dec_indent(Textwrap w)
 {
-  flush();
-  level--;
+  flush(w);
+  w->level--;
 }
@@ -1,27 +1,32 @@
-extern void set_indent(int n);
-extern void set_linelen(int n);
-extern void flush();
-extern void outc(char c, 
-                        _Bool 
-                             preformatted, 
-                                           _Bool 
-                                                with_space);
-extern void out(string s, 
-                         _Bool 
-                              preformatted, 
-                                            _Bool 
-                                                 with_space);
-extern void outn(string s, size_t n, 
+typedef struct _Textwrap *Textwrap;
+extern Textwrap textwrap_new(Outbuf o);
+extern void textwrap_delete(Textwrap w);
+extern void set_indent(Textwrap w, int n);
+extern void set_linelen(Textwrap w, int n);
+extern void reset_textwrap(Textwrap w);
+extern void flush(Textwrap w);
+extern void outc(Textwrap w, char c, 
                                     _Bool 
                                          preformatted, 
                                                        _Bool 
                                                             with_space);
-extern void outln(char *s, 
-                          _Bool 
-                               preformatted, 
-                                             _Bool 
-                                                  with_space);
-extern void outbreak(void);
-extern void outbreakpoint(void);
-extern void inc_indent(void);
-extern void dec_indent(void);
+extern void outn(Textwrap w, string s, size_t n, 
+                                                _Bool 
+                                                     preformatted,
+   
+  _Bool 
+       with_space);
+extern void out(Textwrap w, string s, 
+                                     _Bool 
+                                          preformatted, 
+                                                        _Bool 
+                                                             with_space);
+extern void outln(Textwrap w, char *s, 
+                                      _Bool 
+                                           preformatted, 
+                                                         _Bool 
+                                                              with_space);
+extern void outbreak(Textwrap w);
+extern void outbreakpoint(Textwrap w);
+extern void inc_indent(Textwrap w);
+extern void dec_indent(Textwrap w);
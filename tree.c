@@ -22,12 +22,14 @@
 #include <ctype.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include "export.h"
 #include "heap.e"
 #include "types.e"
-#include "dtd.e"
 #include "errexit.e"
 #include "scan.e"
+#include "atom.e"
+#include "outbuf.e"
 
 EXPORT typedef enum {
   Element, Text, Comment, Declaration, Procins, Root
@@ -35,64 +37,291 @@ EXPORT typedef enum {
 
 EXPORT typedef struct _node {
   Nodetype tp;
-  string name;
+  string name;			/* An atom if tp is Element */
   pairlist attribs;
   string text;
   string url;
   struct _node *parent;
   struct _node *sister;
   struct _node *children;
+  struct _node *prev;		/* Previous sister */
+  struct _node *lastchild;	/* Last of the children */
+  int index;			/* Position among element sisters (from 1) */
+  int type;			/* Element type, see elt_flags() */
+  struct _IdIndex *ids;		/* Root only: index of IDs, or NULL */
 } Node, *Tree;
 
-  
+/* A walk over some sisters and their descendants, see cursor_start() */
+EXPORT typedef struct {
+  Node *node;			/* Current node, or NULL when done */
+  bool leaving;			/* Leaving node rather than entering it? */
+  Node *end;			/* Parent of the sisters, where the walk ends */
+} Cursor;
+
+/* Flags of an element type, as returned by elt_flags() */
+#define ELT_KNOWN 0x001		/* An HTML element */
+#define ELT_MIXED 0x002		/* Accepts text content */
+#define ELT_EMPTY 0x004		/* Is empty */
+#define ELT_CDATA 0x008		/* Has character data content */
+#define ELT_STAG 0x010		/* Start tag is required */
+#define ELT_ETAG 0x020		/* End tag is required */
+#define ELT_PRE 0x040		/* Content is preformatted */
+#define ELT_BREAK_BEFORE 0x080	/* Pretty-print with a newline before */
+#define ELT_BREAK_AFTER 0x100	/* Pretty-print with a newline after */
+#define ELT_ROOT 0x200		/* Has no possible parents */
+EXPORTDEF(ELT_KNOWN)
+EXPORTDEF(ELT_MIXED)
+EXPORTDEF(ELT_EMPTY)
+EXPORTDEF(ELT_CDATA)
+EXPORTDEF(ELT_STAG)
+EXPORTDEF(ELT_ETAG)
+EXPORTDEF(ELT_PRE)
+EXPORTDEF(ELT_BREAK_BEFORE)
+EXPORTDEF(ELT_BREAK_AFTER)
+EXPORTDEF(ELT_ROOT)
+
+#include "store.e"		/* Uses Nodetype, so not at the top */
+
+/* Element types are numbered, so that a Node can hold its type and
+   the DTD can be consulted with array lookups and bit tests instead of
+   string comparisons. The table of types, types[], and that of the
+   omitted start tags between them, paths[] (see build_path()), are
+   made from dtd.hash by mkdtd when the program is built. Type 0 is
+   that of all unknown elements. */
+#include "dtdtypes.h"
+#define UNRESOLVED (-1)		/* Node's type not looked up yet */
+
+static bool merge_text = true;		/* Coalesce consecutive text chunks? */
+static Node *growing = NULL;		/* Text node that was last extended */
+static string growing_text = NULL;	/* Its text buffer, */
+static size_t growing_len = 0;		/* the length of the text */
+static size_t growing_size = 0;		/* and the size of the buffer */
+
+/* The elements of a document by ID, built by get_elt_by_id() and
+   then kept up to date by the functions that change the tree. The
+   index hangs from the document's Root and is allocated in the same
+   arena. Each ID has a count, so duplicates can be added and removed.
+   If it isn't known which of several elements with an ID comes first,
+   elt is NULL and get_elt_by_id() looks for it again. */
+typedef struct {
+  string id;			/* Copy of the ID, NULL = empty slot */
+  Node *elt;			/* First element with the ID, NULL = unknown */
+  size_t count;			/* # of elements with the ID, 0 = removed */
+} IdSlot;
+
+typedef struct _IdIndex {
+  Arena arena;			/* Where the document and the index are */
+  IdSlot *slots;		/* Open hash table */
+  size_t size;			/* # of slots, a power of 2 */
+  size_t used;			/* # of slots with an id */
+} *IdIndex;
+
+/* set_merge_text -- whether consecutive text chunks go into one Text node */
+EXPORT void set_merge_text(bool merge)
+{
+  merge_text = merge;
+}
+
+
+/* id_hash -- compute a hash of an ID (FNV-1a) */
+static size_t id_hash(const conststring id)
+{
+  const unsigned char *p;
+  size_t h = 2166136261U;
+
+  for (p = (const unsigned char *)id; *p; p++) h = (h ^ *p) * 16777619U;
+  return h;
+}
+
+
+/* id_slot -- return the slot of id in ix, or NULL; if add, make one */
+static IdSlot *id_slot(IdIndex ix, const conststring id, bool add)
+{
+  size_t i;
+
+  if (ix->size == 0) return NULL;
+  for (i = id_hash(id) & (ix->size - 1); ix->slots[i].id;
+       i = (i + 1) & (ix->size - 1))
+    if (eq(ix->slots[i].id, id)) return &ix->slots[i];
+  if (!add) return NULL;
+  ix->slots[i].id = newstring(id);		/* In the index's arena */
+  ix->slots[i].elt = NULL;
+  ix->slots[i].count = 0;
+  ix->used++;
+  return &ix->slots[i];
+}
+
+
+/* id_grow -- make room for one more ID, drop IDs that were removed */
+static void id_grow(IdIndex ix)
+{
+  IdSlot *old = ix->slots, *h;
+  size_t i, oldsize = ix->size, live = 0;
+
+  for (i = 0; i < oldsize; i++) if (old[i].count) live++;
+  for (ix->size = 256; 4 * (live + 1) > ix->size; ix->size *= 2) ;
+  newarray(ix->slots, ix->size);
+  for (i = 0; i < ix->size; i++) ix->slots[i].id = NULL;
+  ix->used = 0;
+  for (i = 0; i < oldsize; i++)
+    if (!old[i].count) {
+      dispose(old[i].id);
+    } else {
+      for (h = &ix->slots[id_hash(old[i].id) & (ix->size - 1)]; h->id;
+	   h = h == &ix->slots[ix->size - 1] ? ix->slots : h + 1) ;
+      *h = old[i];
+      ix->used++;
+    }
+  dispose(old);
+}
+
+
+/* id_add -- count element n in the index, if it has an ID */
+static void id_add(IdIndex ix, Node *n, bool in_order)
+{
+  conststring id;
+  IdSlot *slot;
+  Arena prev;
+
+  if (!(id = pairlist_get(n->attribs, "id"))) return;
+  prev = arena_use(ix->arena);
+  if (2 * (ix->used + 1) > ix->size) id_grow(ix);
+  slot = id_slot(ix, id, true);
+  (void) arena_use(prev);
+  if (slot->count++ == 0) slot->elt = n;
+  else if (!in_order) slot->elt = NULL;	/* n may precede the first one */
+}
+
+
+/* id_remove -- uncount element n in the index */
+static void id_remove(IdIndex ix, Node *n)
+{
+  conststring id;
+  IdSlot *slot;
+
+  if ((id = pairlist_get(n->attribs, "id"))
+      && (slot = id_slot(ix, id, false)) && slot->count) {
+    slot->count--;
+    if (slot->elt == n) slot->elt = NULL;	/* Another may take its place */
+  }
+}
+
+
+/* id_delete -- free an index */
+static void id_delete(IdIndex ix)
+{
+  size_t i;
+
+  for (i = 0; i < ix->size; i++) dispose(ix->slots[i].id);
+  dispose(ix->slots);
+  dispose(ix);
+}
+
+
+/* index_of -- return the ID index of the document that n is in, or NULL */
+static IdIndex index_of(Node *n)
+{
+  while (n->parent) n = n->parent;
+  return n->tp == Root ? n->ids : NULL;
+}
+
+
+/* id_link -- add new element n to the index of its document, if any */
+static void id_link(Node *n)
+{
+  IdIndex ix;
+
+  if (pairlist_get(n->attribs, "id") && (ix = index_of(n))) id_add(ix, n, false);
+}
+
+
+/* cursor_start -- start a walk over t, its following sisters and all
+   their descendants. The cursor visits each node twice, first entering
+   it and, after its descendants, leaving it. It needs no stack, so the
+   depth and width of the tree do not matter */
+EXPORT void cursor_start(Cursor *c, Tree t)
+{
+  c->node = t;
+  c->leaving = false;
+  c->end = t ? t->parent : NULL;
+}
+
+/* cursor_next -- move to the next node to enter or leave */
+EXPORT void cursor_next(Cursor *c)
+{
+  Node *n = c->node;
+
+  assert(n != NULL);
+  if (!c->leaving) {
+    if (n->children) c->node = n->children;	/* Enter the first child */
+    else c->leaving = true;			/* Leave n right away */
+  } else if (n->sister) {
+    c->node = n->sister;			/* Enter the next sister */
+    c->leaving = false;
+  } else {
+    c->node = n->parent == c->end ? NULL : n->parent; /* Leave the parent */
+  }
+}
+
+/* cursor_skip -- after entering a node, skip its descendants and its leave */
+EXPORT void cursor_skip(Cursor *c)
+{
+  assert(c->node && !c->leaving);
+  c->leaving = true;
+}
+
 
 /* create -- create an empty tree */
 EXPORT Tree create(void)
 {
-  Tree t = malloc(sizeof(*t));
-  assert(t != NULL);
+  Tree t;
+
+  new(t);
   t->tp = Root;
   t->name = "";
-  t->sister = t->children = NULL;
+  t->type = 0;
+  t->parent = t->prev = NULL;
+  t->sister = t->children = t->lastchild = NULL;
+  t->index = 0;
+  t->ids = NULL;
+  growing = NULL;		/* Nodes of an earlier tree may be reused */
   return t;
 }
 
-/* tree_delete -- recursively free the memory occupied by a tree */
+/* tree_delete -- free the memory occupied by t, its sisters and subtrees */
 EXPORT void tree_delete(Tree t)
 {
-  if (t != NULL) {
+  IdIndex ix = t && t->tp != Root ? index_of(t) : NULL;
+  bool leaving;
+  Cursor c;
+
+  for (cursor_start(&c, t); c.node;) {
+    t = c.node;
+    leaving = c.leaving;
+    cursor_next(&c);			/* Move on before t is freed */
+    if (!leaving) continue;		/* Free t only after its children */
     switch (t->tp) {
-      case Element:
-	dispose(t->name);
+      case Element:				/* Name is an atom, keep it */
+	if (ix) id_remove(ix, t);
 	pairlist_delete(t->attribs);
-	tree_delete(t->sister);
-	tree_delete(t->children);
 	break;
       case Text:
+	if (t == growing) growing = NULL;
 	dispose(t->text);
-	assert(t->children == NULL);
-	tree_delete(t->sister);
 	break;
       case Comment:
 	dispose(t->text);
-	assert(t->children == NULL);
-	tree_delete(t->sister);
 	break;
       case Declaration:
 	dispose(t->name);
 	dispose(t->text);
 	dispose(t->url);
-	assert(t->children == NULL);
-	tree_delete(t->sister);
 	break;
       case Procins:
 	dispose(t->text);
-	assert(t->children == NULL);
-	tree_delete(t->sister);
 	break;
       case Root:
-	assert(t->sister == NULL);
-	tree_delete(t->children);
+	if (t->ids) id_delete(t->ids);
 	break;
       default:
 	assert(!"Cannot happen");
@@ -101,6 +330,25 @@ EXPORT void tree_delete(Tree t)
   }
 }
 
+/* tree_delete_children -- free the children of t, but keep t itself */
+EXPORT void tree_delete_children(Tree t)
+{
+  tree_delete(t->children);
+  t->children = t->lastchild = NULL;
+}
+
+/* tree_delete_before -- free the sisters that precede t */
+EXPORT void tree_delete_before(Tree t)
+{
+  Tree first = t->parent->children;
+
+  if (first == t) return;
+  t->prev->sister = NULL;
+  t->prev = NULL;
+  t->parent->children = t;
+  tree_delete(first);				/* Index of t remains valid */
+}
+
 /* get_root -- return root of tree */
 EXPORT Tree get_root(Tree t)
 {
@@ -120,40 +368,73 @@ EXPORT conststring get_attrib(const Node *e, const conststring attname)
 /* set_attrib -- set an attribute to a value */
 EXPORT void set_attrib(Node *e, string name, conststring value)
 {
+  IdIndex ix = eq(name, "id") ? index_of(e) : NULL;
+
   assert(e->tp == Element);
+  if (ix) id_remove(ix, e);
   pairlist_set(&e->attribs, name, value);
+  if (ix) id_add(ix, e, false);
 }
 
 /* delete_attrib -- remove attribute from element, false if not found */
 EXPORT bool delete_attrib(Node *e, const conststring name)
 {
+  IdIndex ix = eq(name, "id") ? index_of(e) : NULL;
+
   assert(e->tp == Element);
+  if (ix) id_remove(ix, e);
   return pairlist_unset(&e->attribs, name);
 }
 
-/* get_by_id -- recursively get the element node with the id in subtree n */
-static Tree get_by_id(Node *n, const conststring id)
+/* id_first -- find the first element with ID id in document order */
+static Node *id_first(Tree root, const conststring id)
 {
-  conststring val;
-  Tree h, p;
+  conststring v;
+  Cursor c;
 
-  assert(n->tp == Element);
-  if ((val = get_attrib(n, "id")) && eq(val, id)) return n;
-  for (h = n->children; h; h = h->sister)
-    if (h->tp == Element && (p = get_by_id(h, id))) return p;
+  for (cursor_start(&c, root->children); c.node; cursor_next(&c))
+    if (!c.leaving && c.node->tp == Element
+	&& (v = pairlist_get(c.node->attribs, "id")) && eq(v, id))
+      return c.node;
   return NULL;
 }
 
+/* id_build -- make an index of the IDs in document root */
+static void id_build(Tree root)
+{
+  Arena prev = arena_use(arena_of(root));	/* Index lives as long as root */
+  Cursor c;
+
+  new(root->ids);
+  root->ids->arena = arena_of(root);
+  root->ids->slots = NULL;
+  root->ids->size = root->ids->used = 0;
+  (void) arena_use(prev);
+  for (cursor_start(&c, root->children); c.node; cursor_next(&c))
+    if (!c.leaving && c.node->tp == Element) id_add(root->ids, c.node, true);
+}
+
 /* get_elt_by_id -- get the element node with the ID attribute id */
 EXPORT Tree get_elt_by_id(Node *n, const conststring id)
 {
-  /* To do: should this use a hash table? */
-  Tree h, p;
+  Tree root = get_root(n);
+  IdSlot *slot;
 
-  h = get_root(n);
-  for (h = h->children; h; h = h->sister)
-    if (h->tp == Element && (p = get_by_id(h, id))) return p;
-  return NULL;
+  if (!root->ids) id_build(root);
+  if (!(slot = id_slot(root->ids, id, false)) || !slot->count) return NULL;
+  if (!slot->elt) slot->elt = id_first(root, id); /* Changed since last time */
+  return slot->elt;
+}
+
+/* renumber -- recompute the element index of n and its following sisters */
+static void renumber(Node *n)
+{
+  Node *h;
+  int i;
+
+  for (h = n->prev; h && h->tp != Element; h = h->prev) ;
+  for (i = h ? h->index : 0, h = n; h; h = h->sister)
+    h->index = h->tp == Element ? ++i : 0;
 }
 
 /* wrap_contents -- wrap contents of a node in an element, return new elt */
@@ -163,37 +444,42 @@ EXPORT Tree wrap_contents(Node *n, const string elem, pairlist attr)
 
   new(h);
   h->tp = Element;
-  h->name = newstring(elem);
+  h->name = (string)atom(elem);
+  h->type = UNRESOLVED;
   h->attribs = attr;
-  h->sister = NULL;
+  h->sister = h->prev = NULL;
   h->parent = n;
   h->children = n->children;
-  n->children = h;
+  h->lastchild = n->lastchild;
+  h->index = 1;
+  n->children = n->lastchild = h;
   for (k = h->children; k; k = k->sister) k->parent = h;
+  id_link(h);
   return h;
 }
 
 /* wrap_elt -- wrap an element in a new element, return the new element */
 EXPORT Tree wrap_elt(Node *n, const conststring elem, pairlist attr)
 {
-  Node *h, *k;
+  Node *h;
 
   new(h);
   h->tp = Element;
-  h->name = newstring(elem);
+  h->name = (string)atom(elem);
+  h->type = UNRESOLVED;
   h->attribs = attr;
   h->sister = n->sister;
+  h->prev = n->prev;
   h->parent = n->parent;
-  h->children = n;
-  n->sister = NULL;
+  h->children = h->lastchild = n;
+  h->index = n->index;
+  n->sister = n->prev = NULL;
   n->parent = h;
-  if (h->parent->children == n) {
-    h->parent->children = h;
-  } else {
-    k = h->parent->children;
-    while (k->sister != n) {assert(k->sister->sister); k = k->sister;}
-    k->sister = h;
-  }
+  if (h->prev) h->prev->sister = h; else h->parent->children = h;
+  if (h->sister) h->sister->prev = h; else h->parent->lastchild = h;
+  if (n->tp == Element) n->index = 1;
+  else renumber(h);		/* An element took the place of a non-element */
+  id_link(h);
   return h;
 }
 
@@ -201,20 +487,33 @@ EXPORT Tree wrap_elt(Node *n, const conststring elem, pairlist attr)
 EXPORT void rename_elt(Node *n, const string elem)
 {
   assert(n->tp == Element);
-  n->name = newstring(elem);
+  n->name = (string)atom(elem);
+  n->type = UNRESOLVED;
+}
+
+/* link_child -- add n after the last child of t, in constant time */
+static void link_child(Tree t, Node *n)
+{
+  Node *h;
+
+  assert(t != NULL);
+  n->parent = t;
+  n->prev = t->lastchild;
+  n->index = 0;
+  if (t->lastchild == NULL) t->children = n; else t->lastchild->sister = n;
+  t->lastchild = n;
+  if (n->tp == Element) {
+    /* Usually only a little white space separates n from the previous elt */
+    for (h = n->prev; h && h->tp != Element; h = h->prev) ;
+    n->index = h ? h->index + 1 : 1;
+    id_link(n);
+  }
 }
 
 /* push -- add a child node to the tree */
 static Tree push(Tree t, Node *n)
 {
-  if (t->children == NULL) {
-    t->children = n;
-  } else {
-    Tree h = t->children;
-    while (h->sister != NULL) h = h->sister;
-    h->sister = n;
-  }
-  n->parent = t;
+  link_child(t, n);
   return n;
 }
 
@@ -229,148 +528,135 @@ static Tree pop(Tree t)
 /* append -- add at end of children */
 static Tree append(Tree t, Node *n)
 {
-  assert(t != NULL);
-  if (t->children == NULL) {
-    t->children = n;
-  } else {
-    Tree h = t->children;
-    while (h->sister != NULL) h = h->sister;
-    h->sister = n;
-  }
-  n->parent = t;
+  link_child(t, n);
   return t;
 }
 
-/* lookup -- lookup info about an element case-insensitively */
-static const ElementType *lookup(const string e)
+/* elt_type -- return the number of the type of element e */
+static int elt_type(const conststring e)
 {
-  char h[MAXNAMELEN+2];
-  strncpy(h, e, sizeof(h) - 1);
-  h[sizeof(h)-1] = '\0';
-  down(h);
-  return lookup_element(h, strlen(h));
+  const unsigned char *p;
+  uint32_t h = 2166136261U;
+  int t;
+
+  /* Hash the name case-insensitively as mkdtd did (FNV-1a), then probe */
+  for (p = (const unsigned char *)e; *p; p++) h = (h ^ tolower(*p)) * 16777619U;
+  for (h &= NHASH - 1; (t = type_hash[h]); h = (h + 1) & (NHASH - 1))
+    if (strcasecmp(types[t].name, e) == 0) return t;
+  return 0;
+}
+
+/* node_type -- return the type of node n, looking it up only once */
+static int node_type(Node *n)
+{
+  if (n->tp != Element) return 0;
+  if (n->type == UNRESOLVED) n->type = elt_type(n->name);
+  return n->type;
+}
+
+/* type_has_parent -- true if type c accepts type p as a parent */
+static bool type_has_parent(int c, int p)
+{
+  return p && (types[c].parents[p/32] >> (p % 32)) & 1;
+}
+
+/* elt_flags -- return the ELT_* flags of the type of element n */
+EXPORT unsigned int elt_flags(Node *n)
+{
+  return types[node_type(n)].flags;
+}
+
+/* elt_has_parent -- true if element c accepts element p as a parent */
+EXPORT bool elt_has_parent(Node *c, Node *p)
+{
+  return type_has_parent(node_type(c), node_type(p));
 }
 
 /* is_known -- true if the element is an HTML 4 element */
 EXPORT bool is_known(const string e)
 {
-  return lookup(e) != NULL;
+  return types[elt_type(e)].flags & ELT_KNOWN;
 }
 
 /* is_pre -- true if the element has preformatted content */
 EXPORT bool is_pre(const string e)
 {
-  const ElementType *info = lookup(e);
-  return info && info->pre;
+  return types[elt_type(e)].flags & ELT_PRE;
 }
 
 /* need_stag -- true if the element's start tag is required */
 EXPORT bool need_stag(const string e)
 {
-  const ElementType *info = lookup(e);
-  return !info || info->stag;
+  return types[elt_type(e)].flags & ELT_STAG;
 }
 
 /* need_etag -- true if the element's end tag is required */
 EXPORT bool need_etag(const string e)
 {
-  const ElementType *info = lookup(e);
-  return !info || info->etag;
+  return types[elt_type(e)].flags & ELT_ETAG;
 }
 
 /* is_empty -- true if element is empty */
 EXPORT bool is_empty(const string e)
 {
-  const ElementType *info = lookup(e);
-  return info && info->empty;
+  return types[elt_type(e)].flags & ELT_EMPTY;
 }
 
 /* has_parent -- true if c accepts p as a parent */
 EXPORT bool has_parent(const string c, const string p)
 {
-  const ElementType *info = lookup_element(c, strlen(c));
-  int i;
-  if (!info) return false;
-  for (i = 0; info->parents[i]; i++)
-    if (eq(info->parents[i], p)) return true;
-  return false;
+  return type_has_parent(elt_type(c), elt_type(p));
 }
 
-/* preferred_parent -- return first possible parent of e */
-static string preferred_parent(const string e)
-{
-  const ElementType *info = lookup_element(e, strlen(e));
-  assert(info != NULL);				/* element is known */
-  assert(info->parents[0] != NULL);		/* element is not root */
-  return info->parents[0];
-}
-  
-/* is_root -- true if e has no possible parents */
-static bool is_root(const string e)
-{
-  const ElementType *info = lookup_element(e, strlen(e));
-  assert(info != NULL);				/* element is known */
-  return info->parents[0] == NULL;
-}
-  
 /* is_mixed -- true if e accepts text content */
 EXPORT bool is_mixed(const string e)
 {
-  const ElementType *info = lookup(e);
-  return !info || info->mixed;
+  return types[elt_type(e)].flags & ELT_MIXED;
 }
-  
+
 /* break_before -- true if element looks better with a newline before it */
 EXPORT bool break_before(const string e)
 {
-  const ElementType *info = lookup(e);
-  return info && info->break_before;
+  return types[elt_type(e)].flags & ELT_BREAK_BEFORE;
 }
-  
+
 /* break_after -- true if element looks better with a newline after it */
 EXPORT bool break_after(const string e)
 {
-  const ElementType *info = lookup(e);
-  return info && info->break_after;
+  return types[elt_type(e)].flags & ELT_BREAK_AFTER;
 }
 
 /* is_cdata_elt -- true if element has character data content */
 EXPORT bool is_cdata_elt(const string e)
 {
-  const ElementType *info = lookup(e);
-  return info && info->cdata;
+  return types[elt_type(e)].flags & ELT_CDATA;
 }
 
-/* build_path -- try to add omittable start tags to make elem acceptable */
-static bool build_path(Tree *t, string elem)
+/* build_path -- try to add omittable start tags to make type acceptable */
+static bool build_path(Tree *t, int type)
 {
-  const ElementType *info;
   Node *n;
-  int i;
+  int path, q;
 
-  assert(is_known(elem));
-  assert(is_known((*t)->name));
-
-  /* Check if we are done */
-  if (has_parent(elem, (*t)->name)) return true;
-  
-  /* Try recursively if any possible parent can be a child of t */
-  info = lookup(elem);
-  for (i = 0; info->parents[i]; i++) {
-    if (!need_stag(info->parents[i]) && build_path(t, info->parents[i])) {
-      /* Success, so add this parent and return true */
-      n = malloc(sizeof(*n));
-      assert(n != NULL);
-      n->tp = Element;
-      n->name = newstring(info->parents[i]);
-      assert(islower(n->name[0]));
-      n->attribs = NULL;
-      n->sister = n->children = NULL;
-      *t = push(*t, n);
-      return true;
-    }
-  }
-  return false;
+  assert(types[type].flags & ELT_KNOWN);
+  assert(elt_flags(*t) & ELT_KNOWN);
+
+  path = paths[type][node_type(*t)];
+  if (path == PATH_NONE) return false;
+  if (path == PATH_DIRECT) return true;
+
+  /* Add the start tags for the path up to q, then q itself */
+  q = path - PATH_VIA;
+  (void) build_path(t, q);
+  new(n);
+  n->tp = Element;
+  n->name = (string)atom(types[q].name);
+  n->type = q;
+  assert(islower(n->name[0]));
+  n->attribs = NULL;
+  n->sister = n->children = n->lastchild = NULL;
+  *t = push(*t, n);
+  return true;
 }
 
 /* tree_push -- add an element to the tree, without checking the DTD */
@@ -379,9 +665,10 @@ EXPORT Tree tree_push(Tree t, string elem, pairlist attr)
   Node *n;
   new(n);
   n->tp = Element;
-  n->name = newstring(elem);
+  n->name = (string)atom(elem);
+  n->type = UNRESOLVED;
   n->attribs = attr;
-  n->sister = n->children = NULL;
+  n->sister = n->children = n->lastchild = NULL;
   return push(t, n);
 }
 
@@ -389,35 +676,42 @@ EXPORT Tree tree_push(Tree t, string elem, pairlist attr)
 EXPORT Tree html_push(Tree t, string elem, pairlist attr)
 {
   pairlist a;
-  Node *h, *n = malloc(sizeof(*n));
-  assert(n != NULL);
+  Node *h, *n;
+  unsigned int flags;
+  int type;
+
+  new(n);
   n->tp = Element;
-  n->name = down(newstring(elem));
+  n->name = (string)atom_down(elem);
+  n->type = UNRESOLVED;
   for (a = attr; a; a = a->next) down(a->name);
   n->attribs = attr;
-  n->sister = n->children = NULL;
+  n->sister = n->children = n->lastchild = NULL;
+  flags = elt_flags(n);
+  type = n->type;
 
   /* Unknown elements are just pushed where they are */
-  if (!is_known(n->name)) return push(t, n);
+  if (!(flags & ELT_KNOWN)) return push(t, n);
 
-  if (is_root(n->name)) {
+  if (flags & ELT_ROOT) {
     while (t->tp != Root) t = pop(t);		/* Make sure root is at root */
-  } else if (is_known(t->name) && build_path(&t, n->name)) {
+  } else if ((elt_flags(t) & ELT_KNOWN) && build_path(&t, type)) {
     ;						/* Added missing start tags */
   } else {
     /* Check if there is a possible parent further up the tree */
-    for (h=t; h->tp!=Root && is_known(h->name) && !has_parent(n->name,h->name);
-	 h = h->parent) ;
+    for (h = t; h->tp != Root && (elt_flags(h) & ELT_KNOWN)
+	   && !type_has_parent(type, node_type(h)); h = h->parent) ;
     /* Close omitted end tags */
     if (h->tp != Root) while (t != h) t = pop(t);
     /* If no valid parent, fabricate one */
-    if (t->tp == Root || (is_known(t->name) && !has_parent(n->name, t->name)))
-      t = html_push(t, preferred_parent(n->name), NULL);
+    if (t->tp == Root || ((elt_flags(t) & ELT_KNOWN)
+			  && !type_has_parent(type, node_type(t))))
+      t = html_push(t, (string)types[types[type].order[0]].name, NULL);
   }
   t = push(t, n);
 
-  if (is_empty(n->name)) t = pop(t);
-  if (is_cdata_elt(n->name)) set_cdata_element(n->name); /* Change scanner */
+  if (flags & ELT_EMPTY) t = pop(t);
+  if (flags & ELT_CDATA) set_cdata_element(n->name); /* Change scanner */
   return t;
 }
 
@@ -437,12 +731,13 @@ EXPORT Tree tree_pop(Tree t, string elem)
 EXPORT Tree html_pop(Tree t, string elem)
 {
   Tree h = t;
+  conststring name;
   assert(t != NULL);
-  down(elem);
   if (*elem == '\0') {				/* </> */
     if (t->tp != Root) t = pop(t);
   } else {					/* </name> */
-    for (h = t; h->tp != Root && !eq(h->name, elem); h = h->parent) ;
+    name = atom_down(elem);			/* Compare atoms, not strings */
+    for (h = t; h->tp != Root && h->name != name; h = h->parent) ;
     if (h->tp != Root) {			/* Found open element */
       while (t != h) t = pop(t);
       t = pop(t);
@@ -454,11 +749,12 @@ EXPORT Tree html_pop(Tree t, string elem)
 /* append_comment -- add a comment to the tree */
 EXPORT Tree append_comment(Tree t, string comment)
 {
-  Node *n = malloc(sizeof(*n));
-  assert(n != NULL);
+  Node *n;
+
+  new(n);
   n->tp = Comment;
   n->text = comment;
-  n->sister = n->children = NULL;
+  n->sister = n->children = n->lastchild = NULL;
   return append(t, n);
 }
 
@@ -466,109 +762,183 @@ EXPORT Tree append_comment(Tree t, string comment)
 EXPORT Tree append_declaration(Tree t, string gi,
 			       string fpi, string url)
 {
-  Node *n = malloc(sizeof(*n));
-  assert(n != NULL);
+  Node *n;
+
+  new(n);
   n->tp = Declaration;
   n->name = down(gi);
   n->text = fpi;
   n->url = url;
-  n->sister = n->children = NULL;
+  n->sister = n->children = n->lastchild = NULL;
   return append(t, n);
 }
 
 /* append_procins -- append a processing instruction */
 EXPORT Tree append_procins(Tree t, string procins)
 {
-  Node *n = malloc(sizeof(*n));
-  assert(n != NULL);
+  Node *n;
+
+  new(n);
   n->tp = Procins;
   n->text = procins;
-  n->sister = n->children = NULL;
+  n->sister = n->children = n->lastchild = NULL;
   return append(t, n);
 }
 
-/* tree_append_text -- append a text chunk, without checking the DTD */
-EXPORT Tree tree_append_text(Tree t, string text)
+/* is_cdata_section -- true if text is a "<![CDATA[...]]>" section */
+static bool is_cdata_section(const conststring text)
 {
-  Node *n;
+  return hasprefix(text, "<![CDATA[");
+}
+
+/* add_text -- add text to t, extending t's last child if it is a Text node */
+static Tree add_text(Tree t, string text)
+{
+  Node *n, *h;
+  size_t len;
 
   assert(text);
-  new(n);
-  n->tp = Text;
-  n->text = text;
-  n->sister = n->children = NULL;
-  return append(t, n);
+
+  h = t->lastchild;
+
+  /* CDATA sections are kept as separate nodes, some tools look for them */
+  if (!merge_text || !h || h->tp != Text
+      || is_cdata_section(h->text) || is_cdata_section(text)) {
+    new(n);
+    n->tp = Text;
+    n->text = text;
+    n->sister = n->children = n->lastchild = NULL;
+    return append(t, n);
+  }
+
+  /* Remember the size of the buffer, so it can grow geometrically */
+  if (h != growing || h->text != growing_text) {
+    growing = h;
+    growing_len = strlen(h->text);
+    growing_size = growing_len + 1;
+  }
+  len = strlen(text);
+  if (growing_len + len + 1 > growing_size) {
+    growing_size = 2 * (growing_len + len + 1);
+    renewarray(h->text, growing_size);
+  }
+  memcpy(h->text + growing_len, text, len + 1);
+  growing_len += len;
+  growing_text = h->text;
+  dispose(text);
+  return t;
+}
+
+/* tree_append_text -- append a text chunk, without checking the DTD */
+EXPORT Tree tree_append_text(Tree t, string text)
+{
+  return add_text(t, text);
 }
 
 /* append_text -- append a text chunk to the document tree */
 EXPORT Tree append_text(Tree t, string text)
 {
-  Node *n;
-  string new_parent;
+  int new_parent = types[DATA_TYPE].order[0];
 
-  if (only_space(text) && (t->tp == Root || !is_mixed(t->name))) {
+  if (only_space(text) && (t->tp == Root || !(elt_flags(t) & ELT_MIXED))) {
     /* Drop text, since it is non-significant whitespace */
     return t;
   }
-  if (t->tp == Root || !is_mixed(t->name)) {
+  if (t->tp == Root || !(elt_flags(t) & ELT_MIXED)) {
     /* Need heuristics to make a valid tree */
-    new_parent = preferred_parent("%data");
     /* Close omitted end tags until text or preferred parent fits */
-    while (t->tp != Root && !is_mixed(t->name) && !need_etag(t->name)
-	   && !has_parent(new_parent, t->name))
+    while (t->tp != Root && !(elt_flags(t) & (ELT_MIXED | ELT_ETAG))
+	   && !type_has_parent(new_parent, node_type(t)))
       t = pop(t);
     /* Fabricate a parent if needed */
-    if (t->tp == Root || !is_mixed(t->name))
-      t = html_push(t, new_parent, NULL);
+    if (t->tp == Root || !(elt_flags(t) & ELT_MIXED))
+      t = html_push(t, (string)types[new_parent].name, NULL);
   }
-  n = malloc(sizeof(*n));
-  assert(n != NULL);
-  n->tp = Text;
-  n->text = text;
-  assert(n->text != NULL);
-  n->sister = n->children = NULL;
-  return append(t, n);
+  return add_text(t, text);
 }
 
-static void dump2(Tree n, FILE *f)
-{
-  pairlist h;
-  Tree l;
-
-  switch (n->tp) {
-    case Text: fprintf(f, "%s", n->text); break;
-    case Comment: fprintf(f, "<!--%s-->", n->text); break;
-    case Declaration:
-      fprintf(f, "<!DOCTYPE %s", n->name);
-      if (n->text) fprintf(f, " PUBLIC \"%s\">", n->text);
-      if (n->url) fprintf(f, " %s\"%s\">", n->text ? "" : "SYSTEM ", n->url);
-      fprintf(f, ">");
-      break;
-    case Procins: fprintf(f, "<?%s>", n->text); break;
-    case Element:
-      fprintf(f, "<%s", n->name);
-      for (h = n->attribs; h != NULL; h = h->next) {
-	fprintf(f, " %s", h->name);
-	if (h->value != NULL) fprintf(f, "=\"%s\"", h->value);
-      }
-      if (is_empty(n->name)) {
-	assert(n->children == NULL);
-	fprintf(f, " />");
-      } else {
-	fprintf(f, ">");
-	for (l = n->children; l != NULL; l = l->sister) dump2(l, f);
-	fprintf(f, "</%s>", n->name);
-      }
-      break;
-    default:
-      assert(!"Cannot happen");
+/* dumptree -- write out the tree below t (t's children, not t itself)*/
+EXPORT void dumptree(Tree t, FILE *f)
+{
+  Outbuf o = f == stdout ? outbuf_stdout() : outbuf_new(f);
+  Cursor c;
+  Node *n;
+
+  for (cursor_start(&c, t->children); c.node; cursor_next(&c)) {
+    n = c.node;
+    if (c.leaving) {
+      if (n->tp == Element && !(elt_flags(n) & ELT_EMPTY))
+	outbuf_wrap(o, "</", n->name, ">");
+      continue;
+    }
+    switch (n->tp) {
+      case Text: outbuf_puts(o, n->text); break;
+      case Comment: outbuf_wrap(o, "<!--", n->text, "-->"); break;
+      case Declaration:
+	outbuf_wrap(o, "<!DOCTYPE ", n->name, "");
+	if (n->text) outbuf_wrap(o, " PUBLIC \"", n->text, "\">");
+	if (n->url)
+	  outbuf_wrap(o, n->text ? " \"" : " SYSTEM \"", n->url, "\">");
+	outbuf_putc(o, '>');
+	break;
+      case Procins: outbuf_wrap(o, "<?", n->text, ">"); break;
+      case Element:
+	outbuf_wrap(o, "<", n->name, "");
+	outbuf_attribs(o, n->attribs);
+	if (elt_flags(n) & ELT_EMPTY) {
+	  assert(n->children == NULL);
+	  outbuf_write(o, " />", 3);
+	} else {
+	  outbuf_putc(o, '>');
+	}
+	break;
+      default:
+	assert(!"Cannot happen");
+    }
   }
+  if (f == stdout) (void) outbuf_flush(o);
+  else (void) outbuf_delete(o);
 }
 
-/* dumptree -- write out the tree below t (t's children, not t itself)*/
-EXPORT void dumptree(Tree t, FILE *f)
+/* tree_to_store -- make a compact, read-only copy of the tree t */
+EXPORT struct _Store *tree_to_store(Tree t)
+{
+  Store st = store_create();
+  NodeId cur = store_root(st), id = 0;
+  Cursor c;
+
+  assert(t->tp == Root);
+  for (cursor_start(&c, t->children); c.node; cursor_next(&c)) {
+    t = c.node;
+    if (c.leaving) {
+      if (t->children) cur = store_parent(st, cur);	/* Back up */
+      continue;
+    }
+    switch (t->tp) {
+      case Element:
+	id = store_add_element(st, cur, t->name, t->attribs, !t->children
+			       && (elt_flags(t) & ELT_EMPTY));
+	break;
+      case Text: case Comment: case Procins:
+	id = store_add_text(st, cur, t->tp, t->text);
+	break;
+      case Declaration:
+	id = store_add_declaration(st, cur, t->name, t->text, t->url);
+	break;
+      default:
+	assert(!"Cannot happen");
+    }
+    if (t->children) cur = id;			/* Descend */
+  }
+  return st;
+}
+
+/* write_snapshot -- write the tree t to f as a snapshot, false on error */
+EXPORT bool write_snapshot(Tree t, FILE *f)
 {
-  Tree h;
+  Store st = tree_to_store(t);
+  bool ok = store_write(st, f) && fflush(f) == 0;
 
-  for (h = t->children; h != NULL; h = h->sister) dump2(h, f);
+  store_delete(st);
+  return ok;
 }
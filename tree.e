@@ -10,9 +10,39 @@ typedef struct _node {
   struct _node *parent;
   struct _node *sister;
   struct _node *children;
+  struct _node *prev;
+  struct _node *lastchild;
+  int index;
+  int type;
+  struct _IdIndex *ids;
 } Node, *Tree;
+typedef struct {
+  Node *node;
+  
+ _Bool 
+      leaving;
+  Node *end;
+} Cursor;
+#define ELT_KNOWN  0x001
+#define ELT_MIXED  0x002
+#define ELT_EMPTY  0x004
+#define ELT_CDATA  0x008
+#define ELT_STAG  0x010
+#define ELT_ETAG  0x020
+#define ELT_PRE  0x040
+#define ELT_BREAK_BEFORE  0x080
+#define ELT_BREAK_AFTER  0x100
+#define ELT_ROOT  0x200
+extern void set_merge_text(
+                          _Bool 
+                               merge);
+extern void cursor_start(Cursor *c, Tree t);
+extern void cursor_next(Cursor *c);
+extern void cursor_skip(Cursor *c);
 extern Tree create(void);
 extern void tree_delete(Tree t);
+extern void tree_delete_children(Tree t);
+extern void tree_delete_before(Tree t);
 extern Tree get_root(Tree t);
 extern conststring get_attrib(const Node *e, const conststring attname);
 extern void set_attrib(Node *e, string name, conststring value);
@@ -22,6 +52,9 @@ extern Tree get_elt_by_id(Node *n, const conststring id);
 extern Tree wrap_contents(Node *n, const string elem, pairlist attr);
 extern Tree wrap_elt(Node *n, const conststring elem, pairlist attr);
 extern void rename_elt(Node *n, const string elem);
+extern unsigned int elt_flags(Node *n);
+extern _Bool 
+           elt_has_parent(Node *c, Node *p);
 extern _Bool 
            is_known(const string e);
 extern _Bool 
@@ -53,3 +86,6 @@ extern Tree append_procins(Tree t, string procins);
 extern Tree tree_append_text(Tree t, string text);
 extern Tree append_text(Tree t, string text);
 extern void dumptree(Tree t, FILE *f);
+struct _Store *tree_to_store(Tree t);
+extern _Bool 
+           write_snapshot(Tree t, FILE *f);
@@ -86,7 +86,7 @@ EXPORT void pairlist_set(pairlist *p, const conststring name,
 
   for (h = *p; h && strcasecmp(h->name, name) != 0; h = h->next);
   if (h) {
-    free(h->value);
+    dispose(h->value);
     h->value = newstring(val);
   } else {
     new(h);
@@ -107,19 +107,19 @@ EXPORT bool pairlist_unset(pairlist *p, const conststring name)
   if (strcasecmp((*p)->name, name) == 0) {
     /* Remove first pair in list */
     h = *p;
-    free(h->name);
-    free(h->value);
+    dispose(h->name);
+    dispose(h->value);
     *p = h->next;
-    free(h);
+    dispose(h);
     return true;
   }
   for (h = *p; h->next && strcasecmp(h->next->name, name) != 0; h = h->next);
   if (! h->next) return false;	/* Not found */
-  free(h->next->name);
-  free(h->next->value);
+  dispose(h->next->name);
+  dispose(h->next->value);
   h1 = h->next;
   h->next = h->next->next;
-  free(h1);
+  dispose(h1);
   return true;
 }
 